@@ -19,6 +19,9 @@
 #include "../gui.hpp"
 #ifndef DISABLE
 #include "allegro5.hpp"
+#ifdef USE_DRAWVERT_COMPACT
+#error "This backend doesn't support USE_DRAWVERT_COMPACT"
+#endif
 #include <cstring>  // memcpy
 #include <stdint.h> // uint64_t
 
@@ -11,6 +11,9 @@
 #include "../gui.hpp"
 #ifndef DISABLE
 #include "dx10.hpp"
+#ifdef USE_DRAWVERT_COMPACT
+#error "This backend doesn't support USE_DRAWVERT_COMPACT"
+#endif
 
 // DirectX
 #include <d3d10.h>
@@ -29,6 +29,9 @@
 #include "../gui.hpp"
 #ifndef DISABLE
 #include "dx12.hpp"
+#ifdef USE_DRAWVERT_COMPACT
+#error "This backend doesn't support USE_DRAWVERT_COMPACT"
+#endif
 
 // DirectX
 #include <d3d12.h>
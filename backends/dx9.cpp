@@ -11,6 +11,9 @@
 #include "../gui.hpp"
 #ifndef DISABLE
 #include "dx9.hpp"
+#ifdef USE_DRAWVERT_COMPACT
+#error "This backend doesn't support USE_DRAWVERT_COMPACT"
+#endif
 
 // DirectX
 #include <d3d9.h>
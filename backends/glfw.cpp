@@ -64,6 +64,8 @@
   (GLFW_VERSION_COMBINED >= 3300) // 3.3+ glfwSetWindowOpacity
 #define GLFW_HAS_PER_MONITOR_DPI                                               \
   (GLFW_VERSION_COMBINED >= 3300) // 3.3+ glfwGetMonitorContentScale
+#define GLFW_HAS_WAIT_EVENTS_TIMEOUT                                           \
+  (GLFW_VERSION_COMBINED >= 3200) // 3.2+ glfwWaitEventsTimeout
 #if defined(__EMSCRIPTEN__) ||                                                 \
     defined(__SWITCH__) // no Vulkan support in GLFW for Emscripten or homebrew
                         // Nintendo Switch
@@ -1137,6 +1139,31 @@ void Glfw_NewFrame() {
   Glfw_UpdateGamepads();
 }
 
+void Glfw_WaitForEvents() {
+#ifndef __EMSCRIPTEN__
+  Glfw_Data *bd = Glfw_GetBackendData();
+  IO &io = Gui::GetIO();
+  double timeout = Gui::GetNextRedrawDeadline() - Gui::GetTime();
+  if (bd->Time > 0.0)
+    timeout -= glfwGetTime() - bd->Time; // Time spent since NewFrame()
+
+  // Gamepads are polled by Glfw_UpdateGamepads(), they don't wake us up
+  if ((io.BackendFlags & BackendFlags_HasGamepad) && timeout > 1.0 / 30.0)
+    timeout = 1.0 / 30.0;
+  if (timeout <= 0.0)
+    return;
+#if GLFW_HAS_WAIT_EVENTS_TIMEOUT
+  if (timeout < 1000000.0)
+    glfwWaitEventsTimeout(timeout);
+  else
+    glfwWaitEvents();
+#else
+  if (timeout >= 1000000.0)
+    glfwWaitEvents();
+#endif
+#endif
+}
+
 #ifdef __EMSCRIPTEN__
 static EM_BOOL Glfw_OnCanvasSizeChange(int event_type,
                                        const EmscriptenUiEvent *event,
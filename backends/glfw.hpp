@@ -34,6 +34,11 @@ API bool Glfw_InitForOther(GLFWwindow *window, bool install_callbacks);
 API void Glfw_Shutdown();
 API void Glfw_NewFrame();
 
+// Block until new events arrive or Gui::GetNextRedrawDeadline() is reached,
+// instead of rendering at full rate when nothing changes. Call it in your main
+// loop before glfwPollEvents(). Returns immediately when a frame is due.
+API void Glfw_WaitForEvents();
+
 // Emscripten related initialization phase methods
 #ifdef __EMSCRIPTEN__
 API void
@@ -11,6 +11,9 @@
 #include "../gui.hpp"
 #ifndef DISABLE
 #include "metal.hpp"
+#ifdef USE_DRAWVERT_COMPACT
+#error "This backend doesn't support USE_DRAWVERT_COMPACT"
+#endif
 #import <Metal/Metal.h>
 #import <time.h>
 
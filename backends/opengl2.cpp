@@ -11,6 +11,9 @@
 #include "../gui.hpp"
 #ifndef DISABLE
 #include "opengl2.hpp"
+#ifdef USE_DRAWVERT_COMPACT
+#error "This backend doesn't support USE_DRAWVERT_COMPACT"
+#endif
 #include <stdint.h> // intptr_t
 
 // Clang/GCC warnings with -Weverything
@@ -11,6 +11,10 @@
 //  meshes support (64k+ vertices) with 16-bit indices (Desktop OpenGL only).
 //  [X] Renderer: Multi-viewport support (multiple windows). Enable with
 //  'io.ConfigFlags |= ConfigFlags_ViewportsEnable'.
+//  [X] Renderer: Compact vertex format (USE_DRAWVERT_COMPACT in config.hpp).
+//  [X] Renderer: Signed distance shapes (USE_DRAWVERT_SDF in config.hpp).
+//  [X] Renderer: Optional render state cache, to skip the backup/restore of
+//  GL state (see OpenGL3_SetRenderStateCache()).
 
 // About WebGL/ES:
 // - You need to '#define OPENGL_ES2' or '#define OPENGL_ES3' to use
@@ -129,6 +133,11 @@
 #define OPENGL_MAY_HAVE_VTX_OFFSET
 #endif
 
+// Compact vertex positions are signed shorts (missing from our loader)
+#if defined(USE_DRAWVERT_COMPACT) && !defined(GL_SHORT)
+#define GL_SHORT 0x1402
+#endif
+
 // Desktop GL 3.3+ and GL ES 3.0+ have glBindSampler()
 #if !defined(OPENGL_ES2) && (defined(OPENGL_ES3) || defined(GL_VERSION_3_3))
 #define OPENGL_MAY_HAVE_BIND_SAMPLER
@@ -159,6 +168,23 @@
 #define GL_CALL(_CALL) _CALL // Call without error check
 #endif
 
+// State set by OpenGL3_SetupRenderState() in a GL context, when using the
+// render state cache. One for the main viewport, one per secondary viewport.
+struct OpenGL3_RenderState {
+  bool Valid; // Our render state is set, nobody modified it since
+  bool ClipOriginLowerLeft;
+  GLuint VertexArrayObject; // Persistent VAO, created in this GL context
+};
+
+// Render state of a secondary viewport, in its own GL context. Its VAO is not
+// deleted in OpenGL3_DestroyWindow(), where another GL context may be current:
+// it is freed with the GL context of the platform window.
+struct OpenGL3_ViewportData {
+  OpenGL3_RenderState RenderState;
+
+  OpenGL3_ViewportData() { memset((void *)this, 0, sizeof(*this)); }
+};
+
 // OpenGL Data
 struct OpenGL3_Data {
   GLuint GlVersion;           // Extracted at runtime using GL_MAJOR_VERSION,
@@ -176,11 +202,15 @@ struct OpenGL3_Data {
   GLuint AttribLocationVtxPos; // Vertex attributes location
   GLuint AttribLocationVtxUV;
   GLuint AttribLocationVtxColor;
+  GLuint AttribLocationVtxSdf; // When USE_DRAWVERT_SDF is defined
   unsigned int VboHandle, ElementsHandle;
   GLsizeiptr VertexBufferSize;
   GLsizeiptr IndexBufferSize;
   bool HasClipOrigin;
   bool UseBufferSubData;
+  float ProjMtx[4][4]; // Projection set by OpenGL3_SetupRenderState()
+  bool UseRenderStateCache;            // OpenGL3_SetRenderStateCache()
+  OpenGL3_RenderState MainRenderState; // Main viewport
 
   OpenGL3_Data() { memset((void *)this, 0, sizeof(*this)); }
 };
@@ -198,6 +228,7 @@ static OpenGL3_Data *OpenGL3_GetBackendData() {
 // Forward Declarations
 static void OpenGL3_InitPlatformInterface();
 static void OpenGL3_ShutdownPlatformInterface();
+static OpenGL3_RenderState *OpenGL3_GetRenderState(DrawData *draw_data);
 
 // OpenGL vertex attribute state (for ES 1.0 and ES 2.0 only)
 #ifndef OPENGL_USE_VERTEX_ARRAY
@@ -304,6 +335,10 @@ bool OpenGL3_Init(const char *glsl_version) {
   io.BackendFlags |=
       BackendFlags_RendererHasViewports; // We can create multi-viewports
                                          // on the Renderer side (optional)
+#ifdef USE_DRAWVERT_SDF
+  io.BackendFlags |=
+      BackendFlags_RendererHasSdfShapes; // Our shaders evaluate DrawVert::sdf
+#endif
 
   // Store GLSL version string so we can refer to it later in case we recreate
   // shaders. Note: GLSL version is NOT the same as GL version. Leave this to
@@ -358,7 +393,8 @@ void OpenGL3_Shutdown() {
   io.BackendRendererName = nullptr;
   io.BackendRendererUserData = nullptr;
   io.BackendFlags &=
-      ~(BackendFlags_RendererHasVtxOffset | BackendFlags_RendererHasViewports);
+      ~(BackendFlags_RendererHasVtxOffset | BackendFlags_RendererHasViewports |
+        BackendFlags_RendererHasSdfShapes);
   DELETE(bd);
 }
 
@@ -370,38 +406,49 @@ void OpenGL3_NewFrame() {
     OpenGL3_CreateDeviceObjects();
 }
 
+// 'rs' is non-null when using the render state cache: the state it holds is
+// only set up when invalid. The viewport, projection and vertex array are
+// always set, as several viewports may share a GL context.
 static void OpenGL3_SetupRenderState(DrawData *draw_data, int fb_width,
-                                     int fb_height,
-                                     GLuint vertex_array_object) {
+                                     int fb_height, GLuint vertex_array_object,
+                                     OpenGL3_RenderState *rs) {
   OpenGL3_Data *bd = OpenGL3_GetBackendData();
+  const bool setup_all = (rs == nullptr || !rs->Valid);
 
   // Setup render state: alpha-blending enabled, no face culling, no depth
   // testing, scissor enabled, polygon fill
-  glEnable(GL_BLEND);
-  glBlendEquation(GL_FUNC_ADD);
-  glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
-                      GL_ONE_MINUS_SRC_ALPHA);
-  glDisable(GL_CULL_FACE);
-  glDisable(GL_DEPTH_TEST);
-  glDisable(GL_STENCIL_TEST);
-  glEnable(GL_SCISSOR_TEST);
+  if (setup_all) {
+    glEnable(GL_BLEND);
+    glBlendEquation(GL_FUNC_ADD);
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                        GL_ONE_MINUS_SRC_ALPHA);
+    glDisable(GL_CULL_FACE);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_STENCIL_TEST);
+    glEnable(GL_SCISSOR_TEST);
 #ifdef OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-  if (bd->GlVersion >= 310)
-    glDisable(GL_PRIMITIVE_RESTART);
+    if (bd->GlVersion >= 310)
+      glDisable(GL_PRIMITIVE_RESTART);
 #endif
 #ifdef HAS_POLYGON_MODE
-  glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 #endif
+  }
 
   // Support for GL 4.5 rarely used glClipControl(GL_UPPER_LEFT)
+  // (queried once per GL context with the render state cache)
 #if defined(GL_CLIP_ORIGIN)
   bool clip_origin_lower_left = true;
-  if (bd->HasClipOrigin) {
+  if (!setup_all) {
+    clip_origin_lower_left = rs->ClipOriginLowerLeft;
+  } else if (bd->HasClipOrigin) {
     GLenum current_clip_origin = 0;
     glGetIntegerv(GL_CLIP_ORIGIN, (GLint *)&current_clip_origin);
     if (current_clip_origin == GL_UPPER_LEFT)
       clip_origin_lower_left = false;
   }
+  if (rs != nullptr)
+    rs->ClipOriginLowerLeft = clip_origin_lower_left;
 #endif
 
   // Setup viewport, orthographic projection matrix
@@ -426,13 +473,16 @@ static void OpenGL3_SetupRenderState(DrawData *draw_data, int fb_width,
       {0.0f, 0.0f, -1.0f, 0.0f},
       {(R + L) / (L - R), (T + B) / (B - T), 0.0f, 1.0f},
   };
-  glUseProgram(bd->ShaderHandle);
-  glUniform1i(bd->AttribLocationTex, 0);
+  memcpy(bd->ProjMtx, ortho_projection, sizeof(ortho_projection));
+  if (setup_all) {
+    glUseProgram(bd->ShaderHandle);
+    glUniform1i(bd->AttribLocationTex, 0);
+  }
   glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE,
                      &ortho_projection[0][0]);
 
 #ifdef OPENGL_MAY_HAVE_BIND_SAMPLER
-  if (bd->GlVersion >= 330 || bd->GlProfileIsES3)
+  if (setup_all && (bd->GlVersion >= 330 || bd->GlProfileIsES3))
     glBindSampler(0, 0); // We use combined texture/sampler state. Applications
                          // using GL 3.3 and GL ES 3.0 may set that otherwise.
 #endif
@@ -441,6 +491,8 @@ static void OpenGL3_SetupRenderState(DrawData *draw_data, int fb_width,
 #ifdef OPENGL_USE_VERTEX_ARRAY
   glBindVertexArray(vertex_array_object);
 #endif
+  if (!setup_all)
+    return;
 
   // Bind vertex/index buffers and setup attributes for DrawVert
   GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle));
@@ -448,21 +500,217 @@ static void OpenGL3_SetupRenderState(DrawData *draw_data, int fb_width,
   GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxPos));
   GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxUV));
   GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxColor));
+#ifdef USE_DRAWVERT_COMPACT
+  GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxPos, 2, GL_SHORT, GL_FALSE,
+                                sizeof(DrawVert),
+                                (GLvoid *)offsetof(DrawVert, pos)));
+  GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxUV, 2, GL_UNSIGNED_SHORT,
+                                GL_TRUE, sizeof(DrawVert),
+                                (GLvoid *)offsetof(DrawVert, uv)));
+#else
   GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxPos, 2, GL_FLOAT, GL_FALSE,
                                 sizeof(DrawVert),
                                 (GLvoid *)offsetof(DrawVert, pos)));
   GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxUV, 2, GL_FLOAT, GL_FALSE,
                                 sizeof(DrawVert),
                                 (GLvoid *)offsetof(DrawVert, uv)));
+#endif
   GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE,
                                 GL_TRUE, sizeof(DrawVert),
                                 (GLvoid *)offsetof(DrawVert, col)));
+#ifdef USE_DRAWVERT_SDF
+  GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxSdf));
+  GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxSdf, 4, GL_UNSIGNED_SHORT,
+                                GL_TRUE, sizeof(DrawVert),
+                                (GLvoid *)offsetof(DrawVert, sdf)));
+#endif
+  if (rs != nullptr)
+    rs->Valid = true;
 }
 
+#ifdef USE_DRAWVERT_COMPACT
+// Compact vertex positions are fixed point and relative to
+// DrawList::VtxOrigin: fold their decoding into the projection matrix, so the
+// shaders are the same for both vertex formats.
+static void OpenGL3_SetupVtxOrigin(const DrawList *cmd_list) {
+  OpenGL3_Data *bd = OpenGL3_GetBackendData();
+  const float(*m)[4] = bd->ProjMtx;
+  const float s = 1.0f / DRAWVERT_POS_SCALE;
+  const Vec2 o = cmd_list->VtxOrigin;
+  const float mtx[4][4] = {
+      {m[0][0] * s, m[0][1] * s, 0.0f, 0.0f},
+      {m[1][0] * s, m[1][1] * s, 0.0f, 0.0f},
+      {0.0f, 0.0f, -1.0f, 0.0f},
+      {m[3][0] + m[0][0] * o.x + m[1][0] * o.y,
+       m[3][1] + m[0][1] * o.x + m[1][1] * o.y, 0.0f, 1.0f},
+  };
+  glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &mtx[0][0]);
+}
+#endif
+
+// GL state modified by OpenGL3_RenderDrawData(), backed up before rendering
+// and restored after, unless using the render state cache.
+struct OpenGL3_StateBackup {
+  GLenum ActiveTexture;
+  GLuint Program;
+  GLuint Texture;
+#ifdef OPENGL_MAY_HAVE_BIND_SAMPLER
+  GLuint Sampler;
+#endif
+  GLuint ArrayBuffer;
+#ifndef OPENGL_USE_VERTEX_ARRAY
+  // This is part of VAO on OpenGL 3.0+ and OpenGL ES 3.0+.
+  GLint ElementArrayBuffer;
+  OpenGL3_VtxAttribState VtxAttribPos;
+  OpenGL3_VtxAttribState VtxAttribUV;
+  OpenGL3_VtxAttribState VtxAttribColor;
+#ifdef USE_DRAWVERT_SDF
+  OpenGL3_VtxAttribState VtxAttribSdf;
+#endif
+#endif
+#ifdef OPENGL_USE_VERTEX_ARRAY
+  GLuint VertexArrayObject;
+#endif
+#ifdef HAS_POLYGON_MODE
+  GLint PolygonMode[2];
+#endif
+  GLint Viewport[4];
+  GLint ScissorBox[4];
+  GLenum BlendSrcRgb, BlendDstRgb, BlendSrcAlpha, BlendDstAlpha;
+  GLenum BlendEquationRgb, BlendEquationAlpha;
+  GLboolean EnableBlend, EnableCullFace, EnableDepthTest, EnableStencilTest;
+  GLboolean EnableScissorTest;
+#ifdef OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+  GLboolean EnablePrimitiveRestart;
+#endif
+
+  // Also sets GL_TEXTURE0 as the active texture unit
+  void Backup(OpenGL3_Data *bd) {
+    glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint *)&ActiveTexture);
+    glActiveTexture(GL_TEXTURE0);
+    glGetIntegerv(GL_CURRENT_PROGRAM, (GLint *)&Program);
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint *)&Texture);
+#ifdef OPENGL_MAY_HAVE_BIND_SAMPLER
+    if (bd->GlVersion >= 330 || bd->GlProfileIsES3)
+      glGetIntegerv(GL_SAMPLER_BINDING, (GLint *)&Sampler);
+    else
+      Sampler = 0;
+#endif
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint *)&ArrayBuffer);
+#ifndef OPENGL_USE_VERTEX_ARRAY
+    glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &ElementArrayBuffer);
+    VtxAttribPos.GetState(bd->AttribLocationVtxPos);
+    VtxAttribUV.GetState(bd->AttribLocationVtxUV);
+    VtxAttribColor.GetState(bd->AttribLocationVtxColor);
+#ifdef USE_DRAWVERT_SDF
+    VtxAttribSdf.GetState(bd->AttribLocationVtxSdf);
+#endif
+#endif
+#ifdef OPENGL_USE_VERTEX_ARRAY
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint *)&VertexArrayObject);
+#endif
+#ifdef HAS_POLYGON_MODE
+    glGetIntegerv(GL_POLYGON_MODE, PolygonMode);
+#endif
+    glGetIntegerv(GL_VIEWPORT, Viewport);
+    glGetIntegerv(GL_SCISSOR_BOX, ScissorBox);
+    glGetIntegerv(GL_BLEND_SRC_RGB, (GLint *)&BlendSrcRgb);
+    glGetIntegerv(GL_BLEND_DST_RGB, (GLint *)&BlendDstRgb);
+    glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint *)&BlendSrcAlpha);
+    glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint *)&BlendDstAlpha);
+    glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint *)&BlendEquationRgb);
+    glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint *)&BlendEquationAlpha);
+    EnableBlend = glIsEnabled(GL_BLEND);
+    EnableCullFace = glIsEnabled(GL_CULL_FACE);
+    EnableDepthTest = glIsEnabled(GL_DEPTH_TEST);
+    EnableStencilTest = glIsEnabled(GL_STENCIL_TEST);
+    EnableScissorTest = glIsEnabled(GL_SCISSOR_TEST);
+#ifdef OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+    EnablePrimitiveRestart =
+        (bd->GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
+#endif
+  }
+
+  void Restore(OpenGL3_Data *bd) {
+    // This "glIsProgram()" check is required because if the program is
+    // "pending deletion" at the time of binding backup, it will have been
+    // deleted by now and will cause an OpenGL error. See #6220.
+    if (Program == 0 || glIsProgram(Program))
+      glUseProgram(Program);
+    glBindTexture(GL_TEXTURE_2D, Texture);
+#ifdef OPENGL_MAY_HAVE_BIND_SAMPLER
+    if (bd->GlVersion >= 330 || bd->GlProfileIsES3)
+      glBindSampler(0, Sampler);
+#endif
+    glActiveTexture(ActiveTexture);
+#ifdef OPENGL_USE_VERTEX_ARRAY
+    glBindVertexArray(VertexArrayObject);
+#endif
+    glBindBuffer(GL_ARRAY_BUFFER, ArrayBuffer);
+#ifndef OPENGL_USE_VERTEX_ARRAY
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ElementArrayBuffer);
+    VtxAttribPos.SetState(bd->AttribLocationVtxPos);
+    VtxAttribUV.SetState(bd->AttribLocationVtxUV);
+    VtxAttribColor.SetState(bd->AttribLocationVtxColor);
+#ifdef USE_DRAWVERT_SDF
+    VtxAttribSdf.SetState(bd->AttribLocationVtxSdf);
+#endif
+#endif
+    glBlendEquationSeparate(BlendEquationRgb, BlendEquationAlpha);
+    glBlendFuncSeparate(BlendSrcRgb, BlendDstRgb, BlendSrcAlpha,
+                        BlendDstAlpha);
+    if (EnableBlend)
+      glEnable(GL_BLEND);
+    else
+      glDisable(GL_BLEND);
+    if (EnableCullFace)
+      glEnable(GL_CULL_FACE);
+    else
+      glDisable(GL_CULL_FACE);
+    if (EnableDepthTest)
+      glEnable(GL_DEPTH_TEST);
+    else
+      glDisable(GL_DEPTH_TEST);
+    if (EnableStencilTest)
+      glEnable(GL_STENCIL_TEST);
+    else
+      glDisable(GL_STENCIL_TEST);
+    if (EnableScissorTest)
+      glEnable(GL_SCISSOR_TEST);
+    else
+      glDisable(GL_SCISSOR_TEST);
+#ifdef OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+    if (bd->GlVersion >= 310) {
+      if (EnablePrimitiveRestart)
+        glEnable(GL_PRIMITIVE_RESTART);
+      else
+        glDisable(GL_PRIMITIVE_RESTART);
+    }
+#endif
+
+#ifdef HAS_POLYGON_MODE
+    // Desktop OpenGL 3.0 and OpenGL 3.1 had separate polygon draw modes for
+    // front-facing and back-facing faces of polygons
+    if (bd->GlVersion <= 310 || bd->GlProfileIsCompat) {
+      glPolygonMode(GL_FRONT, (GLenum)PolygonMode[0]);
+      glPolygonMode(GL_BACK, (GLenum)PolygonMode[1]);
+    } else {
+      glPolygonMode(GL_FRONT_AND_BACK, (GLenum)PolygonMode[0]);
+    }
+#endif // HAS_POLYGON_MODE
+
+    glViewport(Viewport[0], Viewport[1], (GLsizei)Viewport[2],
+               (GLsizei)Viewport[3]);
+    glScissor(ScissorBox[0], ScissorBox[1], (GLsizei)ScissorBox[2],
+              (GLsizei)ScissorBox[3]);
+  }
+};
+
 // OpenGL3 Render function.
 // Note that this implementation is little overcomplicated because we are
 // saving/setting up/restoring every OpenGL state explicitly. This is in order
-// to be able to run within an OpenGL engine that doesn't do so.
+// to be able to run within an OpenGL engine that doesn't do so (unless using
+// the render state cache, see OpenGL3_SetRenderStateCache()).
 void OpenGL3_RenderDrawData(DrawData *draw_data) {
   // Avoid rendering when minimized, scale coordinates for retina displays
   // (screen coordinates != framebuffer coordinates)
@@ -476,78 +724,34 @@ void OpenGL3_RenderDrawData(DrawData *draw_data) {
   OpenGL3_Data *bd = OpenGL3_GetBackendData();
 
   // Backup GL state
-  GLenum last_active_texture;
-  glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint *)&last_active_texture);
-  glActiveTexture(GL_TEXTURE0);
-  GLuint last_program;
-  glGetIntegerv(GL_CURRENT_PROGRAM, (GLint *)&last_program);
-  GLuint last_texture;
-  glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint *)&last_texture);
-#ifdef OPENGL_MAY_HAVE_BIND_SAMPLER
-  GLuint last_sampler;
-  if (bd->GlVersion >= 330 || bd->GlProfileIsES3) {
-    glGetIntegerv(GL_SAMPLER_BINDING, (GLint *)&last_sampler);
-  } else {
-    last_sampler = 0;
-  }
-#endif
-  GLuint last_array_buffer;
-  glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint *)&last_array_buffer);
-#ifndef OPENGL_USE_VERTEX_ARRAY
-  // This is part of VAO on OpenGL 3.0+ and OpenGL ES 3.0+.
-  GLint last_element_array_buffer;
-  glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &last_element_array_buffer);
-  OpenGL3_VtxAttribState last_vtx_attrib_state_pos;
-  last_vtx_attrib_state_pos.GetState(bd->AttribLocationVtxPos);
-  OpenGL3_VtxAttribState last_vtx_attrib_state_uv;
-  last_vtx_attrib_state_uv.GetState(bd->AttribLocationVtxUV);
-  OpenGL3_VtxAttribState last_vtx_attrib_state_color;
-  last_vtx_attrib_state_color.GetState(bd->AttribLocationVtxColor);
-#endif
-#ifdef OPENGL_USE_VERTEX_ARRAY
-  GLuint last_vertex_array_object;
-  glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint *)&last_vertex_array_object);
-#endif
-#ifdef HAS_POLYGON_MODE
-  GLint last_polygon_mode[2];
-  glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode);
-#endif
-  GLint last_viewport[4];
-  glGetIntegerv(GL_VIEWPORT, last_viewport);
-  GLint last_scissor_box[4];
-  glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box);
-  GLenum last_blend_src_rgb;
-  glGetIntegerv(GL_BLEND_SRC_RGB, (GLint *)&last_blend_src_rgb);
-  GLenum last_blend_dst_rgb;
-  glGetIntegerv(GL_BLEND_DST_RGB, (GLint *)&last_blend_dst_rgb);
-  GLenum last_blend_src_alpha;
-  glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint *)&last_blend_src_alpha);
-  GLenum last_blend_dst_alpha;
-  glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint *)&last_blend_dst_alpha);
-  GLenum last_blend_equation_rgb;
-  glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint *)&last_blend_equation_rgb);
-  GLenum last_blend_equation_alpha;
-  glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint *)&last_blend_equation_alpha);
-  GLboolean last_enable_blend = glIsEnabled(GL_BLEND);
-  GLboolean last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
-  GLboolean last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
-  GLboolean last_enable_stencil_test = glIsEnabled(GL_STENCIL_TEST);
-  GLboolean last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
-#ifdef OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-  GLboolean last_enable_primitive_restart =
-      (bd->GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
-#endif
+  OpenGL3_RenderState *rs =
+      bd->UseRenderStateCache ? OpenGL3_GetRenderState(draw_data) : nullptr;
+  OpenGL3_StateBackup backup;
+  if (rs == nullptr)
+    backup.Backup(bd);
+  else if (!rs->Valid)
+    glActiveTexture(GL_TEXTURE0);
 
   // Setup desired GL state
   // Recreate the VAO every time (this is to easily allow multiple GL contexts
   // to be rendered to. VAO are not shared among GL contexts) The renderer would
   // actually work without any VAO bound, but then our VertexAttrib calls would
-  // overwrite the default one currently bound.
+  // overwrite the default one currently bound. With the render state cache,
+  // each viewport keeps its own VAO instead.
   GLuint vertex_array_object = 0;
 #ifdef OPENGL_USE_VERTEX_ARRAY
-  GL_CALL(glGenVertexArrays(1, &vertex_array_object));
+  if (rs == nullptr) {
+    GL_CALL(glGenVertexArrays(1, &vertex_array_object));
+  } else {
+    if (rs->VertexArrayObject == 0) {
+      GL_CALL(glGenVertexArrays(1, &rs->VertexArrayObject));
+      rs->Valid = false;
+    }
+    vertex_array_object = rs->VertexArrayObject;
+  }
 #endif
-  OpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+  OpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object,
+                           rs);
 
   // Will project scissor/clipping rectangles into framebuffer space
   Vec2 clip_off = draw_data->DisplayPos; // (0,0) unless using multi-viewports
@@ -555,9 +759,18 @@ void OpenGL3_RenderDrawData(DrawData *draw_data) {
       draw_data->FramebufferScale; // (1,1) unless using retina display which
                                    // are often (2,2)
 
+  // Skip redundant texture binds and scissor changes between commands. This
+  // is reset after user callbacks, which may change them.
+  bool last_state_known = false;
+  GLuint last_texture = 0;
+  GLint last_scissor[4] = {0, 0, 0, 0};
+
   // Render command lists
   for (int n = 0; n < draw_data->CmdListsCount; n++) {
     const DrawList *cmd_list = draw_data->CmdLists[n];
+#ifdef USE_DRAWVERT_COMPACT
+    OpenGL3_SetupVtxOrigin(cmd_list);
+#endif
 
     // Upload vertex/index buffers
     // - OpenGL drivers are in a very sorry state nowadays....
@@ -605,11 +818,20 @@ void OpenGL3_RenderDrawData(DrawData *draw_data) {
         // User callback, registered via DrawList::AddCallback()
         // (DrawCallback_ResetRenderState is a special callback value used by
         // the user to request the renderer to reset render state.)
-        if (pcmd->UserCallback == DrawCallback_ResetRenderState)
+        if (pcmd->UserCallback == DrawCallback_ResetRenderState) {
+          if (rs != nullptr)
+            rs->Valid = false;
           OpenGL3_SetupRenderState(draw_data, fb_width, fb_height,
-                                   vertex_array_object);
-        else
+                                   vertex_array_object, rs);
+#ifdef USE_DRAWVERT_COMPACT
+          OpenGL3_SetupVtxOrigin(cmd_list);
+#endif
+        } else {
           pcmd->UserCallback(cmd_list, pcmd);
+          if (rs != nullptr)
+            rs->Valid = false;
+        }
+        last_state_known = false;
       } else {
         // Project scissor/clipping rectangles into framebuffer space
         Vec2 clip_min((pcmd->ClipRect.x - clip_off.x) * clip_scale.x,
@@ -620,13 +842,25 @@ void OpenGL3_RenderDrawData(DrawData *draw_data) {
           continue;
 
         // Apply scissor/clipping rectangle (Y is inverted in OpenGL)
-        GL_CALL(glScissor((int)clip_min.x, (int)((float)fb_height - clip_max.y),
-                          (int)(clip_max.x - clip_min.x),
-                          (int)(clip_max.y - clip_min.y)));
+        const GLint scissor[4] = {(GLint)clip_min.x,
+                                  (GLint)((float)fb_height - clip_max.y),
+                                  (GLint)(clip_max.x - clip_min.x),
+                                  (GLint)(clip_max.y - clip_min.y)};
+        if (!last_state_known || scissor[0] != last_scissor[0] ||
+            scissor[1] != last_scissor[1] || scissor[2] != last_scissor[2] ||
+            scissor[3] != last_scissor[3]) {
+          GL_CALL(glScissor(scissor[0], scissor[1], scissor[2], scissor[3]));
+          for (int i = 0; i < 4; i++)
+            last_scissor[i] = scissor[i];
+        }
 
         // Bind texture, Draw
-        GL_CALL(
-            glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID()));
+        const GLuint texture = (GLuint)(intptr_t)pcmd->GetTexID();
+        if (!last_state_known || texture != last_texture) {
+          GL_CALL(glBindTexture(GL_TEXTURE_2D, texture));
+          last_texture = texture;
+        }
+        last_state_known = true;
 #ifdef OPENGL_MAY_HAVE_VTX_OFFSET
         if (bd->GlVersion >= 320)
           GL_CALL(glDrawElementsBaseVertex(
@@ -644,80 +878,13 @@ void OpenGL3_RenderDrawData(DrawData *draw_data) {
     }
   }
 
-  // Destroy the temporary VAO
-#ifdef OPENGL_USE_VERTEX_ARRAY
-  GL_CALL(glDeleteVertexArrays(1, &vertex_array_object));
-#endif
-
-  // Restore modified GL state
-  // This "glIsProgram()" check is required because if the program is "pending
-  // deletion" at the time of binding backup, it will have been deleted by now
-  // and will cause an OpenGL error. See #6220.
-  if (last_program == 0 || glIsProgram(last_program))
-    glUseProgram(last_program);
-  glBindTexture(GL_TEXTURE_2D, last_texture);
-#ifdef OPENGL_MAY_HAVE_BIND_SAMPLER
-  if (bd->GlVersion >= 330 || bd->GlProfileIsES3)
-    glBindSampler(0, last_sampler);
-#endif
-  glActiveTexture(last_active_texture);
+  // Destroy the temporary VAO, restore modified GL state
+  if (rs == nullptr) {
 #ifdef OPENGL_USE_VERTEX_ARRAY
-  glBindVertexArray(last_vertex_array_object);
+    GL_CALL(glDeleteVertexArrays(1, &vertex_array_object));
 #endif
-  glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
-#ifndef OPENGL_USE_VERTEX_ARRAY
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, last_element_array_buffer);
-  last_vtx_attrib_state_pos.SetState(bd->AttribLocationVtxPos);
-  last_vtx_attrib_state_uv.SetState(bd->AttribLocationVtxUV);
-  last_vtx_attrib_state_color.SetState(bd->AttribLocationVtxColor);
-#endif
-  glBlendEquationSeparate(last_blend_equation_rgb, last_blend_equation_alpha);
-  glBlendFuncSeparate(last_blend_src_rgb, last_blend_dst_rgb,
-                      last_blend_src_alpha, last_blend_dst_alpha);
-  if (last_enable_blend)
-    glEnable(GL_BLEND);
-  else
-    glDisable(GL_BLEND);
-  if (last_enable_cull_face)
-    glEnable(GL_CULL_FACE);
-  else
-    glDisable(GL_CULL_FACE);
-  if (last_enable_depth_test)
-    glEnable(GL_DEPTH_TEST);
-  else
-    glDisable(GL_DEPTH_TEST);
-  if (last_enable_stencil_test)
-    glEnable(GL_STENCIL_TEST);
-  else
-    glDisable(GL_STENCIL_TEST);
-  if (last_enable_scissor_test)
-    glEnable(GL_SCISSOR_TEST);
-  else
-    glDisable(GL_SCISSOR_TEST);
-#ifdef OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-  if (bd->GlVersion >= 310) {
-    if (last_enable_primitive_restart)
-      glEnable(GL_PRIMITIVE_RESTART);
-    else
-      glDisable(GL_PRIMITIVE_RESTART);
-  }
-#endif
-
-#ifdef HAS_POLYGON_MODE
-  // Desktop OpenGL 3.0 and OpenGL 3.1 had separate polygon draw modes for
-  // front-facing and back-facing faces of polygons
-  if (bd->GlVersion <= 310 || bd->GlProfileIsCompat) {
-    glPolygonMode(GL_FRONT, (GLenum)last_polygon_mode[0]);
-    glPolygonMode(GL_BACK, (GLenum)last_polygon_mode[1]);
-  } else {
-    glPolygonMode(GL_FRONT_AND_BACK, (GLenum)last_polygon_mode[0]);
+    backup.Restore(bd);
   }
-#endif // HAS_POLYGON_MODE
-
-  glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2],
-             (GLsizei)last_viewport[3]);
-  glScissor(last_scissor_box[0], last_scissor_box[1],
-            (GLsizei)last_scissor_box[2], (GLsizei)last_scissor_box[3]);
   (void)bd; // Not all compilation paths use this
 }
 
@@ -813,6 +980,34 @@ static bool CheckProgram(GLuint handle, const char *desc) {
   return (GLboolean)status == GL_TRUE;
 }
 
+// Shader chunks for signed distance shapes (see DrawVert::sdf): the vertex
+// shader decodes the shape, the fragment shader turns the distance to its edge
+// into coverage. Regular vertices have a zero size and sample the texture.
+#ifdef USE_DRAWVERT_SDF
+#define OPENGL3_SDF_VERTEX_MAIN                                                \
+  "    vec4 sdf = floor(Sdf * 65535.0 + 0.5);\n"                               \
+  "    float corners = floor(sdf.z / 4096.0);\n"                               \
+  "    Frag_SdfShape = vec4(sdf.xyw * 0.25, 0.0);\n"                           \
+  "    Frag_SdfRadii = (sdf.z - corners * 4096.0) * 0.25 *\n"                  \
+  "        mod(floor(corners / vec4(1.0, 2.0, 4.0, 8.0)), 2.0);\n"             \
+  "    Frag_SdfPos = (UV * 2.0 - 1.0) *\n"                                     \
+  "        (Frag_SdfShape.xy + Frag_SdfShape.z * 0.5 + 1.0);\n"
+#define OPENGL3_SDF_COVERAGE_FUNC                                              \
+  "float SdfCoverage()\n"                                                      \
+  "{\n"                                                                        \
+  "    vec2 p = Frag_SdfPos;\n"                                                \
+  "    vec2 radii = (p.x > 0.0) ? Frag_SdfRadii.yw : Frag_SdfRadii.xz;\n"      \
+  "    float r = (p.y > 0.0) ? radii.y : radii.x;\n"                           \
+  "    vec2 q = abs(p) - Frag_SdfShape.xy + r;\n"                              \
+  "    float d = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - r;\n"         \
+  "    if (Frag_SdfShape.z > 0.0)\n"                                           \
+  "        d = abs(d) - Frag_SdfShape.z * 0.5;\n"                              \
+  "    return clamp(0.5 - d, 0.0, 1.0);\n"                                     \
+  "}\n"
+#else
+#define OPENGL3_SDF_VERTEX_MAIN ""
+#endif
+
 bool OpenGL3_CreateDeviceObjects() {
   OpenGL3_Data *bd = OpenGL3_GetBackendData();
 
@@ -836,10 +1031,17 @@ bool OpenGL3_CreateDeviceObjects() {
       "attribute vec4 Color;\n"
       "varying vec2 Frag_UV;\n"
       "varying vec4 Frag_Color;\n"
+#ifdef USE_DRAWVERT_SDF
+      "attribute vec4 Sdf;\n"
+      "varying vec2 Frag_SdfPos;\n"
+      "varying vec4 Frag_SdfShape;\n"
+      "varying vec4 Frag_SdfRadii;\n"
+#endif
       "void main()\n"
       "{\n"
       "    Frag_UV = UV;\n"
       "    Frag_Color = Color;\n"
+      OPENGL3_SDF_VERTEX_MAIN
       "    gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
       "}\n";
 
@@ -850,10 +1052,17 @@ bool OpenGL3_CreateDeviceObjects() {
       "in vec4 Color;\n"
       "out vec2 Frag_UV;\n"
       "out vec4 Frag_Color;\n"
+#ifdef USE_DRAWVERT_SDF
+      "in vec4 Sdf;\n"
+      "out vec2 Frag_SdfPos;\n"
+      "out vec4 Frag_SdfShape;\n"
+      "out vec4 Frag_SdfRadii;\n"
+#endif
       "void main()\n"
       "{\n"
       "    Frag_UV = UV;\n"
       "    Frag_Color = Color;\n"
+      OPENGL3_SDF_VERTEX_MAIN
       "    gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
       "}\n";
 
@@ -865,10 +1074,17 @@ bool OpenGL3_CreateDeviceObjects() {
       "uniform mat4 ProjMtx;\n"
       "out vec2 Frag_UV;\n"
       "out vec4 Frag_Color;\n"
+#ifdef USE_DRAWVERT_SDF
+      "layout (location = 3) in vec4 Sdf;\n"
+      "out vec2 Frag_SdfPos;\n"
+      "out vec4 Frag_SdfShape;\n"
+      "out vec4 Frag_SdfRadii;\n"
+#endif
       "void main()\n"
       "{\n"
       "    Frag_UV = UV;\n"
       "    Frag_Color = Color;\n"
+      OPENGL3_SDF_VERTEX_MAIN
       "    gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
       "}\n";
 
@@ -879,22 +1095,48 @@ bool OpenGL3_CreateDeviceObjects() {
       "uniform mat4 ProjMtx;\n"
       "out vec2 Frag_UV;\n"
       "out vec4 Frag_Color;\n"
+#ifdef USE_DRAWVERT_SDF
+      "layout (location = 3) in vec4 Sdf;\n"
+      "out vec2 Frag_SdfPos;\n"
+      "out vec4 Frag_SdfShape;\n"
+      "out vec4 Frag_SdfRadii;\n"
+#endif
       "void main()\n"
       "{\n"
       "    Frag_UV = UV;\n"
       "    Frag_Color = Color;\n"
+      OPENGL3_SDF_VERTEX_MAIN
       "    gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
       "}\n";
 
   const GLchar *fragment_shader_glsl_120 =
       "#ifdef GL_ES\n"
+#ifdef USE_DRAWVERT_SDF
+      "#ifdef GL_FRAGMENT_PRECISION_HIGH\n"
+      "    precision highp float;\n"
+      "#else\n"
       "    precision mediump float;\n"
       "#endif\n"
+#else
+      "    precision mediump float;\n"
+#endif
+      "#endif\n"
       "uniform sampler2D Texture;\n"
       "varying vec2 Frag_UV;\n"
       "varying vec4 Frag_Color;\n"
+#ifdef USE_DRAWVERT_SDF
+      "varying vec2 Frag_SdfPos;\n"
+      "varying vec4 Frag_SdfShape;\n"
+      "varying vec4 Frag_SdfRadii;\n"
+      OPENGL3_SDF_COVERAGE_FUNC
+#endif
       "void main()\n"
       "{\n"
+#ifdef USE_DRAWVERT_SDF
+      "    if (Frag_SdfShape.x > 0.0)\n"
+      "        gl_FragColor = vec4(Frag_Color.rgb, Frag_Color.a * SdfCoverage());\n"
+      "    else\n"
+#endif
       "    gl_FragColor = Frag_Color * texture2D(Texture, Frag_UV.st);\n"
       "}\n";
 
@@ -903,19 +1145,45 @@ bool OpenGL3_CreateDeviceObjects() {
       "in vec2 Frag_UV;\n"
       "in vec4 Frag_Color;\n"
       "out vec4 Out_Color;\n"
+#ifdef USE_DRAWVERT_SDF
+      "in vec2 Frag_SdfPos;\n"
+      "in vec4 Frag_SdfShape;\n"
+      "in vec4 Frag_SdfRadii;\n"
+      OPENGL3_SDF_COVERAGE_FUNC
+#endif
       "void main()\n"
       "{\n"
+#ifdef USE_DRAWVERT_SDF
+      "    if (Frag_SdfShape.x > 0.0)\n"
+      "        Out_Color = vec4(Frag_Color.rgb, Frag_Color.a * SdfCoverage());\n"
+      "    else\n"
+#endif
       "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
       "}\n";
 
   const GLchar *fragment_shader_glsl_300_es =
+#ifdef USE_DRAWVERT_SDF
+      "precision highp float;\n"
+#else
       "precision mediump float;\n"
+#endif
       "uniform sampler2D Texture;\n"
       "in vec2 Frag_UV;\n"
       "in vec4 Frag_Color;\n"
       "layout (location = 0) out vec4 Out_Color;\n"
+#ifdef USE_DRAWVERT_SDF
+      "in vec2 Frag_SdfPos;\n"
+      "in vec4 Frag_SdfShape;\n"
+      "in vec4 Frag_SdfRadii;\n"
+      OPENGL3_SDF_COVERAGE_FUNC
+#endif
       "void main()\n"
       "{\n"
+#ifdef USE_DRAWVERT_SDF
+      "    if (Frag_SdfShape.x > 0.0)\n"
+      "        Out_Color = vec4(Frag_Color.rgb, Frag_Color.a * SdfCoverage());\n"
+      "    else\n"
+#endif
       "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
       "}\n";
 
@@ -924,8 +1192,19 @@ bool OpenGL3_CreateDeviceObjects() {
       "in vec4 Frag_Color;\n"
       "uniform sampler2D Texture;\n"
       "layout (location = 0) out vec4 Out_Color;\n"
+#ifdef USE_DRAWVERT_SDF
+      "in vec2 Frag_SdfPos;\n"
+      "in vec4 Frag_SdfShape;\n"
+      "in vec4 Frag_SdfRadii;\n"
+      OPENGL3_SDF_COVERAGE_FUNC
+#endif
       "void main()\n"
       "{\n"
+#ifdef USE_DRAWVERT_SDF
+      "    if (Frag_SdfShape.x > 0.0)\n"
+      "        Out_Color = vec4(Frag_Color.rgb, Frag_Color.a * SdfCoverage());\n"
+      "    else\n"
+#endif
       "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
       "}\n";
 
@@ -980,6 +1259,10 @@ bool OpenGL3_CreateDeviceObjects() {
   bd->AttribLocationVtxUV = (GLuint)glGetAttribLocation(bd->ShaderHandle, "UV");
   bd->AttribLocationVtxColor =
       (GLuint)glGetAttribLocation(bd->ShaderHandle, "Color");
+#ifdef USE_DRAWVERT_SDF
+  bd->AttribLocationVtxSdf =
+      (GLuint)glGetAttribLocation(bd->ShaderHandle, "Sdf");
+#endif
 
   // Create buffers
   glGenBuffers(1, &bd->VboHandle);
@@ -1011,9 +1294,35 @@ void OpenGL3_DestroyDeviceObjects() {
     glDeleteProgram(bd->ShaderHandle);
     bd->ShaderHandle = 0;
   }
+#ifdef OPENGL_USE_VERTEX_ARRAY
+  if (bd->MainRenderState.VertexArrayObject) {
+    glDeleteVertexArrays(1, &bd->MainRenderState.VertexArrayObject);
+    bd->MainRenderState.VertexArrayObject = 0;
+  }
+#endif
+  OpenGL3_InvalidateRenderState();
   OpenGL3_DestroyFontsTexture();
 }
 
+void OpenGL3_SetRenderStateCache(bool enabled) {
+  OpenGL3_Data *bd = OpenGL3_GetBackendData();
+  assert(bd != nullptr && "Did you call OpenGL3_Init()?");
+  bd->UseRenderStateCache = enabled;
+  OpenGL3_InvalidateRenderState();
+}
+
+void OpenGL3_InvalidateRenderState() {
+  OpenGL3_Data *bd = OpenGL3_GetBackendData();
+  if (bd == nullptr)
+    return;
+  bd->MainRenderState.Valid = false;
+  PlatformIO &platform_io = Gui::GetPlatformIO();
+  for (int i = 0; i < platform_io.Viewports.Size; i++)
+    if (OpenGL3_ViewportData *vd =
+            (OpenGL3_ViewportData *)platform_io.Viewports[i]->RendererUserData)
+      vd->RenderState.Valid = false;
+}
+
 //--------------------------------------------------------------------------------------------------------
 // MULTI-VIEWPORT / PLATFORM INTERFACE SUPPORT
 // This is an _advanced_ and _optional_ feature, allowing the backend to create
@@ -1022,6 +1331,27 @@ void OpenGL3_DestroyDeviceObjects() {
 // ignore this section first..
 //--------------------------------------------------------------------------------------------------------
 
+static OpenGL3_RenderState *OpenGL3_GetRenderState(DrawData *draw_data) {
+  OpenGL3_Data *bd = OpenGL3_GetBackendData();
+  if (draw_data->OwnerViewport != nullptr)
+    if (OpenGL3_ViewportData *vd = (OpenGL3_ViewportData *)
+                                       draw_data->OwnerViewport->RendererUserData)
+      return &vd->RenderState;
+  return &bd->MainRenderState;
+}
+
+static void OpenGL3_CreateWindow(Viewport *viewport) {
+  OpenGL3_ViewportData *vd = NEW(OpenGL3_ViewportData)();
+  viewport->RendererUserData = vd;
+}
+
+static void OpenGL3_DestroyWindow(Viewport *viewport) {
+  if (OpenGL3_ViewportData *vd =
+          (OpenGL3_ViewportData *)viewport->RendererUserData)
+    DELETE(vd);
+  viewport->RendererUserData = nullptr;
+}
+
 static void OpenGL3_RenderWindow(Viewport *viewport, void *) {
   if (!(viewport->Flags & ViewportFlags_NoRendererClear)) {
     Vec4 clear_color = Vec4(0.0f, 0.0f, 0.0f, 1.0f);
@@ -1033,6 +1363,8 @@ static void OpenGL3_RenderWindow(Viewport *viewport, void *) {
 
 static void OpenGL3_InitPlatformInterface() {
   PlatformIO &platform_io = Gui::GetPlatformIO();
+  platform_io.Renderer_CreateWindow = OpenGL3_CreateWindow;
+  platform_io.Renderer_DestroyWindow = OpenGL3_DestroyWindow;
   platform_io.Renderer_RenderWindow = OpenGL3_RenderWindow;
 }
 
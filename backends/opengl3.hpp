@@ -11,6 +11,8 @@
 //  meshes support (64k+ vertices) with 16-bit indices (Desktop OpenGL only).
 //  [X] Renderer: Multi-viewport support (multiple windows). Enable with
 //  'io.ConfigFlags |= ConfigFlags_ViewportsEnable'.
+//  [X] Renderer: Optional render state cache, to skip the backup/restore of
+//  GL state (see OpenGL3_SetRenderStateCache()).
 
 // About WebGL/ES:
 // - You need to '#define OPENGL_ES2' or '#define OPENGL_ES3' to use
@@ -37,6 +39,19 @@ API void OpenGL3_Shutdown();
 API void OpenGL3_NewFrame();
 API void OpenGL3_RenderDrawData(DrawData *draw_data);
 
+// (Optional) Render state cache
+// By default OpenGL3_RenderDrawData() backs up all the GL state it modifies
+// (~30 glGet/glIsEnabled calls, each of which may stall on some drivers or
+// under virtualized GL) and restores it afterwards, per window and per frame.
+// With the cache enabled, the backend assumes that it owns the GL state: it
+// doesn't backup nor restore anything, and only sets the state which differs
+// from what it set itself on the previous frame. The GL state is left as set
+// by the backend (e.g. GL_SCISSOR_TEST enabled, its program and VAO bound).
+// Call OpenGL3_InvalidateRenderState() after modifying GL state yourself (e.g.
+// after rendering your scene), so the next render sets up everything again.
+API void OpenGL3_SetRenderStateCache(bool enabled);
+API void OpenGL3_InvalidateRenderState();
+
 // (Optional) Called by Init/NewFrame/Shutdown
 API bool OpenGL3_CreateFontsTexture();
 API void OpenGL3_DestroyFontsTexture();
@@ -981,6 +981,23 @@ void SDL2_NewFrame() {
   SDL2_UpdateGamepads();
 }
 
+void SDL2_WaitForEvents() {
+#ifndef __EMSCRIPTEN__
+  SDL2_Data *bd = SDL2_GetBackendData();
+  double timeout = Gui::GetNextRedrawDeadline() - Gui::GetTime();
+  if (bd->Time > 0) // Time spent since NewFrame()
+    timeout -= (double)(SDL_GetPerformanceCounter() - bd->Time) /
+               SDL_GetPerformanceFrequency();
+  if (timeout <= 0.0)
+    return;
+  // Passing a NULL event leaves the event in the queue for SDL_PollEvent()
+  if (timeout < 1000000.0)
+    SDL_WaitEventTimeout(nullptr, (int)(timeout * 1000.0) + 1);
+  else
+    SDL_WaitEvent(nullptr);
+#endif
+}
+
 //--------------------------------------------------------------------------------------------------------
 // MULTI-VIEWPORT / PLATFORM INTERFACE SUPPORT
 // This is an _advanced_ and _optional_ feature, allowing the backend to create
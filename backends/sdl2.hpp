@@ -39,6 +39,11 @@ API void SDL2_Shutdown();
 API void SDL2_NewFrame();
 API bool SDL2_ProcessEvent(const SDL_Event *event);
 
+// Block until new events arrive or Gui::GetNextRedrawDeadline() is reached,
+// instead of rendering at full rate when nothing changes. Call it in your main
+// loop before polling events. Returns immediately when a frame is due.
+API void SDL2_WaitForEvents();
+
 #ifndef DISABLE_OBSOLETE_FUNCTIONS
 static inline void SDL2_NewFrame(SDL_Window *) {
   SDL2_NewFrame();
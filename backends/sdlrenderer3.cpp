@@ -18,6 +18,9 @@
 #include "../gui.hpp"
 #ifndef DISABLE
 #include "sdlrenderer3.hpp"
+#ifdef USE_DRAWVERT_COMPACT
+#error "This backend doesn't support USE_DRAWVERT_COMPACT"
+#endif
 #include <stdint.h> // intptr_t
 
 // Clang warnings with -Weverything
@@ -0,0 +1,853 @@
+// gui: Renderer Backend for CPU rendering (software rasterizer)
+// This needs to be used along with a Platform Backend (e.g. GLFW, SDL, Win32,
+// custom..), or without any for headless rendering (e.g. screenshots,
+// golden-image tests, backend-agnostic benchmarks on machines without a GPU).
+// Renders into a 32-bit framebuffer that you own, in the same format as
+// COL32() colors (RGBA bytes unless USE_BGRA_PACKED_COLOR is defined).
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'Software_Texture*' as TextureID.
+//  Read the FAQ about TextureID! [X] Renderer: Large meshes support (64k+
+//  vertices) with 16-bit indices. [X] Renderer: Tile-based multi-threaded
+//  rasterization, with SSE2 inner loops when available. [X] Renderer:
+//  Fill-rate statistics, see Software_GetStats().
+//  [X] Renderer: Compact vertex format (USE_DRAWVERT_COMPACT in config.hpp).
+//  [X] Renderer: Signed distance shapes (USE_DRAWVERT_SDF in config.hpp).
+// Missing features:
+//  [ ] Renderer: Multi-viewport support (multiple windows).
+//  [ ] Renderer: Bilinear filtering. Textures are point-sampled, which matches
+//  bilinear sampling for text and baked lines drawn at 1:1 scale.
+
+// How it works:
+// - Setup (calling thread): every triangle is transformed to framebuffer
+// space, culled against its scissor rectangle, turned into edge functions and
+// attribute planes, and appended to the triangle list of every tile (band of
+// SOFTWARE_TILE_HEIGHT rows) it overlaps. Binning preserves submission order.
+// - Rasterization (all threads): each thread grabs the next tile and draws
+// its triangles in order, 4 pixels at a time. Tiles don't overlap, so threads
+// never write to the same pixels and blending order is preserved. Worker
+// threads are started by Software_Init() and woken up for each frame, the
+// calling thread rasterizes tiles too and waits for them to be done.
+// - Pixel centers are at +0.5, coverage follows the top-left rule so pixels on
+// edges shared by two triangles are blended only once.
+// - Blending matches the other backends: src*srcA + dst*(1-srcA) for colors,
+// srcA + dstA*(1-srcA) for alpha (so the output can be composited).
+// - User callbacks are called during setup, before any triangle of the frame
+// is rasterized.
+
+#include "../gui.hpp"
+#ifndef DISABLE
+#include "software.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <math.h> // floorf, ceilf, lrintf, sqrtf
+#include <mutex>
+#include <thread>
+
+// SSE2 is used for the inner loops when available
+#if !defined(DISABLE_SSE) &&                                                   \
+    (defined(__SSE2__) || defined(_M_X64) ||                                   \
+     (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define SOFTWARE_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+static const int SOFTWARE_TILE_HEIGHT = 16; // Rows of pixels per tile
+static const int SOFTWARE_MAX_THREADS = 64;
+
+enum Software_TriangleFlags_ {
+  Software_TriangleFlags_None = 0,
+  Software_TriangleFlags_FlatColor = 1 << 0, // Same color on all vertices
+  Software_TriangleFlags_FlatTexel = 1 << 1, // Same UV on all vertices
+  Software_TriangleFlags_Sdf = 1 << 2,       // Signed distance shape
+};
+
+// Helpers (backends don't include internal.hpp)
+template <typename T> static inline T Software_Min(T lhs, T rhs) {
+  return lhs < rhs ? lhs : rhs;
+}
+template <typename T> static inline T Software_Max(T lhs, T rhs) {
+  return lhs >= rhs ? lhs : rhs;
+}
+template <typename T> static inline T Software_Clamp(T v, T mn, T mx) {
+  return (v < mn) ? mn : (v > mx) ? mx : v;
+}
+template <typename T> static inline void Software_Swap(T &a, T &b) {
+  T tmp = a;
+  a = b;
+  b = tmp;
+}
+
+// Triangle ready for rasterization. Edge functions and attribute planes are
+// relative to (MinX, MinY) to preserve float precision.
+struct Software_Triangle {
+  float EdgeA[3], EdgeB[3], EdgeC[3]; // E(x,y) = A*x + B*y + C, >0 inside
+  bool EdgeTopLeft[3];                // Include pixels where E(x,y) == 0
+  float Color[4][3]; // Per color byte: value = [0]*x + [1]*y + [2]
+  float Uv[2][3];    // In texels
+  int MinX, MinY, MaxX, MaxY; // Clipped bounding box, max is exclusive
+  int Flags;                  // Software_TriangleFlags_
+  unsigned int FlatColor; // When FlatColor: vertex color, modulated by the
+                          // texel when FlatTexel is also set.
+  unsigned int FlatTexel; // When FlatTexel only
+  const Software_Texture *Texture;
+#ifdef USE_DRAWVERT_SDF
+  float SdfPos[2][3]; // Position relative to the shape center, in pixels
+  float SdfSize[2];   // Half size of the shape
+  float SdfRadii[4];  // TopLeft, TopRight, BottomLeft, BottomRight rounding
+  float SdfThickness; // Outline thickness, 0.0f for a filled shape
+#endif
+};
+
+// Render target and per-thread statistics
+struct Software_Target {
+  unsigned int *Pixels;
+  int Width;
+  int Height;
+  int Pitch; // In pixels
+};
+
+struct Software_ThreadStats {
+  long long PixelsTested;
+  long long PixelsWritten;
+};
+
+// Worker threads, sleeping between frames. Each frame bumps Generation to
+// wake them up, the last one to finish notifies DoneCond.
+struct Software_Data;
+struct Software_WorkerPool {
+  std::mutex Mutex;
+  std::condition_variable WorkCond;
+  std::condition_variable DoneCond;
+  std::thread Threads[SOFTWARE_MAX_THREADS]; // [0] is the calling thread
+  unsigned int Generation = 0;
+  int PendingCount = 0; // Workers still rasterizing the current frame
+  int ActiveCount = 0;  // Threads used by the current frame
+  bool Quit = false;
+  const Software_Target *Target = nullptr;
+  std::atomic<int> *NextTile = nullptr;
+  Software_ThreadStats ThreadsStats[SOFTWARE_MAX_THREADS];
+};
+
+// Software data
+struct Software_Data {
+  Software_Texture FontTexture;
+  int ThreadsCount;
+  Software_WorkerPool *Workers; // nullptr when ThreadsCount == 1
+  Vector<Software_Triangle> Triangles;
+  Vector<int> TileTriangles; // Triangle indices of all tiles, in order
+  Vector<int> TileOffsets;   // Range of each tile in TileTriangles
+  Software_Stats Stats;
+
+  Software_Data() { memset((void *)this, 0, sizeof(*this)); }
+};
+
+// Backend data stored in io.BackendRendererUserData to allow support for
+// multiple Gui contexts It is STRONGLY preferred that you use docking
+// branch with multi-viewports (== single Gui context + multiple windows)
+// instead of multiple Gui contexts.
+static Software_Data *Software_GetBackendData() {
+  return Gui::GetCurrentContext()
+             ? (Software_Data *)Gui::GetIO().BackendRendererUserData
+             : nullptr;
+}
+
+static void Software_RasterizeTiles(Software_Data *bd,
+                                    const Software_Target *target,
+                                    std::atomic<int> *next_tile,
+                                    Software_ThreadStats *stats);
+
+static void Software_WorkerThread(Software_Data *bd, int thread_n) {
+  Software_WorkerPool *pool = bd->Workers;
+  unsigned int generation = 0;
+  std::unique_lock<std::mutex> lock(pool->Mutex);
+  for (;;) {
+    pool->WorkCond.wait(lock, [&] {
+      return pool->Quit || pool->Generation != generation;
+    });
+    if (pool->Quit)
+      return;
+    generation = pool->Generation;
+    if (thread_n >= pool->ActiveCount)
+      continue;
+    lock.unlock();
+    Software_RasterizeTiles(bd, pool->Target, pool->NextTile,
+                            &pool->ThreadsStats[thread_n]);
+    lock.lock();
+    if (--pool->PendingCount == 0)
+      pool->DoneCond.notify_one();
+  }
+}
+
+// Functions
+bool Software_Init(int threads_count) {
+  IO &io = Gui::GetIO();
+  assert(io.BackendRendererUserData == nullptr &&
+         "Already initialized a renderer backend!");
+
+  // Setup backend capabilities flags
+  Software_Data *bd = NEW(Software_Data)();
+  io.BackendRendererUserData = (void *)bd;
+  io.BackendRendererName = "software";
+  io.BackendFlags |=
+      BackendFlags_RendererHasVtxOffset; // We can honor the
+                                         // DrawCmd::VtxOffset field,
+                                         // allowing for large meshes.
+#ifdef USE_DRAWVERT_SDF
+  io.BackendFlags |= BackendFlags_RendererHasSdfShapes;
+#endif
+
+  if (threads_count <= 0)
+    threads_count = (int)std::thread::hardware_concurrency();
+  bd->ThreadsCount = Software_Clamp(threads_count, 1, SOFTWARE_MAX_THREADS);
+  if (bd->ThreadsCount > 1) {
+    bd->Workers = NEW(Software_WorkerPool)();
+    for (int thread_n = 1; thread_n < bd->ThreadsCount; thread_n++)
+      bd->Workers->Threads[thread_n] =
+          std::thread(Software_WorkerThread, bd, thread_n);
+  }
+
+  return true;
+}
+
+void Software_Shutdown() {
+  Software_Data *bd = Software_GetBackendData();
+  assert(bd != nullptr &&
+         "No renderer backend to shutdown, or already shutdown?");
+  IO &io = Gui::GetIO();
+
+  if (Software_WorkerPool *pool = bd->Workers) {
+    {
+      std::lock_guard<std::mutex> lock(pool->Mutex);
+      pool->Quit = true;
+    }
+    pool->WorkCond.notify_all();
+    for (int thread_n = 1; thread_n < bd->ThreadsCount; thread_n++)
+      pool->Threads[thread_n].join();
+    DELETE(pool);
+    bd->Workers = nullptr;
+  }
+  Software_DestroyFontsTexture();
+  io.BackendRendererName = nullptr;
+  io.BackendRendererUserData = nullptr;
+  io.BackendFlags &= ~(BackendFlags_RendererHasVtxOffset |
+                       BackendFlags_RendererHasSdfShapes);
+  bd->Triangles.clear();
+  bd->TileTriangles.clear();
+  bd->TileOffsets.clear();
+  DELETE(bd);
+}
+
+void Software_NewFrame() {
+  Software_Data *bd = Software_GetBackendData();
+  assert(bd != nullptr && "Did you call Software_Init()?");
+
+  if (bd->FontTexture.Pixels == nullptr)
+    Software_CreateFontsTexture();
+}
+
+const Software_Stats &Software_GetStats() {
+  Software_Data *bd = Software_GetBackendData();
+  assert(bd != nullptr && "Did you call Software_Init()?");
+  return bd->Stats;
+}
+
+static inline unsigned int Software_Div255(unsigned int x) {
+  return (x + 128 + ((x + 128) >> 8)) >> 8;
+}
+
+// Multiply two colors channel by channel
+static inline unsigned int Software_Modulate(unsigned int a, unsigned int b) {
+  unsigned int out = 0;
+  for (int shift = 0; shift < 32; shift += 8)
+    out |= Software_Div255(((a >> shift) & 0xFF) * ((b >> shift) & 0xFF))
+           << shift;
+  return out;
+}
+
+static inline unsigned int Software_Blend(unsigned int src, unsigned int dst) {
+  const unsigned int src_a = src >> COL32_A_SHIFT;
+  const unsigned int inv_a = 255 - src_a;
+  unsigned int out = 0;
+  for (int shift = 0; shift < 32; shift += 8) {
+    const unsigned int src_factor = (shift == COL32_A_SHIFT) ? 255 : src_a;
+    out |= Software_Div255(((src >> shift) & 0xFF) * src_factor +
+                           ((dst >> shift) & 0xFF) * inv_a)
+           << shift;
+  }
+  return out;
+}
+
+static inline unsigned int Software_SampleTexture(const Software_Texture *tex,
+                                                  float u, float v) {
+  const int x = (int)Software_Clamp(u, 0.0f, (float)(tex->Width - 1));
+  const int y = (int)Software_Clamp(v, 0.0f, (float)(tex->Height - 1));
+  return tex->Pixels[y * tex->Width + x];
+}
+
+// Setup the plane interpolating the vertex values over a triangle
+static inline void Software_SetupPlane(const Software_Triangle *tri,
+                                       const float values[3], float inv_area,
+                                       float plane[3]) {
+  for (int k = 0; k < 3; k++) {
+    const float *coefs = (k == 0)   ? tri->EdgeA
+                         : (k == 1) ? tri->EdgeB
+                                    : tri->EdgeC;
+    plane[k] =
+        (coefs[0] * values[0] + coefs[1] * values[1] + coefs[2] * values[2]) *
+        inv_area;
+  }
+}
+
+// Transform, cull and setup one triangle. Return false if it has no pixel to
+// rasterize.
+static bool Software_SetupTriangle(Software_Triangle *tri,
+                                   const DrawList *draw_list,
+                                   const DrawVert *v0, const DrawVert *v1,
+                                   const DrawVert *v2,
+                                   const Software_Texture *tex, Vec2 pos_off,
+                                   Vec2 pos_scale, const int clip[4]) {
+  // Skip triangles which can't affect the framebuffer
+  if (((v0->col | v1->col | v2->col) & COL32_A_MASK) == 0)
+    return false;
+
+  const DrawVert *verts[3] = {v0, v1, v2};
+  float px[3], py[3];
+  for (int n = 0; n < 3; n++) {
+    const Vec2 pos = draw_list->_VtxGetPos(verts[n]);
+    px[n] = (pos.x - pos_off.x) * pos_scale.x;
+    py[n] = (pos.y - pos_off.y) * pos_scale.y;
+  }
+  float area = (px[1] - px[0]) * (py[2] - py[0]) -
+               (py[1] - py[0]) * (px[2] - px[0]);
+  if (area == 0.0f)
+    return false;
+  if (area < 0.0f) {
+    // Make all triangles counter-clockwise (in a Y-down space)
+    Software_Swap(verts[1], verts[2]);
+    Software_Swap(px[1], px[2]);
+    Software_Swap(py[1], py[2]);
+    area = -area;
+  }
+
+  const float min_x = Software_Min(Software_Min(px[0], px[1]), px[2]);
+  const float min_y = Software_Min(Software_Min(py[0], py[1]), py[2]);
+  const float max_x = Software_Max(Software_Max(px[0], px[1]), px[2]);
+  const float max_y = Software_Max(Software_Max(py[0], py[1]), py[2]);
+  tri->MinX = Software_Max(clip[0], (int)floorf(min_x));
+  tri->MinY = Software_Max(clip[1], (int)floorf(min_y));
+  tri->MaxX = Software_Min(clip[2], (int)ceilf(max_x));
+  tri->MaxY = Software_Min(clip[3], (int)ceilf(max_y));
+  if (tri->MinX >= tri->MaxX || tri->MinY >= tri->MaxY)
+    return false;
+
+  // Edge n is opposite to vertex n, E_n / area is the barycentric weight of
+  // vertex n.
+  for (int n = 0; n < 3; n++) {
+    px[n] -= (float)tri->MinX;
+    py[n] -= (float)tri->MinY;
+  }
+  for (int n = 0; n < 3; n++) {
+    const int a = (n + 1) % 3;
+    const int b = (n + 2) % 3;
+    const float dx = px[b] - px[a];
+    const float dy = py[b] - py[a];
+    tri->EdgeA[n] = -dy;
+    tri->EdgeB[n] = dx;
+    tri->EdgeC[n] = dy * px[a] - dx * py[a];
+    tri->EdgeTopLeft[n] = (dy < 0.0f) || (dy == 0.0f && dx > 0.0f);
+  }
+
+  // Attribute planes
+  const float inv_area = 1.0f / area;
+  Vec2 uv[3];
+  for (int n = 0; n < 3; n++)
+    uv[n] = draw_list->_VtxGetUV(verts[n]);
+#ifdef USE_DRAWVERT_SDF
+  const bool is_sdf = (verts[0]->sdf[0] != 0);
+  if (is_sdf)
+    tex = nullptr; // The UV are shape coordinates
+#endif
+  tri->Flags = Software_TriangleFlags_None;
+  if (v0->col == v1->col && v0->col == v2->col)
+    tri->Flags |= Software_TriangleFlags_FlatColor;
+  if (tex == nullptr || (uv[0].x == uv[1].x && uv[0].x == uv[2].x &&
+                         uv[0].y == uv[1].y && uv[0].y == uv[2].y))
+    tri->Flags |= Software_TriangleFlags_FlatTexel;
+  for (int channel = 0; channel < 4; channel++) {
+    float values[3];
+    for (int n = 0; n < 3; n++)
+      values[n] = (float)((verts[n]->col >> (channel * 8)) & 0xFF);
+    Software_SetupPlane(tri, values, inv_area, tri->Color[channel]);
+  }
+  if (tex != nullptr)
+    for (int axis = 0; axis < 2; axis++) {
+      const float size = (float)(axis == 0 ? tex->Width : tex->Height);
+      float values[3];
+      for (int n = 0; n < 3; n++)
+        values[n] = (axis == 0 ? uv[n].x : uv[n].y) * size;
+      Software_SetupPlane(tri, values, inv_area, tri->Uv[axis]);
+    }
+#ifdef USE_DRAWVERT_SDF
+  if (is_sdf) {
+    // Decode the shape (see DrawVert::sdf), UV span the shape quad
+    const unsigned short *sdf = verts[0]->sdf;
+    const float scale = 1.0f / DRAWVERT_SDF_SCALE;
+    const float rounding = (float)(sdf[2] & 0x0FFF) * scale;
+    tri->Flags |= Software_TriangleFlags_Sdf;
+    tri->SdfSize[0] = (float)sdf[0] * scale;
+    tri->SdfSize[1] = (float)sdf[1] * scale;
+    tri->SdfThickness = (float)sdf[3] * scale;
+    for (int corner = 0; corner < 4; corner++)
+      tri->SdfRadii[corner] = (sdf[2] & (1 << (12 + corner))) ? rounding : 0.0f;
+    for (int axis = 0; axis < 2; axis++) {
+      const float extent = tri->SdfSize[axis] + tri->SdfThickness * 0.5f + 1.0f;
+      float values[3];
+      for (int n = 0; n < 3; n++)
+        values[n] = ((axis == 0 ? uv[n].x : uv[n].y) * 2.0f - 1.0f) * extent;
+      Software_SetupPlane(tri, values, inv_area, tri->SdfPos[axis]);
+    }
+  }
+#endif
+  tri->Texture = tex;
+  tri->FlatTexel =
+      tex ? Software_SampleTexture(tex, uv[0].x * tex->Width,
+                                   uv[0].y * tex->Height)
+          : 0xFFFFFFFF;
+  tri->FlatColor = v0->col;
+  if ((tri->Flags & Software_TriangleFlags_FlatColor) &&
+      (tri->Flags & Software_TriangleFlags_FlatTexel) &&
+      tri->FlatTexel != 0xFFFFFFFF)
+    tri->FlatColor = Software_Modulate(tri->FlatColor, tri->FlatTexel);
+  return true;
+}
+
+#ifdef USE_DRAWVERT_SDF
+// Coverage of the signed distance shape at (x,y) relative to the triangle
+// bounding box. Anti-aliasing is 1 pixel wide, like the tessellated shapes.
+static inline float Software_SdfCoverage(const Software_Triangle *tri, float x,
+                                         float y) {
+  const float px =
+      tri->SdfPos[0][0] * x + (tri->SdfPos[0][1] * y + tri->SdfPos[0][2]);
+  const float py =
+      tri->SdfPos[1][0] * x + (tri->SdfPos[1][1] * y + tri->SdfPos[1][2]);
+  const float r = tri->SdfRadii[(px > 0.0f ? 1 : 0) + (py > 0.0f ? 2 : 0)];
+  const float qx = fabsf(px) - tri->SdfSize[0] + r;
+  const float qy = fabsf(py) - tri->SdfSize[1] + r;
+  const float ox = Software_Max(qx, 0.0f);
+  const float oy = Software_Max(qy, 0.0f);
+  float d = sqrtf(ox * ox + oy * oy) +
+            Software_Min(Software_Max(qx, qy), 0.0f) - r;
+  if (tri->SdfThickness > 0.0f)
+    d = fabsf(d) - tri->SdfThickness * 0.5f;
+  return Software_Clamp(0.5f - d, 0.0f, 1.0f);
+}
+#endif
+
+// Shade one pixel at (x,y) relative to the triangle bounding box
+static inline unsigned int Software_ShadePixel(const Software_Triangle *tri,
+                                               float x, float y) {
+#ifdef USE_DRAWVERT_SDF
+  if (tri->Flags & Software_TriangleFlags_Sdf) {
+    unsigned int col = tri->FlatColor;
+    if (!(tri->Flags & Software_TriangleFlags_FlatColor)) {
+      col = 0;
+      for (int channel = 0; channel < 4; channel++) {
+        const float *plane = tri->Color[channel];
+        const float value = plane[0] * x + (plane[1] * y + plane[2]);
+        col |= (unsigned int)lrintf(Software_Clamp(value, 0.0f, 255.0f))
+               << (channel * 8);
+      }
+    }
+    const float coverage = Software_SdfCoverage(tri, x, y);
+    const float alpha = (float)((col >> COL32_A_SHIFT) & 0xFF) * coverage;
+    return (col & ~COL32_A_MASK) | ((unsigned int)lrintf(alpha)
+                                    << COL32_A_SHIFT);
+  }
+#endif
+  if ((tri->Flags & Software_TriangleFlags_FlatColor) &&
+      (tri->Flags & Software_TriangleFlags_FlatTexel))
+    return tri->FlatColor;
+  unsigned int col = tri->FlatColor;
+  if (!(tri->Flags & Software_TriangleFlags_FlatColor)) {
+    col = 0;
+    for (int channel = 0; channel < 4; channel++) {
+      const float *plane = tri->Color[channel];
+      const float value = plane[0] * x + (plane[1] * y + plane[2]);
+      col |= (unsigned int)lrintf(Software_Clamp(value, 0.0f, 255.0f))
+             << (channel * 8);
+    }
+  }
+  const unsigned int texel =
+      (tri->Flags & Software_TriangleFlags_FlatTexel)
+          ? tri->FlatTexel
+          : Software_SampleTexture(
+                tri->Texture,
+                tri->Uv[0][0] * x + (tri->Uv[0][1] * y + tri->Uv[0][2]),
+                tri->Uv[1][0] * x + (tri->Uv[1][1] * y + tri->Uv[1][2]));
+  return (texel == 0xFFFFFFFF) ? col : Software_Modulate(col, texel);
+}
+
+#ifdef SOFTWARE_USE_SSE2
+// Divide 16-bit lanes by 255 with rounding (exact for products of 8-bit
+// values)
+static inline __m128i Software_Div255_SSE2(__m128i x) {
+  x = _mm_add_epi16(x, _mm_set1_epi16(128));
+  return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+static inline __m128i Software_Modulate_SSE2(__m128i a, __m128i b) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i lo = Software_Div255_SSE2(_mm_mullo_epi16(
+      _mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)));
+  const __m128i hi = Software_Div255_SSE2(_mm_mullo_epi16(
+      _mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)));
+  return _mm_packus_epi16(lo, hi);
+}
+
+// Blend 2 pixels unpacked to 16-bit lanes
+static inline __m128i Software_Blend16_SSE2(__m128i src, __m128i dst) {
+  const int a = COL32_A_SHIFT / 8;
+  __m128i src_a =
+      _mm_shufflelo_epi16(src, _MM_SHUFFLE(a, a, a, a)); // Broadcast alpha
+  src_a = _mm_shufflehi_epi16(src_a, _MM_SHUFFLE(a, a, a, a));
+  const __m128i alpha_lanes = _mm_set_epi16(
+      a == 3 ? -1 : 0, a == 2 ? -1 : 0, a == 1 ? -1 : 0, a == 0 ? -1 : 0,
+      a == 3 ? -1 : 0, a == 2 ? -1 : 0, a == 1 ? -1 : 0, a == 0 ? -1 : 0);
+  const __m128i src_factor =
+      _mm_or_si128(_mm_andnot_si128(alpha_lanes, src_a),
+                   _mm_and_si128(alpha_lanes, _mm_set1_epi16(255)));
+  const __m128i inv_a = _mm_sub_epi16(_mm_set1_epi16(255), src_a);
+  return Software_Div255_SSE2(_mm_add_epi16(_mm_mullo_epi16(src, src_factor),
+                                            _mm_mullo_epi16(dst, inv_a)));
+}
+
+static inline __m128i Software_Blend_SSE2(__m128i src, __m128i dst) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i lo = Software_Blend16_SSE2(_mm_unpacklo_epi8(src, zero),
+                                           _mm_unpacklo_epi8(dst, zero));
+  const __m128i hi = Software_Blend16_SSE2(_mm_unpackhi_epi8(src, zero),
+                                           _mm_unpackhi_epi8(dst, zero));
+  return _mm_packus_epi16(lo, hi);
+}
+
+static inline __m128 Software_EvalPlane_SSE2(const float plane[3], __m128 x,
+                                             float y) {
+  return _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane[0]), x),
+                    _mm_set1_ps(plane[1] * y + plane[2]));
+}
+
+// Shade 4 pixels at (x[0..3],y) relative to the triangle bounding box
+static inline __m128i Software_ShadePixels_SSE2(const Software_Triangle *tri,
+                                                __m128 x, float y) {
+#ifdef USE_DRAWVERT_SDF
+  if (tri->Flags & Software_TriangleFlags_Sdf) {
+    float xs[4];
+    _mm_storeu_ps(xs, x);
+    return _mm_set_epi32((int)Software_ShadePixel(tri, xs[3], y),
+                         (int)Software_ShadePixel(tri, xs[2], y),
+                         (int)Software_ShadePixel(tri, xs[1], y),
+                         (int)Software_ShadePixel(tri, xs[0], y));
+  }
+#endif
+  if ((tri->Flags & Software_TriangleFlags_FlatColor) &&
+      (tri->Flags & Software_TriangleFlags_FlatTexel))
+    return _mm_set1_epi32((int)tri->FlatColor);
+  __m128i col;
+  if (tri->Flags & Software_TriangleFlags_FlatColor) {
+    col = _mm_set1_epi32((int)tri->FlatColor);
+  } else {
+    col = _mm_setzero_si128();
+    for (int channel = 0; channel < 4; channel++) {
+      __m128 value = Software_EvalPlane_SSE2(tri->Color[channel], x, y);
+      value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()),
+                         _mm_set1_ps(255.0f));
+      const __m128i channel_i = _mm_cvtps_epi32(value);
+      switch (channel) {
+      case 0: col = _mm_or_si128(col, channel_i); break;
+      case 1: col = _mm_or_si128(col, _mm_slli_epi32(channel_i, 8)); break;
+      case 2: col = _mm_or_si128(col, _mm_slli_epi32(channel_i, 16)); break;
+      case 3: col = _mm_or_si128(col, _mm_slli_epi32(channel_i, 24)); break;
+      }
+    }
+  }
+  if (tri->Flags & Software_TriangleFlags_FlatTexel)
+    return (tri->FlatTexel == 0xFFFFFFFF)
+               ? col
+               : Software_Modulate_SSE2(col,
+                                        _mm_set1_epi32((int)tri->FlatTexel));
+
+  // Point-sample the texture. SSE2 has no gather: compute texel offsets in
+  // float (exact for textures up to 4096x4096) and fetch them one by one.
+  const Software_Texture *tex = tri->Texture;
+  const __m128 zero = _mm_setzero_ps();
+  __m128 u = Software_EvalPlane_SSE2(tri->Uv[0], x, y);
+  __m128 v = Software_EvalPlane_SSE2(tri->Uv[1], x, y);
+  u = _mm_min_ps(_mm_max_ps(u, zero), _mm_set1_ps((float)(tex->Width - 1)));
+  v = _mm_min_ps(_mm_max_ps(v, zero), _mm_set1_ps((float)(tex->Height - 1)));
+  const __m128 offset = _mm_add_ps(
+      _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvttps_epi32(v)),
+                 _mm_set1_ps((float)tex->Width)),
+      _mm_cvtepi32_ps(_mm_cvttps_epi32(u)));
+  int offsets[4];
+  _mm_storeu_si128((__m128i *)offsets, _mm_cvttps_epi32(offset));
+  const __m128i texels = _mm_set_epi32(
+      (int)tex->Pixels[offsets[3]], (int)tex->Pixels[offsets[2]],
+      (int)tex->Pixels[offsets[1]], (int)tex->Pixels[offsets[0]]);
+  return Software_Modulate_SSE2(col, texels);
+}
+#endif
+
+// Rasterize the part of a triangle within rows [y0, y1)
+static void Software_RasterizeTriangle(const Software_Triangle *tri,
+                                       const Software_Target *target, int y0,
+                                       int y1, Software_ThreadStats *stats) {
+  y0 = Software_Max(y0, tri->MinY);
+  y1 = Software_Min(y1, tri->MaxY);
+  const int width = tri->MaxX - tri->MinX;
+#ifdef SOFTWARE_USE_SSE2
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 lanes = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f); // Pixel centers
+  __m128 edge_a[3], edge_top_left[3];
+  for (int n = 0; n < 3; n++) {
+    edge_a[n] = _mm_set1_ps(tri->EdgeA[n]);
+    edge_top_left[n] = _mm_castsi128_ps(
+        _mm_set1_epi32(tri->EdgeTopLeft[n] ? -1 : 0));
+  }
+#endif
+  for (int y = y0; y < y1; y++) {
+    const float fy = (float)(y - tri->MinY) + 0.5f;
+    unsigned int *row = target->Pixels + (size_t)y * target->Pitch + tri->MinX;
+    int x = 0;
+#ifdef SOFTWARE_USE_SSE2
+    __m128 edge_row[3];
+    for (int n = 0; n < 3; n++)
+      edge_row[n] = _mm_set1_ps(tri->EdgeB[n] * fy + tri->EdgeC[n]);
+    for (; x < width; x += 4) {
+      const __m128 fx = _mm_add_ps(_mm_set1_ps((float)x), lanes);
+      __m128 inside = _mm_castsi128_ps(_mm_cmplt_epi32(
+          _mm_set_epi32(x + 3, x + 2, x + 1, x), _mm_set1_epi32(width)));
+      for (int n = 0; n < 3; n++) {
+        const __m128 e = _mm_add_ps(_mm_mul_ps(edge_a[n], fx), edge_row[n]);
+        inside = _mm_and_ps(
+            inside, _mm_or_ps(_mm_cmpgt_ps(e, zero),
+                              _mm_and_ps(_mm_cmpeq_ps(e, zero),
+                                         edge_top_left[n])));
+      }
+      const int mask = _mm_movemask_ps(inside);
+      stats->PixelsTested += Software_Min(width - x, 4);
+      if (mask == 0)
+        continue;
+      stats->PixelsWritten += (mask & 1) + ((mask >> 1) & 1) +
+                              ((mask >> 2) & 1) + ((mask >> 3) & 1);
+      const __m128i src = Software_ShadePixels_SSE2(tri, fx, fy);
+      if (mask == 0x0F) {
+        __m128i *dst_ptr = (__m128i *)(row + x);
+        _mm_storeu_si128(dst_ptr,
+                         Software_Blend_SSE2(src, _mm_loadu_si128(dst_ptr)));
+      } else {
+        // Partial group (may be past the end of the row): blend lane by lane
+        unsigned int src_pixels[4];
+        _mm_storeu_si128((__m128i *)src_pixels, src);
+        for (int lane = 0; lane < 4; lane++)
+          if (mask & (1 << lane))
+            row[x + lane] = Software_Blend(src_pixels[lane], row[x + lane]);
+      }
+    }
+#else
+    for (; x < width; x++) {
+      const float fx = (float)x + 0.5f;
+      bool inside = true;
+      for (int n = 0; n < 3 && inside; n++) {
+        const float e =
+            tri->EdgeA[n] * fx + (tri->EdgeB[n] * fy + tri->EdgeC[n]);
+        inside = (e > 0.0f) || (e == 0.0f && tri->EdgeTopLeft[n]);
+      }
+      stats->PixelsTested++;
+      if (!inside)
+        continue;
+      stats->PixelsWritten++;
+      row[x] = Software_Blend(Software_ShadePixel(tri, fx, fy), row[x]);
+    }
+#endif
+  }
+}
+
+static void Software_RasterizeTiles(Software_Data *bd,
+                                    const Software_Target *target,
+                                    std::atomic<int> *next_tile,
+                                    Software_ThreadStats *stats) {
+  const int tiles_count = bd->TileOffsets.Size - 1;
+  for (int tile_n = next_tile->fetch_add(1); tile_n < tiles_count;
+       tile_n = next_tile->fetch_add(1)) {
+    const int y0 = tile_n * SOFTWARE_TILE_HEIGHT;
+    const int y1 = Software_Min(y0 + SOFTWARE_TILE_HEIGHT, target->Height);
+    for (int n = bd->TileOffsets[tile_n]; n < bd->TileOffsets[tile_n + 1]; n++)
+      Software_RasterizeTriangle(&bd->Triangles[bd->TileTriangles[n]], target,
+                                 y0, y1, stats);
+  }
+}
+
+// Software Render function.
+void Software_RenderDrawData(DrawData *draw_data, unsigned int *pixels,
+                             int width, int height, int pitch) {
+  Software_Data *bd = Software_GetBackendData();
+  assert(bd != nullptr && "Did you call Software_Init()?");
+  assert(pixels != nullptr && (pitch % 4) == 0 && pitch >= width * 4);
+  Software_Stats &stats = bd->Stats;
+  memset(&stats, 0, sizeof(stats));
+  if (width <= 0 || height <= 0)
+    return;
+  const auto time_start = std::chrono::steady_clock::now();
+
+  // Will project vertices and scissor/clipping rectangles into framebuffer
+  // space
+  Vec2 clip_off = draw_data->DisplayPos; // (0,0) unless using multi-viewports
+  Vec2 clip_scale =
+      draw_data->FramebufferScale; // (1,1) unless using retina display which
+                                   // are often (2,2)
+
+  // Setup triangles
+  bd->Triangles.resize(0);
+  for (int n = 0; n < draw_data->CmdListsCount; n++) {
+    const DrawList *cmd_list = draw_data->CmdLists[n];
+    for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++) {
+      const DrawCmd *pcmd = &cmd_list->CmdBuffer[cmd_i];
+      if (pcmd->UserCallback) {
+        // User callback, registered via DrawList::AddCallback()
+        // (DrawCallback_ResetRenderState is a special callback value used by
+        // the user to request the renderer to reset render state.)
+        if (pcmd->UserCallback != DrawCallback_ResetRenderState)
+          pcmd->UserCallback(cmd_list, pcmd);
+        continue;
+      }
+
+      // Project scissor/clipping rectangles into framebuffer space
+      int clip[4];
+      const Vec4 &rect = pcmd->ClipRect;
+      clip[0] = Software_Max(0, (int)((rect.x - clip_off.x) * clip_scale.x));
+      clip[1] = Software_Max(0, (int)((rect.y - clip_off.y) * clip_scale.y));
+      clip[2] =
+          Software_Min(width, (int)((rect.z - clip_off.x) * clip_scale.x));
+      clip[3] =
+          Software_Min(height, (int)((rect.w - clip_off.y) * clip_scale.y));
+      stats.TrianglesCount += (int)pcmd->ElemCount / 3;
+      if (clip[2] <= clip[0] || clip[3] <= clip[1])
+        continue;
+
+      const Software_Texture *tex = (const Software_Texture *)pcmd->GetTexID();
+      const DrawVert *vtx_buffer = cmd_list->VtxBuffer.Data + pcmd->VtxOffset;
+      const DrawIdx *idx_buffer = cmd_list->IdxBuffer.Data + pcmd->IdxOffset;
+      bd->Triangles.reserve(bd->Triangles.Size + (int)pcmd->ElemCount / 3);
+      for (unsigned int idx_n = 0; idx_n + 2 < pcmd->ElemCount; idx_n += 3) {
+        Software_Triangle *tri = bd->Triangles.Data + bd->Triangles.Size;
+        if (Software_SetupTriangle(tri, cmd_list,
+                                   &vtx_buffer[idx_buffer[idx_n]],
+                                   &vtx_buffer[idx_buffer[idx_n + 1]],
+                                   &vtx_buffer[idx_buffer[idx_n + 2]], tex,
+                                   clip_off, clip_scale, clip))
+          bd->Triangles.Size++;
+      }
+    }
+  }
+  stats.TrianglesRasterized = bd->Triangles.Size;
+
+  // Bin triangles into tiles (counting sort, keeps submission order)
+  const int tiles_count =
+      (height + SOFTWARE_TILE_HEIGHT - 1) / SOFTWARE_TILE_HEIGHT;
+  bd->TileOffsets.resize(tiles_count + 1);
+  memset(bd->TileOffsets.Data, 0, (size_t)bd->TileOffsets.size_in_bytes());
+  for (const Software_Triangle &tri : bd->Triangles)
+    for (int tile_n = tri.MinY / SOFTWARE_TILE_HEIGHT;
+         tile_n <= (tri.MaxY - 1) / SOFTWARE_TILE_HEIGHT; tile_n++)
+      bd->TileOffsets[tile_n + 1]++;
+  for (int tile_n = 0; tile_n < tiles_count; tile_n++)
+    bd->TileOffsets[tile_n + 1] += bd->TileOffsets[tile_n];
+  bd->TileTriangles.resize(bd->TileOffsets[tiles_count]);
+  for (int tri_n = 0; tri_n < bd->Triangles.Size; tri_n++) {
+    const Software_Triangle &tri = bd->Triangles[tri_n];
+    for (int tile_n = tri.MinY / SOFTWARE_TILE_HEIGHT;
+         tile_n <= (tri.MaxY - 1) / SOFTWARE_TILE_HEIGHT; tile_n++)
+      bd->TileTriangles[bd->TileOffsets[tile_n]++] = tri_n;
+  }
+  for (int tile_n = tiles_count; tile_n > 0; tile_n--) // Undo the fill offsets
+    bd->TileOffsets[tile_n] = bd->TileOffsets[tile_n - 1];
+  bd->TileOffsets[0] = 0;
+  const auto time_setup = std::chrono::steady_clock::now();
+
+  // Rasterize tiles on all threads
+  Software_Target target = {pixels, width, height, pitch / 4};
+  const int threads_count = Software_Min(bd->ThreadsCount, tiles_count);
+  std::atomic<int> next_tile(0);
+  Software_ThreadStats main_stats = {};
+  Software_ThreadStats *threads_stats = &main_stats;
+  Software_WorkerPool *pool = threads_count > 1 ? bd->Workers : nullptr;
+  if (pool) {
+    threads_stats = pool->ThreadsStats;
+    memset(threads_stats, 0, sizeof(Software_ThreadStats) * threads_count);
+    {
+      std::lock_guard<std::mutex> lock(pool->Mutex);
+      pool->Target = &target;
+      pool->NextTile = &next_tile;
+      pool->ActiveCount = threads_count;
+      pool->PendingCount = threads_count - 1;
+      pool->Generation++;
+    }
+    pool->WorkCond.notify_all();
+  }
+  Software_RasterizeTiles(bd, &target, &next_tile, &threads_stats[0]);
+  if (pool) {
+    std::unique_lock<std::mutex> lock(pool->Mutex);
+    pool->DoneCond.wait(lock, [&] { return pool->PendingCount == 0; });
+  }
+  const auto time_end = std::chrono::steady_clock::now();
+
+  stats.ThreadsCount = threads_count;
+  stats.TilesCount = tiles_count;
+  for (int thread_n = 0; thread_n < threads_count; thread_n++) {
+    stats.PixelsTested += threads_stats[thread_n].PixelsTested;
+    stats.PixelsWritten += threads_stats[thread_n].PixelsWritten;
+  }
+  stats.SetupTimeMs =
+      std::chrono::duration<double, std::milli>(time_setup - time_start)
+          .count();
+  stats.RasterTimeMs =
+      std::chrono::duration<double, std::milli>(time_end - time_setup).count();
+  stats.FillRate = (stats.RasterTimeMs > 0.0)
+                       ? (double)stats.PixelsWritten * 1000.0 /
+                             stats.RasterTimeMs
+                       : 0.0;
+}
+
+bool Software_CreateFontsTexture() {
+  // Build texture atlas
+  IO &io = Gui::GetIO();
+  Software_Data *bd = Software_GetBackendData();
+  unsigned char *pixels;
+  int width, height;
+  io.Fonts->GetTexDataAsRGBA32(&pixels, &width,
+                               &height); // Used directly as our texture
+
+  bd->FontTexture.Pixels = (const unsigned int *)pixels;
+  bd->FontTexture.Width = width;
+  bd->FontTexture.Height = height;
+
+  // Store our identifier
+  io.Fonts->SetTexID((TextureID)&bd->FontTexture);
+
+  return true;
+}
+
+void Software_DestroyFontsTexture() {
+  IO &io = Gui::GetIO();
+  Software_Data *bd = Software_GetBackendData();
+  if (bd->FontTexture.Pixels) {
+    io.Fonts->SetTexID(0);
+    memset(&bd->FontTexture, 0, sizeof(bd->FontTexture));
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+#endif // #ifndef DISABLE
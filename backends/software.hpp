@@ -0,0 +1,59 @@
+// gui: Renderer Backend for CPU rendering (software rasterizer)
+// This needs to be used along with a Platform Backend (e.g. GLFW, SDL, Win32,
+// custom..), or without any for headless rendering (e.g. screenshots,
+// golden-image tests, backend-agnostic benchmarks on machines without a GPU).
+// Renders into a 32-bit framebuffer that you own, in the same format as
+// COL32() colors (RGBA bytes unless USE_BGRA_PACKED_COLOR is defined).
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'Software_Texture*' as TextureID.
+//  Read the FAQ about TextureID! [X] Renderer: Large meshes support (64k+
+//  vertices) with 16-bit indices. [X] Renderer: Tile-based multi-threaded
+//  rasterization, with SSE2 inner loops when available. [X] Renderer:
+//  Fill-rate statistics, see Software_GetStats().
+//  [X] Renderer: Compact vertex format (USE_DRAWVERT_COMPACT in config.hpp).
+// Missing features:
+//  [ ] Renderer: Multi-viewport support (multiple windows).
+//  [ ] Renderer: Bilinear filtering. Textures are point-sampled, which matches
+//  bilinear sampling for text and baked lines drawn at 1:1 scale.
+
+#pragma once
+#include "../gui.hpp" // API
+#ifndef DISABLE
+
+// Texture readable by the software renderer. Pixels are in COL32() format,
+// like the output of FontAtlas::GetTexDataAsRGBA32().
+struct Software_Texture {
+  const unsigned int *Pixels;
+  int Width;
+  int Height;
+};
+
+// Statistics of the last Software_RenderDrawData() call
+struct Software_Stats {
+  int ThreadsCount;
+  int TilesCount;              // Number of horizontal bands of pixels
+  int TrianglesCount;          // Triangles submitted
+  int TrianglesRasterized;     // Triangles left after scissor/zero-area culling
+  long long PixelsTested;      // Pixels tested against triangle edges
+  long long PixelsWritten;     // Pixels blended into the framebuffer
+  double SetupTimeMs;          // Transform, triangle setup and binning
+  double RasterTimeMs;         // Rasterization of all tiles
+  double FillRate;             // Pixels written per second of rasterization
+};
+
+API bool Software_Init(int threads_count = 0); // 0: use all cores
+API void Software_Shutdown();
+API void Software_NewFrame();
+API void Software_RenderDrawData(DrawData *draw_data, unsigned int *pixels,
+                                 int width, int height,
+                                 int pitch); // 'pitch' is in bytes
+API const Software_Stats &Software_GetStats();
+
+// Called by Init/NewFrame/Shutdown
+// The font atlas pixels are read directly from io.Fonts: don't call
+// io.Fonts->ClearTexData() while this backend is in use.
+API bool Software_CreateFontsTexture();
+API void Software_DestroyFontsTexture();
+
+#endif // #ifndef DISABLE
@@ -7,6 +7,14 @@
 //  [X] Renderer: Large meshes support (64k+ vertices) with 16-bit indices.
 //  [x] Renderer: Multi-viewport / platform windows. With issues (flickering
 //  when creating a new viewport).
+//  [X] Renderer: Parallel recording of platform windows (see
+//  PlatformIO::ParallelFor) and batched presents.
+//  [X] Renderer: Compact vertex format (USE_DRAWVERT_COMPACT in config.hpp).
+//  [X] Renderer: Signed distance shapes (USE_DRAWVERT_SDF in config.hpp, needs
+//  the shaders built by backends/vulkan/generate_spv.sh).
+//  [X] Renderer: Persistent pipeline cache (see PipelineCacheFilename).
+//  [X] Renderer: Bindless textures (see UseBindlessTextures, needs the
+//  shaders built by backends/vulkan/generate_spv.sh).
 
 // Important: on 32-bit systems, user texture binding is only supported if your
 // imconfig file has '#define TextureID unsigned long long'. This is because we
@@ -34,10 +42,16 @@
 //   by your own engine/app code.
 // Read comments in vulkan.hpp.
 
+#if defined(_MSC_VER) && !defined(_CRT_SECURE_NO_WARNINGS)
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
 #include "vulkan.hpp"
 #include "gui.hpp"
 #ifndef DISABLE
+#include <mutex>
 #include <stdio.h>
+#include <string.h>
 #ifndef MAX
 #define MAX(A, B) (((A) >= (B)) ? (A) : (B))
 #endif
@@ -73,6 +87,9 @@ void Vulkan_CreateWindowCommandBuffers(VkPhysicalDevice physical_device,
                                        unsigned int queue_family,
                                        const VkAllocationCallbacks *allocator);
 
+// Serialize vkQueueSubmit() calls from Vulkan_RenderWindow()
+static std::mutex g_QueueMutex;
+
 // Vulkan prototypes for use with custom loaders
 // (see description of VULKAN_NO_PROTOTYPES in vulkan.hpp
 #ifdef VK_NO_PROTOTYPES
@@ -103,12 +120,14 @@ static bool g_FunctionsLoaded = true;
   VULKAN_FUNC_MAP_MACRO(vkCmdSetViewport)                                      \
   VULKAN_FUNC_MAP_MACRO(vkCreateBuffer)                                        \
   VULKAN_FUNC_MAP_MACRO(vkCreateCommandPool)                                   \
+  VULKAN_FUNC_MAP_MACRO(vkCreateDescriptorPool)                                \
   VULKAN_FUNC_MAP_MACRO(vkCreateDescriptorSetLayout)                           \
   VULKAN_FUNC_MAP_MACRO(vkCreateFence)                                         \
   VULKAN_FUNC_MAP_MACRO(vkCreateFramebuffer)                                   \
   VULKAN_FUNC_MAP_MACRO(vkCreateGraphicsPipelines)                             \
   VULKAN_FUNC_MAP_MACRO(vkCreateImage)                                         \
   VULKAN_FUNC_MAP_MACRO(vkCreateImageView)                                     \
+  VULKAN_FUNC_MAP_MACRO(vkCreatePipelineCache)                                 \
   VULKAN_FUNC_MAP_MACRO(vkCreatePipelineLayout)                                \
   VULKAN_FUNC_MAP_MACRO(vkCreateRenderPass)                                    \
   VULKAN_FUNC_MAP_MACRO(vkCreateSampler)                                       \
@@ -117,12 +136,14 @@ static bool g_FunctionsLoaded = true;
   VULKAN_FUNC_MAP_MACRO(vkCreateSwapchainKHR)                                  \
   VULKAN_FUNC_MAP_MACRO(vkDestroyBuffer)                                       \
   VULKAN_FUNC_MAP_MACRO(vkDestroyCommandPool)                                  \
+  VULKAN_FUNC_MAP_MACRO(vkDestroyDescriptorPool)                               \
   VULKAN_FUNC_MAP_MACRO(vkDestroyDescriptorSetLayout)                          \
   VULKAN_FUNC_MAP_MACRO(vkDestroyFence)                                        \
   VULKAN_FUNC_MAP_MACRO(vkDestroyFramebuffer)                                  \
   VULKAN_FUNC_MAP_MACRO(vkDestroyImage)                                        \
   VULKAN_FUNC_MAP_MACRO(vkDestroyImageView)                                    \
   VULKAN_FUNC_MAP_MACRO(vkDestroyPipeline)                                     \
+  VULKAN_FUNC_MAP_MACRO(vkDestroyPipelineCache)                                \
   VULKAN_FUNC_MAP_MACRO(vkDestroyPipelineLayout)                               \
   VULKAN_FUNC_MAP_MACRO(vkDestroyRenderPass)                                   \
   VULKAN_FUNC_MAP_MACRO(vkDestroySampler)                                      \
@@ -137,12 +158,15 @@ static bool g_FunctionsLoaded = true;
   VULKAN_FUNC_MAP_MACRO(vkFreeDescriptorSets)                                  \
   VULKAN_FUNC_MAP_MACRO(vkFreeMemory)                                          \
   VULKAN_FUNC_MAP_MACRO(vkGetBufferMemoryRequirements)                         \
+  VULKAN_FUNC_MAP_MACRO(vkGetFenceStatus)                                      \
   VULKAN_FUNC_MAP_MACRO(vkGetImageMemoryRequirements)                          \
   VULKAN_FUNC_MAP_MACRO(vkGetPhysicalDeviceMemoryProperties)                   \
+  VULKAN_FUNC_MAP_MACRO(vkGetPhysicalDeviceProperties)                         \
   VULKAN_FUNC_MAP_MACRO(vkGetPhysicalDeviceSurfaceCapabilitiesKHR)             \
   VULKAN_FUNC_MAP_MACRO(vkGetPhysicalDeviceSurfaceFormatsKHR)                  \
   VULKAN_FUNC_MAP_MACRO(vkGetPhysicalDeviceSurfacePresentModesKHR)             \
   VULKAN_FUNC_MAP_MACRO(vkGetPhysicalDeviceSurfaceSupportKHR)                  \
+  VULKAN_FUNC_MAP_MACRO(vkGetPipelineCacheData)                                \
   VULKAN_FUNC_MAP_MACRO(vkGetSwapchainImagesKHR)                               \
   VULKAN_FUNC_MAP_MACRO(vkMapMemory)                                           \
   VULKAN_FUNC_MAP_MACRO(vkQueuePresentKHR)                                     \
@@ -166,6 +190,34 @@ static PFN_vkCmdBeginRenderingKHR VulkanFuncs_vkCmdBeginRenderingKHR;
 static PFN_vkCmdEndRenderingKHR VulkanFuncs_vkCmdEndRenderingKHR;
 #endif
 
+// Signed distance shapes need the SPIR-V generated from
+// backends/vulkan/glsl_shader_sdf.vert/.frag by generate_spv.sh.
+// Without it, BackendFlags_RendererHasSdfShapes is not set and shapes are
+// tessellated as usual.
+#if defined(USE_DRAWVERT_SDF) && defined(__has_include)
+#if __has_include("vulkan/glsl_shader_sdf.vert.u32") &&                        \
+    __has_include("vulkan/glsl_shader_sdf.frag.u32")
+#define VULKAN_HAS_SDF
+#endif
+#endif
+
+// Bindless textures need Vulkan 1.2 headers (which also define
+// VK_EXT_descriptor_indexing) and the SPIR-V generated from
+// backends/vulkan/glsl_shader[_sdf]_bindless.vert/.frag by generate_spv.sh.
+#if defined(VK_EXT_descriptor_indexing) && defined(__has_include)
+#ifdef VULKAN_HAS_SDF
+#if __has_include("vulkan/glsl_shader_sdf_bindless.vert.u32") &&               \
+    __has_include("vulkan/glsl_shader_sdf_bindless.frag.u32")
+#define VULKAN_HAS_BINDLESS
+#endif
+#else
+#if __has_include("vulkan/glsl_shader_bindless.vert.u32") &&                   \
+    __has_include("vulkan/glsl_shader_bindless.frag.u32")
+#define VULKAN_HAS_BINDLESS
+#endif
+#endif
+#endif
+
 // Reusable buffers used for rendering 1 current in-flight frame, for
 // Vulkan_RenderDrawData() [Please zero-clear before use!]
 struct Vulkan_FrameRenderBuffers {
@@ -175,6 +227,9 @@ struct Vulkan_FrameRenderBuffers {
   VkDeviceSize IndexBufferSize;
   VkBuffer VertexBuffer;
   VkBuffer IndexBuffer;
+  VkDeviceMemory TexIndexBufferMemory; // Vulkan_InitInfo::UseBindlessTextures
+  VkDeviceSize TexIndexBufferSize;
+  VkBuffer TexIndexBuffer;
 };
 
 // Each viewport will hold 1 Vulkan_WindowRenderBuffers
@@ -200,6 +255,30 @@ struct Vulkan_ViewportData {
   ~Vulkan_ViewportData() {}
 };
 
+// Font texture replaced by Vulkan_CreateFontsTexture(), destroyed once the
+// frames which may use it completed.
+struct Vulkan_RetiredFontTexture {
+  VkDescriptorSet DescriptorSet;
+  VkImageView View;
+  VkImage Image;
+  VkDeviceMemory Memory;
+  unsigned int FrameIndex; // Vulkan_Data::FrameIndex when it was replaced
+};
+
+// Slot of a texture registered by Vulkan_AddTexture() in the bindless textures
+// array.
+struct Vulkan_BindlessTexture {
+  VkDescriptorSet DescriptorSet;
+  unsigned int Index;
+};
+
+// Slot freed by Vulkan_RemoveTexture(), reused once the frames which may
+// sample it completed.
+struct Vulkan_RetiredBindlessIndex {
+  unsigned int Index;
+  unsigned int FrameIndex; // Vulkan_Data::FrameIndex when it was freed
+};
+
 // Vulkan data
 struct Vulkan_Data {
   Vulkan_InitInfo VulkanInitInfo;
@@ -221,10 +300,34 @@ struct Vulkan_Data {
   VkDescriptorSet FontDescriptorSet;
   VkCommandPool FontCommandPool;
   VkCommandBuffer FontCommandBuffer;
+  VkFence FontUploadFence; // Signaled when the upload below completed
+  VkBuffer FontUploadBuffer;
+  VkDeviceMemory FontUploadBufferMemory;
+  Vector<Vulkan_RetiredFontTexture> RetiredFontTextures;
+  unsigned int FrameIndex; // Incremented by Vulkan_NewFrame()
+
+  // Pipeline cache created from Vulkan_InitInfo::PipelineCacheFilename
+  VkPipelineCache OwnedPipelineCache;
+  size_t OwnedPipelineCacheSavedSize;
+
+  // Bindless textures (Vulkan_InitInfo::UseBindlessTextures)
+  VkDescriptorSetLayout BindlessSetLayout;
+  VkDescriptorPool BindlessDescriptorPool;
+  VkDescriptorSet BindlessDescriptorSet;
+  Vector<Vulkan_BindlessTexture> BindlessTextures; // Sorted by DescriptorSet
+  Vector<unsigned int> BindlessFreeIndices;
+  Vector<Vulkan_RetiredBindlessIndex> BindlessRetiredIndices;
+  unsigned int BindlessNextIndex;
 
   // Render buffers for main window
   Vulkan_WindowRenderBuffers MainWindowRenderBuffers;
 
+  // Secondary viewports presented together by Vulkan_SwapBuffersBatch()
+  Vector<VkSwapchainKHR> PresentSwapchains;
+  Vector<VkSemaphore> PresentWaitSemaphores;
+  Vector<unsigned int> PresentImageIndices;
+  Vector<VkResult> PresentResults;
+
   Vulkan_Data() {
     memset((void *)this, 0, sizeof(*this));
     BufferMemoryAlignment = 256;
@@ -362,6 +465,54 @@ static unsigned int __glsl_shader_frag_spv[] = {
     0x00000012, 0x0000001c, 0x0003003e, 0x00000009, 0x0000001d, 0x000100fd,
     0x00010038};
 
+#ifdef VULKAN_HAS_SDF
+// backends/vulkan/glsl_shader_sdf.vert, compiled with:
+// # glslangValidator -V -x -o glsl_shader_sdf.vert.u32 glsl_shader_sdf.vert
+static unsigned int __glsl_shader_sdf_vert_spv[] = {
+#include "vulkan/glsl_shader_sdf.vert.u32"
+};
+
+// backends/vulkan/glsl_shader_sdf.frag, compiled with:
+// # glslangValidator -V -x -o glsl_shader_sdf.frag.u32 glsl_shader_sdf.frag
+static unsigned int __glsl_shader_sdf_frag_spv[] = {
+#include "vulkan/glsl_shader_sdf.frag.u32"
+};
+#endif // #ifdef VULKAN_HAS_SDF
+
+#ifdef VULKAN_HAS_BINDLESS
+// Shaders used with Vulkan_InitInfo::UseBindlessTextures: same as above, with
+// the texture selected per vertex in an array of textures.
+#ifdef VULKAN_HAS_SDF
+// backends/vulkan/glsl_shader_sdf_bindless.vert, compiled with:
+// # glslangValidator -V -x -o glsl_shader_sdf_bindless.vert.u32
+//   glsl_shader_sdf_bindless.vert
+static unsigned int __glsl_shader_sdf_bindless_vert_spv[] = {
+#include "vulkan/glsl_shader_sdf_bindless.vert.u32"
+};
+
+// backends/vulkan/glsl_shader_sdf_bindless.frag, compiled with:
+// # glslangValidator -V -x -o glsl_shader_sdf_bindless.frag.u32
+//   glsl_shader_sdf_bindless.frag
+static unsigned int __glsl_shader_sdf_bindless_frag_spv[] = {
+#include "vulkan/glsl_shader_sdf_bindless.frag.u32"
+};
+#else
+// backends/vulkan/glsl_shader_bindless.vert, compiled with:
+// # glslangValidator -V -x -o glsl_shader_bindless.vert.u32
+//   glsl_shader_bindless.vert
+static unsigned int __glsl_shader_bindless_vert_spv[] = {
+#include "vulkan/glsl_shader_bindless.vert.u32"
+};
+
+// backends/vulkan/glsl_shader_bindless.frag, compiled with:
+// # glslangValidator -V -x -o glsl_shader_bindless.frag.u32
+//   glsl_shader_bindless.frag
+static unsigned int __glsl_shader_bindless_frag_spv[] = {
+#include "vulkan/glsl_shader_bindless.frag.u32"
+};
+#endif // #ifdef VULKAN_HAS_SDF
+#endif // #ifdef VULKAN_HAS_BINDLESS
+
 //-----------------------------------------------------------------------------
 // FUNCTIONS
 //-----------------------------------------------------------------------------
@@ -423,11 +574,10 @@ static void CreateOrResizeBuffer(VkBuffer &buffer,
   err = vkCreateBuffer(v->Device, &buffer_info, v->Allocator, &buffer);
   check_vk_result(err);
 
+  // BufferMemoryAlignment is only read here: this may run concurrently for
+  // secondary viewports (see Vulkan_CreateDeviceObjects()).
   VkMemoryRequirements req;
   vkGetBufferMemoryRequirements(v->Device, buffer, &req);
-  bd->BufferMemoryAlignment = (bd->BufferMemoryAlignment > req.alignment)
-                                  ? bd->BufferMemoryAlignment
-                                  : req.alignment;
   VkDeviceSize size = MAX(v->MinAllocationSize, req.size);
   VkMemoryAllocateInfo alloc_info = {};
   alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
@@ -442,6 +592,39 @@ static void CreateOrResizeBuffer(VkBuffer &buffer,
   p_buffer_size = size;
 }
 
+#ifdef VULKAN_HAS_BINDLESS
+// Binary search in the sorted Vulkan_Data::BindlessTextures: returns the
+// entry of 'descriptor_set', or where it would be inserted.
+static Vulkan_BindlessTexture *
+Vulkan_FindBindlessTexture(VkDescriptorSet descriptor_set) {
+  Vulkan_Data *bd = Vulkan_GetBackendData();
+  Vulkan_BindlessTexture *first = bd->BindlessTextures.begin();
+  int count = bd->BindlessTextures.Size;
+  while (count > 0) {
+    const int step = count / 2;
+    if (first[step].DescriptorSet < descriptor_set) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  return first;
+}
+
+// Slot of a TextureID in the bindless textures array.
+static unsigned int Vulkan_GetBindlessTextureIndex(TextureID tex_id) {
+  VkDescriptorSet descriptor_set = (VkDescriptorSet)tex_id;
+  Vulkan_BindlessTexture *tex = Vulkan_FindBindlessTexture(descriptor_set);
+  Vulkan_Data *bd = Vulkan_GetBackendData();
+  if (tex != bd->BindlessTextures.end() &&
+      tex->DescriptorSet == descriptor_set)
+    return tex->Index;
+  assert(0 && "TextureID was not created with Vulkan_AddTexture()!");
+  return 0;
+}
+#endif
+
 static void Vulkan_SetupRenderState(DrawData *draw_data, VkPipeline pipeline,
                                     VkCommandBuffer command_buffer,
                                     Vulkan_FrameRenderBuffers *rb, int fb_width,
@@ -464,6 +647,21 @@ static void Vulkan_SetupRenderState(DrawData *draw_data, VkPipeline pipeline,
                                               : VK_INDEX_TYPE_UINT32);
   }
 
+#ifdef VULKAN_HAS_BINDLESS
+  // Bind the texture indices and the array of all textures, used by every
+  // draw command:
+  if (bd->VulkanInitInfo.UseBindlessTextures) {
+    if (draw_data->TotalVtxCount > 0) {
+      VkDeviceSize tex_index_offset[1] = {0};
+      vkCmdBindVertexBuffers(command_buffer, 1, 1, &rb->TexIndexBuffer,
+                             tex_index_offset);
+    }
+    vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            bd->PipelineLayout, 0, 1,
+                            &bd->BindlessDescriptorSet, 0, nullptr);
+  }
+#endif
+
   // Setup viewport:
   {
     VkViewport viewport;
@@ -496,6 +694,32 @@ static void Vulkan_SetupRenderState(DrawData *draw_data, VkPipeline pipeline,
   }
 }
 
+#ifdef USE_DRAWVERT_COMPACT
+// Compact vertex positions are fixed point (fetched as SNORM, so divided by
+// 32767) and relative to DrawList::VtxOrigin: fold their decoding into the
+// scale and translation, so the shaders are the same for both vertex formats.
+static void Vulkan_SetupVtxOrigin(DrawData *draw_data,
+                                  VkCommandBuffer command_buffer,
+                                  const DrawList *cmd_list) {
+  Vulkan_Data *bd = Vulkan_GetBackendData();
+  const float pos_scale = 32767.0f / DRAWVERT_POS_SCALE;
+  float scale_translate[4];
+  scale_translate[0] = 2.0f / draw_data->DisplaySize.x;
+  scale_translate[1] = 2.0f / draw_data->DisplaySize.y;
+  scale_translate[2] =
+      -1.0f + (cmd_list->VtxOrigin.x - draw_data->DisplayPos.x) *
+                  scale_translate[0];
+  scale_translate[3] =
+      -1.0f + (cmd_list->VtxOrigin.y - draw_data->DisplayPos.y) *
+                  scale_translate[1];
+  scale_translate[0] *= pos_scale;
+  scale_translate[1] *= pos_scale;
+  vkCmdPushConstants(command_buffer, bd->PipelineLayout,
+                     VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(scale_translate),
+                     scale_translate);
+}
+#endif
+
 // Render function
 void Vulkan_RenderDrawData(DrawData *draw_data, VkCommandBuffer command_buffer,
                            VkPipeline pipeline) {
@@ -574,6 +798,58 @@ void Vulkan_RenderDrawData(DrawData *draw_data, VkCommandBuffer command_buffer,
     check_vk_result(err);
     vkUnmapMemory(v->Device, rb->VertexBufferMemory);
     vkUnmapMemory(v->Device, rb->IndexBufferMemory);
+
+#ifdef VULKAN_HAS_BINDLESS
+    // Upload the texture index of each vertex, as a second vertex stream
+    // parallel to the vertex buffer. Draw commands only differing by their
+    // texture can then be merged below.
+    if (v->UseBindlessTextures) {
+      size_t tex_index_size = draw_data->TotalVtxCount * sizeof(unsigned int);
+      if (rb->TexIndexBuffer == VK_NULL_HANDLE ||
+          rb->TexIndexBufferSize < tex_index_size)
+        CreateOrResizeBuffer(rb->TexIndexBuffer, rb->TexIndexBufferMemory,
+                             rb->TexIndexBufferSize, tex_index_size,
+                             VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+      unsigned int *tex_index_dst = nullptr;
+      err = vkMapMemory(v->Device, rb->TexIndexBufferMemory, 0,
+                        rb->TexIndexBufferSize, 0, (void **)&tex_index_dst);
+      check_vk_result(err);
+      TextureID last_tex_id = TextureID();
+      unsigned int tex_index = 0;
+      bool tex_index_valid = false;
+      for (int n = 0; n < draw_data->CmdListsCount; n++) {
+        const DrawList *cmd_list = draw_data->CmdLists[n];
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++) {
+          const DrawCmd *pcmd = &cmd_list->CmdBuffer[cmd_i];
+          if (pcmd->UserCallback != nullptr)
+            continue;
+          if (!tex_index_valid || pcmd->TextureId != last_tex_id) {
+            last_tex_id = pcmd->TextureId;
+            tex_index_valid = true;
+            if (sizeof(TextureID) < sizeof(unsigned long long)) {
+              // See the same check in the draw loop below.
+              assert(pcmd->TextureId == (TextureID)bd->FontDescriptorSet);
+              tex_index = Vulkan_GetBindlessTextureIndex(
+                  (TextureID)bd->FontDescriptorSet);
+            } else
+              tex_index = Vulkan_GetBindlessTextureIndex(pcmd->TextureId);
+          }
+          const DrawIdx *idx = cmd_list->IdxBuffer.Data + pcmd->IdxOffset;
+          unsigned int *dst = tex_index_dst + pcmd->VtxOffset;
+          for (unsigned int i = 0; i < pcmd->ElemCount; i++)
+            dst[idx[i]] = tex_index;
+        }
+        tex_index_dst += cmd_list->VtxBuffer.Size;
+      }
+      VkMappedMemoryRange tex_index_range = {};
+      tex_index_range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+      tex_index_range.memory = rb->TexIndexBufferMemory;
+      tex_index_range.size = VK_WHOLE_SIZE;
+      err = vkFlushMappedMemoryRanges(v->Device, 1, &tex_index_range);
+      check_vk_result(err);
+      vkUnmapMemory(v->Device, rb->TexIndexBufferMemory);
+    }
+#endif
   }
 
   // Setup desired Vulkan state
@@ -593,18 +869,44 @@ void Vulkan_RenderDrawData(DrawData *draw_data, VkCommandBuffer command_buffer,
   int global_idx_offset = 0;
   for (int n = 0; n < draw_data->CmdListsCount; n++) {
     const DrawList *cmd_list = draw_data->CmdLists[n];
+#ifdef USE_DRAWVERT_COMPACT
+    Vulkan_SetupVtxOrigin(draw_data, command_buffer, cmd_list);
+#endif
     for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++) {
       const DrawCmd *pcmd = &cmd_list->CmdBuffer[cmd_i];
       if (pcmd->UserCallback != nullptr) {
         // User callback, registered via DrawList::AddCallback()
         // (DrawCallback_ResetRenderState is a special callback value used by
         // the user to request the renderer to reset render state.)
-        if (pcmd->UserCallback == DrawCallback_ResetRenderState)
+        if (pcmd->UserCallback == DrawCallback_ResetRenderState) {
           Vulkan_SetupRenderState(draw_data, pipeline, command_buffer, rb,
                                   fb_width, fb_height);
-        else
+#ifdef USE_DRAWVERT_COMPACT
+          Vulkan_SetupVtxOrigin(draw_data, command_buffer, cmd_list);
+#endif
+        } else
           pcmd->UserCallback(cmd_list, pcmd);
       } else {
+        unsigned int elem_count = pcmd->ElemCount;
+#ifdef VULKAN_HAS_BINDLESS
+        // Textures are selected per vertex: merge the following commands
+        // which only differ by their texture into a single draw.
+        if (v->UseBindlessTextures)
+          while (cmd_i + 1 < cmd_list->CmdBuffer.Size) {
+            const DrawCmd *next_cmd = &cmd_list->CmdBuffer[cmd_i + 1];
+            if (next_cmd->UserCallback != nullptr ||
+                next_cmd->VtxOffset != pcmd->VtxOffset ||
+                next_cmd->IdxOffset != pcmd->IdxOffset + elem_count ||
+                next_cmd->ClipRect.x != pcmd->ClipRect.x ||
+                next_cmd->ClipRect.y != pcmd->ClipRect.y ||
+                next_cmd->ClipRect.z != pcmd->ClipRect.z ||
+                next_cmd->ClipRect.w != pcmd->ClipRect.w)
+              break;
+            elem_count += next_cmd->ElemCount;
+            cmd_i++;
+          }
+#endif
+
         // Project scissor/clipping rectangles into framebuffer space
         Vec2 clip_min((pcmd->ClipRect.x - clip_off.x) * clip_scale.x,
                       (pcmd->ClipRect.y - clip_off.y) * clip_scale.y);
@@ -637,19 +939,24 @@ void Vulkan_RenderDrawData(DrawData *draw_data, VkCommandBuffer command_buffer,
         vkCmdSetScissor(command_buffer, 0, 1, &scissor);
 
         // Bind DescriptorSet with font or user texture
-        VkDescriptorSet desc_set[1] = {(VkDescriptorSet)pcmd->TextureId};
-        if (sizeof(TextureID) < sizeof(unsigned long long)) {
-          // We don't support texture switches if TextureID hasn't been
-          // redefined to be 64-bit. Do a flaky check that other textures
-          // haven't been used.
-          assert(pcmd->TextureId == (TextureID)bd->FontDescriptorSet);
-          desc_set[0] = bd->FontDescriptorSet;
+        // (in bindless mode, the array of all textures is already bound)
+        if (!v->UseBindlessTextures) {
+          VkDescriptorSet desc_set[1] = {(VkDescriptorSet)pcmd->TextureId};
+          if (sizeof(TextureID) < sizeof(unsigned long long)) {
+            // We don't support texture switches if TextureID hasn't been
+            // redefined to be 64-bit. Do a flaky check that other textures
+            // haven't been used.
+            assert(pcmd->TextureId == (TextureID)bd->FontDescriptorSet);
+            desc_set[0] = bd->FontDescriptorSet;
+          }
+          vkCmdBindDescriptorSets(command_buffer,
+                                  VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                  bd->PipelineLayout, 0, 1, desc_set, 0,
+                                  nullptr);
         }
-        vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                bd->PipelineLayout, 0, 1, desc_set, 0, nullptr);
 
         // Draw
-        vkCmdDrawIndexed(command_buffer, pcmd->ElemCount, 1,
+        vkCmdDrawIndexed(command_buffer, elem_count, 1,
                          pcmd->IdxOffset + global_idx_offset,
                          pcmd->VtxOffset + global_vtx_offset, 0);
       }
@@ -674,19 +981,102 @@ void Vulkan_RenderDrawData(DrawData *draw_data, VkCommandBuffer command_buffer,
   vkCmdSetScissor(command_buffer, 0, 1, &scissor);
 }
 
+// Destroy the staging buffer of the last font upload once the GPU is done with
+// it. Return false if 'wait' is false and the upload is still in flight.
+static bool Vulkan_DestroyFontUploadBuffer(bool wait) {
+  Vulkan_Data *bd = Vulkan_GetBackendData();
+  Vulkan_InitInfo *v = &bd->VulkanInitInfo;
+  if (bd->FontUploadBuffer == VK_NULL_HANDLE)
+    return true;
+  VkResult err =
+      wait ? vkWaitForFences(v->Device, 1, &bd->FontUploadFence, VK_TRUE,
+                             UINT64_MAX)
+           : vkGetFenceStatus(v->Device, bd->FontUploadFence);
+  if (err == VK_NOT_READY || err == VK_TIMEOUT)
+    return false;
+  check_vk_result(err);
+  vkDestroyBuffer(v->Device, bd->FontUploadBuffer, v->Allocator);
+  vkFreeMemory(v->Device, bd->FontUploadBufferMemory, v->Allocator);
+  bd->FontUploadBuffer = VK_NULL_HANDLE;
+  bd->FontUploadBufferMemory = VK_NULL_HANDLE;
+  return true;
+}
+
+// Destroy the font textures replaced by Vulkan_CreateFontsTexture(), once no
+// frame in flight may use them. Like the render buffers reused by
+// Vulkan_RenderDrawData(), this assumes there are no more than ImageCount
+// frames in flight.
+static void Vulkan_DestroyRetiredFontTextures(bool all) {
+  Vulkan_Data *bd = Vulkan_GetBackendData();
+  Vulkan_InitInfo *v = &bd->VulkanInitInfo;
+  for (int n = 0; n < bd->RetiredFontTextures.Size;) {
+    Vulkan_RetiredFontTexture *tex = &bd->RetiredFontTextures[n];
+    if (!all && bd->FrameIndex - tex->FrameIndex <= v->ImageCount) {
+      n++;
+      continue;
+    }
+    if (tex->DescriptorSet)
+      Vulkan_RemoveTexture(tex->DescriptorSet);
+    if (tex->View)
+      vkDestroyImageView(v->Device, tex->View, v->Allocator);
+    if (tex->Image)
+      vkDestroyImage(v->Device, tex->Image, v->Allocator);
+    if (tex->Memory)
+      vkFreeMemory(v->Device, tex->Memory, v->Allocator);
+    bd->RetiredFontTextures.erase(tex);
+  }
+}
+
+#ifdef VULKAN_HAS_BINDLESS
+// Make the bindless slots freed by Vulkan_RemoveTexture() available again once
+// no frame in flight may sample them: their descriptor can't be rewritten
+// while pending command buffers use it (UPDATE_UNUSED_WHILE_PENDING). Same
+// assumption of no more than ImageCount frames in flight as above.
+static void Vulkan_ReleaseRetiredBindlessIndices() {
+  Vulkan_Data *bd = Vulkan_GetBackendData();
+  Vulkan_InitInfo *v = &bd->VulkanInitInfo;
+  for (int n = 0; n < bd->BindlessRetiredIndices.Size;) {
+    Vulkan_RetiredBindlessIndex *retired = &bd->BindlessRetiredIndices[n];
+    if (bd->FrameIndex - retired->FrameIndex <= v->ImageCount) {
+      n++;
+      continue;
+    }
+    bd->BindlessFreeIndices.push_back(retired->Index);
+    bd->BindlessRetiredIndices.erase(retired);
+  }
+}
+#endif
+
+// The upload is submitted to the queue without waiting for it: commands
+// submitted later to the same queue are ordered after it by the final image
+// barrier. The staging buffer is released by Vulkan_NewFrame() once the upload
+// fence is signaled. On atlas rebuilds, the previous texture is destroyed once
+// the frames which may use it completed.
 bool Vulkan_CreateFontsTexture() {
   IO &io = Gui::GetIO();
   Vulkan_Data *bd = Vulkan_GetBackendData();
   Vulkan_InitInfo *v = &bd->VulkanInitInfo;
   VkResult err;
 
-  // Destroy existing texture (if any)
+  // Retire existing texture (if any)
   if (bd->FontView || bd->FontImage || bd->FontMemory ||
       bd->FontDescriptorSet) {
-    vkQueueWaitIdle(v->Queue);
-    Vulkan_DestroyFontsTexture();
+    Vulkan_RetiredFontTexture tex;
+    tex.DescriptorSet = bd->FontDescriptorSet;
+    tex.View = bd->FontView;
+    tex.Image = bd->FontImage;
+    tex.Memory = bd->FontMemory;
+    tex.FrameIndex = bd->FrameIndex;
+    bd->RetiredFontTextures.push_back(tex);
+    bd->FontDescriptorSet = VK_NULL_HANDLE;
+    bd->FontView = VK_NULL_HANDLE;
+    bd->FontImage = VK_NULL_HANDLE;
+    bd->FontMemory = VK_NULL_HANDLE;
   }
 
+  // Wait for the previous upload (if any) to reuse its command buffer
+  Vulkan_DestroyFontUploadBuffer(true);
+
   // Create command pool/buffer
   if (bd->FontCommandPool == VK_NULL_HANDLE) {
     VkCommandPoolCreateInfo info = {};
@@ -703,6 +1093,12 @@ bool Vulkan_CreateFontsTexture() {
     err = vkAllocateCommandBuffers(v->Device, &info, &bd->FontCommandBuffer);
     check_vk_result(err);
   }
+  if (bd->FontUploadFence == VK_NULL_HANDLE) {
+    VkFenceCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    err = vkCreateFence(v->Device, &info, v->Allocator, &bd->FontUploadFence);
+    check_vk_result(err);
+  }
 
   // Start command buffer
   {
@@ -771,47 +1167,44 @@ bool Vulkan_CreateFontsTexture() {
       bd->FontSampler, bd->FontView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 
   // Create the Upload Buffer:
-  VkDeviceMemory upload_buffer_memory;
-  VkBuffer upload_buffer;
   {
     VkBufferCreateInfo buffer_info = {};
     buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     buffer_info.size = upload_size;
     buffer_info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
     buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    err = vkCreateBuffer(v->Device, &buffer_info, v->Allocator, &upload_buffer);
+    err = vkCreateBuffer(v->Device, &buffer_info, v->Allocator,
+                         &bd->FontUploadBuffer);
     check_vk_result(err);
     VkMemoryRequirements req;
-    vkGetBufferMemoryRequirements(v->Device, upload_buffer, &req);
-    bd->BufferMemoryAlignment = (bd->BufferMemoryAlignment > req.alignment)
-                                    ? bd->BufferMemoryAlignment
-                                    : req.alignment;
+    vkGetBufferMemoryRequirements(v->Device, bd->FontUploadBuffer, &req);
     VkMemoryAllocateInfo alloc_info = {};
     alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
     alloc_info.allocationSize = MAX(v->MinAllocationSize, req.size);
     alloc_info.memoryTypeIndex = Vulkan_MemoryType(
         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, req.memoryTypeBits);
     err = vkAllocateMemory(v->Device, &alloc_info, v->Allocator,
-                           &upload_buffer_memory);
+                           &bd->FontUploadBufferMemory);
     check_vk_result(err);
-    err = vkBindBufferMemory(v->Device, upload_buffer, upload_buffer_memory, 0);
+    err = vkBindBufferMemory(v->Device, bd->FontUploadBuffer,
+                             bd->FontUploadBufferMemory, 0);
     check_vk_result(err);
   }
 
   // Upload to Buffer:
   {
     char *map = nullptr;
-    err = vkMapMemory(v->Device, upload_buffer_memory, 0, upload_size, 0,
+    err = vkMapMemory(v->Device, bd->FontUploadBufferMemory, 0, upload_size, 0,
                       (void **)(&map));
     check_vk_result(err);
     memcpy(map, pixels, upload_size);
     VkMappedMemoryRange range[1] = {};
     range[0].sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-    range[0].memory = upload_buffer_memory;
+    range[0].memory = bd->FontUploadBufferMemory;
     range[0].size = upload_size;
     err = vkFlushMappedMemoryRanges(v->Device, 1, range);
     check_vk_result(err);
-    vkUnmapMemory(v->Device, upload_buffer_memory);
+    vkUnmapMemory(v->Device, bd->FontUploadBufferMemory);
   }
 
   // Copy to Image:
@@ -837,8 +1230,9 @@ bool Vulkan_CreateFontsTexture() {
     region.imageExtent.width = width;
     region.imageExtent.height = height;
     region.imageExtent.depth = 1;
-    vkCmdCopyBufferToImage(bd->FontCommandBuffer, upload_buffer, bd->FontImage,
-                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    vkCmdCopyBufferToImage(bd->FontCommandBuffer, bd->FontUploadBuffer,
+                           bd->FontImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           1, &region);
 
     VkImageMemoryBarrier use_barrier[1] = {};
     use_barrier[0].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
@@ -867,15 +1261,11 @@ bool Vulkan_CreateFontsTexture() {
   end_info.pCommandBuffers = &bd->FontCommandBuffer;
   err = vkEndCommandBuffer(bd->FontCommandBuffer);
   check_vk_result(err);
-  err = vkQueueSubmit(v->Queue, 1, &end_info, VK_NULL_HANDLE);
+  err = vkResetFences(v->Device, 1, &bd->FontUploadFence);
   check_vk_result(err);
-
-  err = vkQueueWaitIdle(v->Queue);
+  err = vkQueueSubmit(v->Queue, 1, &end_info, bd->FontUploadFence);
   check_vk_result(err);
 
-  vkDestroyBuffer(v->Device, upload_buffer, v->Allocator);
-  vkFreeMemory(v->Device, upload_buffer_memory, v->Allocator);
-
   return true;
 }
 
@@ -886,6 +1276,7 @@ void Vulkan_DestroyFontsTexture() {
   Vulkan_Data *bd = Vulkan_GetBackendData();
   Vulkan_InitInfo *v = &bd->VulkanInitInfo;
 
+  Vulkan_DestroyFontUploadBuffer(true);
   if (bd->FontDescriptorSet) {
     Vulkan_RemoveTexture(bd->FontDescriptorSet);
     bd->FontDescriptorSet = VK_NULL_HANDLE;
@@ -913,8 +1304,24 @@ static void Vulkan_CreateShaderModules(VkDevice device,
   if (bd->ShaderModuleVert == VK_NULL_HANDLE) {
     VkShaderModuleCreateInfo vert_info = {};
     vert_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+#ifdef VULKAN_HAS_SDF
+    vert_info.codeSize = sizeof(__glsl_shader_sdf_vert_spv);
+    vert_info.pCode = (unsigned int *)__glsl_shader_sdf_vert_spv;
+#else
     vert_info.codeSize = sizeof(__glsl_shader_vert_spv);
     vert_info.pCode = (unsigned int *)__glsl_shader_vert_spv;
+#endif
+#ifdef VULKAN_HAS_BINDLESS
+    if (bd->VulkanInitInfo.UseBindlessTextures) {
+#ifdef VULKAN_HAS_SDF
+      vert_info.codeSize = sizeof(__glsl_shader_sdf_bindless_vert_spv);
+      vert_info.pCode = (unsigned int *)__glsl_shader_sdf_bindless_vert_spv;
+#else
+      vert_info.codeSize = sizeof(__glsl_shader_bindless_vert_spv);
+      vert_info.pCode = (unsigned int *)__glsl_shader_bindless_vert_spv;
+#endif
+    }
+#endif
     VkResult err = vkCreateShaderModule(device, &vert_info, allocator,
                                         &bd->ShaderModuleVert);
     check_vk_result(err);
@@ -922,8 +1329,24 @@ static void Vulkan_CreateShaderModules(VkDevice device,
   if (bd->ShaderModuleFrag == VK_NULL_HANDLE) {
     VkShaderModuleCreateInfo frag_info = {};
     frag_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+#ifdef VULKAN_HAS_SDF
+    frag_info.codeSize = sizeof(__glsl_shader_sdf_frag_spv);
+    frag_info.pCode = (unsigned int *)__glsl_shader_sdf_frag_spv;
+#else
     frag_info.codeSize = sizeof(__glsl_shader_frag_spv);
     frag_info.pCode = (unsigned int *)__glsl_shader_frag_spv;
+#endif
+#ifdef VULKAN_HAS_BINDLESS
+    if (bd->VulkanInitInfo.UseBindlessTextures) {
+#ifdef VULKAN_HAS_SDF
+      frag_info.codeSize = sizeof(__glsl_shader_sdf_bindless_frag_spv);
+      frag_info.pCode = (unsigned int *)__glsl_shader_sdf_bindless_frag_spv;
+#else
+      frag_info.codeSize = sizeof(__glsl_shader_bindless_frag_spv);
+      frag_info.pCode = (unsigned int *)__glsl_shader_bindless_frag_spv;
+#endif
+    }
+#endif
     VkResult err = vkCreateShaderModule(device, &frag_info, allocator,
                                         &bd->ShaderModuleFrag);
     check_vk_result(err);
@@ -949,29 +1372,58 @@ static void Vulkan_CreatePipeline(VkDevice device,
   stage[1].module = bd->ShaderModuleFrag;
   stage[1].pName = "main";
 
-  VkVertexInputBindingDescription binding_desc[1] = {};
+  VkVertexInputBindingDescription binding_desc[2] = {};
   binding_desc[0].stride = sizeof(DrawVert);
   binding_desc[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+  binding_desc[1].binding = 1; // Texture indices (bindless textures only)
+  binding_desc[1].stride = sizeof(unsigned int);
+  binding_desc[1].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
-  VkVertexInputAttributeDescription attribute_desc[3] = {};
+  // The last attribute is the texture index (bindless textures only)
+#ifdef VULKAN_HAS_SDF
+  VkVertexInputAttributeDescription attribute_desc[5] = {};
+#else
+  VkVertexInputAttributeDescription attribute_desc[4] = {};
+#endif
   attribute_desc[0].location = 0;
   attribute_desc[0].binding = binding_desc[0].binding;
+#ifdef USE_DRAWVERT_COMPACT
+  attribute_desc[0].format = VK_FORMAT_R16G16_SNORM;
+#else
   attribute_desc[0].format = VK_FORMAT_R32G32_SFLOAT;
+#endif
   attribute_desc[0].offset = offsetof(DrawVert, pos);
   attribute_desc[1].location = 1;
   attribute_desc[1].binding = binding_desc[0].binding;
+#ifdef USE_DRAWVERT_COMPACT
+  attribute_desc[1].format = VK_FORMAT_R16G16_UNORM;
+#else
   attribute_desc[1].format = VK_FORMAT_R32G32_SFLOAT;
+#endif
   attribute_desc[1].offset = offsetof(DrawVert, uv);
   attribute_desc[2].location = 2;
   attribute_desc[2].binding = binding_desc[0].binding;
   attribute_desc[2].format = VK_FORMAT_R8G8B8A8_UNORM;
   attribute_desc[2].offset = offsetof(DrawVert, col);
+#ifdef VULKAN_HAS_SDF
+  attribute_desc[3].location = 3;
+  attribute_desc[3].binding = binding_desc[0].binding;
+  attribute_desc[3].format = VK_FORMAT_R16G16B16A16_UNORM;
+  attribute_desc[3].offset = offsetof(DrawVert, sdf);
+#endif
+  const int tex_index_attribute = ARRAYSIZE(attribute_desc) - 1;
+  attribute_desc[tex_index_attribute].location = tex_index_attribute;
+  attribute_desc[tex_index_attribute].binding = binding_desc[1].binding;
+  attribute_desc[tex_index_attribute].format = VK_FORMAT_R32_UINT;
+  attribute_desc[tex_index_attribute].offset = 0;
+  const bool use_tex_index = bd->VulkanInitInfo.UseBindlessTextures;
 
   VkPipelineVertexInputStateCreateInfo vertex_info = {};
   vertex_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-  vertex_info.vertexBindingDescriptionCount = 1;
+  vertex_info.vertexBindingDescriptionCount = use_tex_index ? 2 : 1;
   vertex_info.pVertexBindingDescriptions = binding_desc;
-  vertex_info.vertexAttributeDescriptionCount = 3;
+  vertex_info.vertexAttributeDescriptionCount =
+      (unsigned int)ARRAYSIZE(attribute_desc) - (use_tex_index ? 0 : 1);
   vertex_info.pVertexAttributeDescriptions = attribute_desc;
 
   VkPipelineInputAssemblyStateCreateInfo ia_info = {};
@@ -1058,6 +1510,79 @@ static void Vulkan_CreatePipeline(VkDevice device,
   check_vk_result(err);
 }
 
+// VkPipelineCacheHeaderVersionOne, at the start of the pipeline cache data:
+// only reuse data saved by the same driver (pipelineCacheUUID) and device.
+static bool Vulkan_IsPipelineCacheDataCompatible(
+    const unsigned char *data, size_t data_size,
+    const VkPhysicalDeviceProperties *props) {
+  unsigned int header[4]; // headerSize, headerVersion, vendorID, deviceID
+  if (data_size < sizeof(header) + VK_UUID_SIZE)
+    return false;
+  memcpy(header, data, sizeof(header));
+  return header[0] >= sizeof(header) + VK_UUID_SIZE &&
+         header[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+         header[2] == props->vendorID && header[3] == props->deviceID &&
+         memcmp(data + sizeof(header), props->pipelineCacheUUID,
+                VK_UUID_SIZE) == 0;
+}
+
+static void Vulkan_CreatePipelineCache() {
+  Vulkan_Data *bd = Vulkan_GetBackendData();
+  Vulkan_InitInfo *v = &bd->VulkanInitInfo;
+  VkPhysicalDeviceProperties props;
+  vkGetPhysicalDeviceProperties(v->PhysicalDevice, &props);
+
+  // Load the data saved by a previous run, ignore it if missing or invalid
+  unsigned char *data = nullptr;
+  size_t data_size = 0;
+  if (FILE *f = fopen(v->PipelineCacheFilename, "rb")) {
+    long file_size = (fseek(f, 0, SEEK_END) == 0) ? ftell(f) : -1;
+    if (file_size > 0 && fseek(f, 0, SEEK_SET) == 0) {
+      data = (unsigned char *)Gui::MemAlloc((size_t)file_size);
+      if (fread(data, 1, (size_t)file_size, f) == (size_t)file_size)
+        data_size = (size_t)file_size;
+    }
+    fclose(f);
+  }
+  if (!Vulkan_IsPipelineCacheDataCompatible(data, data_size, &props))
+    data_size = 0;
+
+  VkPipelineCacheCreateInfo info = {};
+  info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+  info.initialDataSize = data_size;
+  info.pInitialData = data;
+  VkResult err = vkCreatePipelineCache(v->Device, &info, v->Allocator,
+                                       &bd->OwnedPipelineCache);
+  check_vk_result(err);
+  if (data)
+    Gui::MemFree(data);
+  bd->OwnedPipelineCacheSavedSize = data_size;
+  v->PipelineCache = bd->OwnedPipelineCache;
+}
+
+// Called after creating pipelines. Data only grows when pipelines are added:
+// skip writing when its size didn't change since it was loaded or saved.
+static void Vulkan_SavePipelineCache() {
+  Vulkan_Data *bd = Vulkan_GetBackendData();
+  Vulkan_InitInfo *v = &bd->VulkanInitInfo;
+  size_t data_size = 0;
+  VkResult err = vkGetPipelineCacheData(v->Device, bd->OwnedPipelineCache,
+                                        &data_size, nullptr);
+  if (err != VK_SUCCESS || data_size == 0 ||
+      data_size == bd->OwnedPipelineCacheSavedSize)
+    return;
+  void *data = Gui::MemAlloc(data_size);
+  err = vkGetPipelineCacheData(v->Device, bd->OwnedPipelineCache, &data_size,
+                               data);
+  if (err == VK_SUCCESS)
+    if (FILE *f = fopen(v->PipelineCacheFilename, "wb")) {
+      if (fwrite(data, 1, data_size, f) == data_size)
+        bd->OwnedPipelineCacheSavedSize = data_size;
+      fclose(f);
+    }
+  Gui::MemFree(data);
+}
+
 bool Vulkan_CreateDeviceObjects() {
   Vulkan_Data *bd = Vulkan_GetBackendData();
   Vulkan_InitInfo *v = &bd->VulkanInitInfo;
@@ -1096,6 +1621,58 @@ bool Vulkan_CreateDeviceObjects() {
     check_vk_result(err);
   }
 
+#ifdef VULKAN_HAS_BINDLESS
+  // Bindless textures: a single descriptor set holding an array of all the
+  // textures created by Vulkan_AddTexture(), bound once per frame. Slots are
+  // written while the set is bound by in-flight frames, which never use them.
+  if (v->UseBindlessTextures && !bd->BindlessSetLayout) {
+    VkDescriptorSetLayoutBinding binding[1] = {};
+    binding[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    binding[0].descriptorCount = v->BindlessMaxTextures;
+    binding[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+    VkDescriptorBindingFlagsEXT binding_flags[1] = {
+        VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+        VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+        VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT};
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT flags_info = {};
+    flags_info.sType =
+        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+    flags_info.bindingCount = 1;
+    flags_info.pBindingFlags = binding_flags;
+    VkDescriptorSetLayoutCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    info.pNext = &flags_info;
+    info.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+    info.bindingCount = 1;
+    info.pBindings = binding;
+    err = vkCreateDescriptorSetLayout(v->Device, &info, v->Allocator,
+                                      &bd->BindlessSetLayout);
+    check_vk_result(err);
+
+    VkDescriptorPoolSize pool_size[1] = {};
+    pool_size[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    pool_size[0].descriptorCount = v->BindlessMaxTextures;
+    VkDescriptorPoolCreateInfo pool_info = {};
+    pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+    pool_info.maxSets = 1;
+    pool_info.poolSizeCount = 1;
+    pool_info.pPoolSizes = pool_size;
+    err = vkCreateDescriptorPool(v->Device, &pool_info, v->Allocator,
+                                 &bd->BindlessDescriptorPool);
+    check_vk_result(err);
+
+    VkDescriptorSetAllocateInfo alloc_info = {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    alloc_info.descriptorPool = bd->BindlessDescriptorPool;
+    alloc_info.descriptorSetCount = 1;
+    alloc_info.pSetLayouts = &bd->BindlessSetLayout;
+    err = vkAllocateDescriptorSets(v->Device, &alloc_info,
+                                   &bd->BindlessDescriptorSet);
+    check_vk_result(err);
+  }
+#endif
+
   if (!bd->PipelineLayout) {
     // Constants: we are using 'vec2 offset' and 'vec2 scale' instead of a full
     // 3d projection matrix
@@ -1104,6 +1681,10 @@ bool Vulkan_CreateDeviceObjects() {
     push_constants[0].offset = sizeof(float) * 0;
     push_constants[0].size = sizeof(float) * 4;
     VkDescriptorSetLayout set_layout[1] = {bd->DescriptorSetLayout};
+#ifdef VULKAN_HAS_BINDLESS
+    if (v->UseBindlessTextures)
+      set_layout[0] = bd->BindlessSetLayout;
+#endif
     VkPipelineLayoutCreateInfo layout_info = {};
     layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     layout_info.setLayoutCount = 1;
@@ -1118,6 +1699,31 @@ bool Vulkan_CreateDeviceObjects() {
   Vulkan_CreatePipeline(v->Device, v->Allocator, v->PipelineCache,
                         bd->RenderPass, v->MSAASamples, &bd->Pipeline,
                         bd->Subpass);
+  if (bd->OwnedPipelineCache)
+    Vulkan_SavePipelineCache();
+
+  // Query the alignment of vertex/index buffers once, so
+  // CreateOrResizeBuffer() never writes it while viewports are rendered in
+  // parallel.
+  {
+    const VkBufferUsageFlags usages[] = {VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                         VK_BUFFER_USAGE_INDEX_BUFFER_BIT};
+    for (VkBufferUsageFlags usage : usages) {
+      VkBufferCreateInfo buffer_info = {};
+      buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+      buffer_info.size = 1;
+      buffer_info.usage = usage;
+      buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+      VkBuffer buffer;
+      err = vkCreateBuffer(v->Device, &buffer_info, v->Allocator, &buffer);
+      check_vk_result(err);
+      VkMemoryRequirements req;
+      vkGetBufferMemoryRequirements(v->Device, buffer, &req);
+      bd->BufferMemoryAlignment =
+          MAX(bd->BufferMemoryAlignment, req.alignment);
+      vkDestroyBuffer(v->Device, buffer, v->Allocator);
+    }
+  }
 
   return true;
 }
@@ -1127,7 +1733,12 @@ void Vulkan_DestroyDeviceObjects() {
   Vulkan_InitInfo *v = &bd->VulkanInitInfo;
   Vulkan_DestroyAllViewportsRenderBuffers(v->Device, v->Allocator);
   Vulkan_DestroyFontsTexture();
+  Vulkan_DestroyRetiredFontTextures(true);
 
+  if (bd->FontUploadFence) {
+    vkDestroyFence(v->Device, bd->FontUploadFence, v->Allocator);
+    bd->FontUploadFence = VK_NULL_HANDLE;
+  }
   if (bd->FontCommandBuffer) {
     vkFreeCommandBuffers(v->Device, bd->FontCommandPool, 1,
                          &bd->FontCommandBuffer);
@@ -1154,6 +1765,24 @@ void Vulkan_DestroyDeviceObjects() {
                                  v->Allocator);
     bd->DescriptorSetLayout = VK_NULL_HANDLE;
   }
+#ifdef VULKAN_HAS_BINDLESS
+  if (bd->BindlessDescriptorPool) {
+    // Also frees BindlessDescriptorSet
+    vkDestroyDescriptorPool(v->Device, bd->BindlessDescriptorPool,
+                            v->Allocator);
+    bd->BindlessDescriptorPool = VK_NULL_HANDLE;
+    bd->BindlessDescriptorSet = VK_NULL_HANDLE;
+  }
+  if (bd->BindlessSetLayout) {
+    vkDestroyDescriptorSetLayout(v->Device, bd->BindlessSetLayout,
+                                 v->Allocator);
+    bd->BindlessSetLayout = VK_NULL_HANDLE;
+  }
+  bd->BindlessTextures.clear();
+  bd->BindlessFreeIndices.clear();
+  bd->BindlessRetiredIndices.clear();
+  bd->BindlessNextIndex = 0;
+#endif
   if (bd->PipelineLayout) {
     vkDestroyPipelineLayout(v->Device, bd->PipelineLayout, v->Allocator);
     bd->PipelineLayout = VK_NULL_HANDLE;
@@ -1219,6 +1848,12 @@ bool Vulkan_Init(Vulkan_InitInfo *info, VkRenderPass render_pass) {
                 "VK_KHR_dynamic_rendering is defined.");
 #endif
   }
+#ifndef VULKAN_HAS_BINDLESS
+  assert(!info->UseBindlessTextures &&
+         "Can't use bindless textures when neither VK_VERSION_1_2 or "
+         "VK_EXT_descriptor_indexing is defined, or without the shaders "
+         "built by backends/vulkan/generate_spv.sh.");
+#endif
 
   IO &io = Gui::GetIO();
   assert(io.BackendRendererUserData == nullptr &&
@@ -1235,6 +1870,13 @@ bool Vulkan_Init(Vulkan_InitInfo *info, VkRenderPass render_pass) {
   io.BackendFlags |=
       BackendFlags_RendererHasViewports; // We can create multi-viewports
                                          // on the Renderer side (optional)
+  io.BackendFlags |=
+      BackendFlags_RendererHasParallelViewports; // Vulkan_RenderWindow()
+                                                 // serializes its submit
+#ifdef VULKAN_HAS_SDF
+  io.BackendFlags |=
+      BackendFlags_RendererHasSdfShapes; // Our shaders evaluate DrawVert::sdf
+#endif
 
   assert(info->Instance != VK_NULL_HANDLE);
   assert(info->PhysicalDevice != VK_NULL_HANDLE);
@@ -1247,9 +1889,13 @@ bool Vulkan_Init(Vulkan_InitInfo *info, VkRenderPass render_pass) {
     assert(render_pass != VK_NULL_HANDLE);
 
   bd->VulkanInitInfo = *info;
+  if (info->UseBindlessTextures && info->BindlessMaxTextures == 0)
+    bd->VulkanInitInfo.BindlessMaxTextures = 4096;
   bd->RenderPass = render_pass;
   bd->Subpass = info->Subpass;
 
+  if (info->PipelineCache == VK_NULL_HANDLE && info->PipelineCacheFilename)
+    Vulkan_CreatePipelineCache();
   Vulkan_CreateDeviceObjects();
 
   // Our render function expect RendererUserData to be storing the window render
@@ -1271,6 +1917,9 @@ void Vulkan_Shutdown() {
 
   // First destroy objects in all viewports
   Vulkan_DestroyDeviceObjects();
+  if (bd->OwnedPipelineCache)
+    vkDestroyPipelineCache(bd->VulkanInitInfo.Device, bd->OwnedPipelineCache,
+                           bd->VulkanInitInfo.Allocator);
 
   // Manually delete main viewport render data in-case we haven't initialized
   // for viewports
@@ -1286,7 +1935,9 @@ void Vulkan_Shutdown() {
   io.BackendRendererName = nullptr;
   io.BackendRendererUserData = nullptr;
   io.BackendFlags &=
-      ~(BackendFlags_RendererHasVtxOffset | BackendFlags_RendererHasViewports);
+      ~(BackendFlags_RendererHasVtxOffset | BackendFlags_RendererHasViewports |
+        BackendFlags_RendererHasParallelViewports |
+        BackendFlags_RendererHasSdfShapes);
   DELETE(bd);
 }
 
@@ -1294,6 +1945,12 @@ void Vulkan_NewFrame() {
   Vulkan_Data *bd = Vulkan_GetBackendData();
   assert(bd != nullptr && "Did you call Vulkan_Init()?");
 
+  bd->FrameIndex++;
+  Vulkan_DestroyFontUploadBuffer(false);
+  Vulkan_DestroyRetiredFontTextures(false);
+#ifdef VULKAN_HAS_BINDLESS
+  Vulkan_ReleaseRetiredBindlessIndices();
+#endif
   if (!bd->FontDescriptorSet)
     Vulkan_CreateFontsTexture();
 }
@@ -1346,12 +2003,60 @@ VkDescriptorSet Vulkan_AddTexture(VkSampler sampler, VkImageView image_view,
     write_desc[0].pImageInfo = desc_image;
     vkUpdateDescriptorSets(v->Device, 1, write_desc, 0, nullptr);
   }
+
+#ifdef VULKAN_HAS_BINDLESS
+  // Also store the texture in a slot of the bindless textures array. The
+  // TextureID stays the descriptor set, which Vulkan_RenderDrawData() maps
+  // back to the slot.
+  if (v->UseBindlessTextures) {
+    unsigned int index;
+    if (!bd->BindlessFreeIndices.empty()) {
+      index = bd->BindlessFreeIndices.back();
+      bd->BindlessFreeIndices.pop_back();
+    } else {
+      assert(bd->BindlessNextIndex < v->BindlessMaxTextures &&
+             "Too many textures, increase BindlessMaxTextures!");
+      index = bd->BindlessNextIndex++;
+    }
+    VkDescriptorImageInfo desc_image[1] = {};
+    desc_image[0].sampler = sampler;
+    desc_image[0].imageView = image_view;
+    desc_image[0].imageLayout = image_layout;
+    VkWriteDescriptorSet write_desc[1] = {};
+    write_desc[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write_desc[0].dstSet = bd->BindlessDescriptorSet;
+    write_desc[0].dstArrayElement = index;
+    write_desc[0].descriptorCount = 1;
+    write_desc[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write_desc[0].pImageInfo = desc_image;
+    vkUpdateDescriptorSets(v->Device, 1, write_desc, 0, nullptr);
+
+    Vulkan_BindlessTexture tex;
+    tex.DescriptorSet = descriptor_set;
+    tex.Index = index;
+    bd->BindlessTextures.insert(Vulkan_FindBindlessTexture(descriptor_set),
+                                tex);
+  }
+#endif
   return descriptor_set;
 }
 
 void Vulkan_RemoveTexture(VkDescriptorSet descriptor_set) {
   Vulkan_Data *bd = Vulkan_GetBackendData();
   Vulkan_InitInfo *v = &bd->VulkanInitInfo;
+#ifdef VULKAN_HAS_BINDLESS
+  if (v->UseBindlessTextures) {
+    Vulkan_BindlessTexture *tex = Vulkan_FindBindlessTexture(descriptor_set);
+    if (tex != bd->BindlessTextures.end() &&
+        tex->DescriptorSet == descriptor_set) {
+      Vulkan_RetiredBindlessIndex retired;
+      retired.Index = tex->Index;
+      retired.FrameIndex = bd->FrameIndex;
+      bd->BindlessRetiredIndices.push_back(retired);
+      bd->BindlessTextures.erase(tex);
+    }
+  }
+#endif
   vkFreeDescriptorSets(v->Device, v->DescriptorPool, 1, &descriptor_set);
 }
 
@@ -1781,8 +2486,17 @@ void Vulkan_DestroyFrameRenderBuffers(VkDevice device,
     vkFreeMemory(device, buffers->IndexBufferMemory, allocator);
     buffers->IndexBufferMemory = VK_NULL_HANDLE;
   }
+  if (buffers->TexIndexBuffer) {
+    vkDestroyBuffer(device, buffers->TexIndexBuffer, allocator);
+    buffers->TexIndexBuffer = VK_NULL_HANDLE;
+  }
+  if (buffers->TexIndexBufferMemory) {
+    vkFreeMemory(device, buffers->TexIndexBufferMemory, allocator);
+    buffers->TexIndexBufferMemory = VK_NULL_HANDLE;
+  }
   buffers->VertexBufferSize = 0;
   buffers->IndexBufferSize = 0;
+  buffers->TexIndexBufferSize = 0;
 }
 
 void Vulkan_DestroyWindowRenderBuffers(VkDevice device,
@@ -2027,29 +2741,55 @@ static void Vulkan_RenderWindow(Viewport *viewport, void *) {
     {
       vkCmdEndRenderPass(fd->CommandBuffer);
     }
-    {
-      VkPipelineStageFlags wait_stage =
-          VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-      VkSubmitInfo info = {};
-      info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-      info.waitSemaphoreCount = 1;
-      info.pWaitSemaphores = &fsd->ImageAcquiredSemaphore;
-      info.pWaitDstStageMask = &wait_stage;
-      info.commandBufferCount = 1;
-      info.pCommandBuffers = &fd->CommandBuffer;
-      info.signalSemaphoreCount = 1;
-      info.pSignalSemaphores = &fsd->RenderCompleteSemaphore;
+    err = vkEndCommandBuffer(fd->CommandBuffer);
+    check_vk_result(err);
+  }
 
-      err = vkEndCommandBuffer(fd->CommandBuffer);
-      check_vk_result(err);
-      err = vkResetFences(v->Device, 1, &fd->Fence);
-      check_vk_result(err);
-      err = vkQueueSubmit(v->Queue, 1, &info, fd->Fence);
-      check_vk_result(err);
-    }
+  // Vulkan_RenderWindow() may run on several worker threads at once
+  // (BackendFlags_RendererHasParallelViewports) and accesses to the queue must
+  // be externally synchronized: only the submit is serialized.
+  {
+    VkPipelineStageFlags wait_stage =
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    VkSubmitInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    info.waitSemaphoreCount = 1;
+    info.pWaitSemaphores = &fsd->ImageAcquiredSemaphore;
+    info.pWaitDstStageMask = &wait_stage;
+    info.commandBufferCount = 1;
+    info.pCommandBuffers = &fd->CommandBuffer;
+    info.signalSemaphoreCount = 1;
+    info.pSignalSemaphores = &fsd->RenderCompleteSemaphore;
+
+    err = vkResetFences(v->Device, 1, &fd->Fence);
+    check_vk_result(err);
+    std::lock_guard<std::mutex> lock(g_QueueMutex);
+    err = vkQueueSubmit(v->Queue, 1, &info, fd->Fence);
+    check_vk_result(err);
   }
 }
 
+// Handle the result of presenting a secondary viewport
+static void Vulkan_EndPresentWindow(Viewport *viewport, VkResult err) {
+  Vulkan_Data *bd = Vulkan_GetBackendData();
+  Vulkan_ViewportData *vd = (Vulkan_ViewportData *)viewport->RendererUserData;
+  Vulkan_Window *wd = &vd->Window;
+  Vulkan_InitInfo *v = &bd->VulkanInitInfo;
+  if (err == VK_ERROR_OUT_OF_DATE_KHR || err == VK_SUBOPTIMAL_KHR)
+    Vulkan_CreateOrResizeWindow(v->Instance, v->PhysicalDevice, v->Device,
+                                &vd->Window, v->QueueFamily, v->Allocator,
+                                (int)viewport->Size.x, (int)viewport->Size.y,
+                                v->MinImageCount);
+  else
+    check_vk_result(err);
+
+  wd->FrameIndex = (wd->FrameIndex + 1) %
+                   wd->ImageCount; // This is for the next vkWaitForFences()
+  wd->SemaphoreIndex =
+      (wd->SemaphoreIndex + 1) %
+      wd->ImageCount; // Now we can use the next set of semaphores
+}
+
 static void Vulkan_SwapBuffers(Viewport *viewport, void *) {
   Vulkan_Data *bd = Vulkan_GetBackendData();
   Vulkan_ViewportData *vd = (Vulkan_ViewportData *)viewport->RendererUserData;
@@ -2068,19 +2808,41 @@ static void Vulkan_SwapBuffers(Viewport *viewport, void *) {
   info.pSwapchains = &wd->Swapchain;
   info.pImageIndices = &present_index;
   err = vkQueuePresentKHR(v->Queue, &info);
-  if (err == VK_ERROR_OUT_OF_DATE_KHR || err == VK_SUBOPTIMAL_KHR)
-    Vulkan_CreateOrResizeWindow(v->Instance, v->PhysicalDevice, v->Device,
-                                &vd->Window, v->QueueFamily, v->Allocator,
-                                (int)viewport->Size.x, (int)viewport->Size.y,
-                                v->MinImageCount);
-  else
-    check_vk_result(err);
+  Vulkan_EndPresentWindow(viewport, err);
+}
 
-  wd->FrameIndex = (wd->FrameIndex + 1) %
-                   wd->ImageCount; // This is for the next vkWaitForFences()
-  wd->SemaphoreIndex =
-      (wd->SemaphoreIndex + 1) %
-      wd->ImageCount; // Now we can use the next set of semaphores
+// Present all secondary viewports with a single vkQueuePresentKHR() call
+static void Vulkan_SwapBuffersBatch(Viewport **viewports, int viewports_count,
+                                    void *) {
+  Vulkan_Data *bd = Vulkan_GetBackendData();
+  Vulkan_InitInfo *v = &bd->VulkanInitInfo;
+  bd->PresentSwapchains.resize(0);
+  bd->PresentWaitSemaphores.resize(0);
+  bd->PresentImageIndices.resize(0);
+  for (int n = 0; n < viewports_count; n++) {
+    Vulkan_ViewportData *vd =
+        (Vulkan_ViewportData *)viewports[n]->RendererUserData;
+    Vulkan_Window *wd = &vd->Window;
+    bd->PresentSwapchains.push_back(wd->Swapchain);
+    bd->PresentWaitSemaphores.push_back(
+        wd->FrameSemaphores[wd->SemaphoreIndex].RenderCompleteSemaphore);
+    bd->PresentImageIndices.push_back(wd->FrameIndex);
+  }
+  bd->PresentResults.resize(viewports_count);
+
+  VkPresentInfoKHR info = {};
+  info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+  info.waitSemaphoreCount = (unsigned int)viewports_count;
+  info.pWaitSemaphores = bd->PresentWaitSemaphores.Data;
+  info.swapchainCount = (unsigned int)viewports_count;
+  info.pSwapchains = bd->PresentSwapchains.Data;
+  info.pImageIndices = bd->PresentImageIndices.Data;
+  info.pResults = bd->PresentResults.Data;
+  VkResult err = vkQueuePresentKHR(v->Queue, &info);
+  if (err != VK_ERROR_OUT_OF_DATE_KHR && err != VK_SUBOPTIMAL_KHR)
+    check_vk_result(err);
+  for (int n = 0; n < viewports_count; n++)
+    Vulkan_EndPresentWindow(viewports[n], bd->PresentResults[n]);
 }
 
 void Vulkan_InitPlatformInterface() {
@@ -2093,9 +2855,14 @@ void Vulkan_InitPlatformInterface() {
   platform_io.Renderer_SetWindowSize = Vulkan_SetWindowSize;
   platform_io.Renderer_RenderWindow = Vulkan_RenderWindow;
   platform_io.Renderer_SwapBuffers = Vulkan_SwapBuffers;
+  platform_io.Renderer_SwapBuffersBatch = Vulkan_SwapBuffersBatch;
 }
 
-void Vulkan_ShutdownPlatformInterface() { Gui::DestroyPlatformWindows(); }
+void Vulkan_ShutdownPlatformInterface() {
+  Gui::DestroyPlatformWindows();
+  // Other renderers don't set it: don't leave it pointing to our backend
+  Gui::GetPlatformIO().Renderer_SwapBuffersBatch = nullptr;
+}
 
 //-----------------------------------------------------------------------------
 
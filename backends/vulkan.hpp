@@ -24,6 +24,14 @@
 //   the backend itself (vulkan.cpp), but should PROBABLY NOT be used
 //   by your own engine/app code.
 // Read comments in vulkan.hpp.
+//
+// Multi-viewports: for each secondary viewport, Renderer_RenderWindow()
+// records and submits its command buffer, and Renderer_SwapBuffers() or
+// Renderer_SwapBuffersBatch() presents it. When secondary viewports are
+// rendered in parallel (see PlatformIO::ParallelFor), Renderer_RenderWindow()
+// runs on several threads at once: the backend serializes its own
+// vkQueueSubmit() calls, but your code must not use the same VkQueue from
+// another thread until RenderPlatformWindowsDefault() returns.
 
 #pragma once
 #ifndef DISABLE
@@ -57,7 +65,7 @@ struct Vulkan_InitInfo {
   VkDevice Device;
   unsigned int QueueFamily;
   VkQueue Queue;
-  VkPipelineCache PipelineCache;
+  VkPipelineCache PipelineCache; // Optional
   VkDescriptorPool DescriptorPool;
   unsigned int Subpass;
   unsigned int MinImageCount;        // >= 2
@@ -71,7 +79,31 @@ struct Vulkan_InitInfo {
                            // extension to use this, even for Vulkan 1.3.
   VkFormat ColorAttachmentFormat; // Required for dynamic rendering
 
+  // Pipeline Cache Persistence (Optional)
+  // When PipelineCache is VK_NULL_HANDLE and a filename is set, the backend
+  // creates its own pipeline cache: loaded from this file if it was saved by
+  // the same driver and device, and saved after creating pipelines, so they
+  // are not compiled from scratch on every launch. Must stay valid until
+  // Vulkan_Shutdown().
+  const char *PipelineCacheFilename;
+
+  // Bindless Textures (Optional)
+  // Render with all textures bound at once in a descriptor array, and a texture
+  // index per vertex, so draw commands only differing by their texture are
+  // merged into a single draw call. Requires Vulkan 1.2 or
+  // VK_EXT_descriptor_indexing, with the runtimeDescriptorArray,
+  // shaderSampledImageArrayNonUniformIndexing, descriptorBindingPartiallyBound,
+  // descriptorBindingSampledImageUpdateAfterBind and
+  // descriptorBindingUpdateUnusedWhilePending features enabled, and the
+  // shaders built by backends/vulkan/generate_spv.sh. All textures must be
+  // created with Vulkan_AddTexture(). A custom pipeline passed to
+  // Vulkan_RenderDrawData() must be compatible with the backend's one.
+  bool UseBindlessTextures;
+  unsigned int BindlessMaxTextures; // 0 -> default to 4096
+
   // Allocation, Debugging
+  // Both may be called from several threads at once when secondary viewports
+  // are rendered in parallel (see PlatformIO::ParallelFor).
   const VkAllocationCallbacks *Allocator;
   void (*CheckVkResultFn)(VkResult err);
   VkDeviceSize MinAllocationSize; // Minimum allocation size. Set to 1024*1024
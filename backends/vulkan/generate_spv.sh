@@ -1,6 +1,14 @@
 #!/bin/bash
 ## -V: create SPIR-V binary
 ## -x: save binary output as text-based 32-bit hexadecimal numbers
+## --spirv-val: validate the SPIR-V binary with SPIRV-Tools
 ## -o: output file
-glslangValidator -V -x -o glsl_shader.frag.u32 glsl_shader.frag
-glslangValidator -V -x -o glsl_shader.vert.u32 glsl_shader.vert
+## The SDF and bindless .u32 files are included by ../vulkan.cpp: commit them as generated.
+glslangValidator -V -x --spirv-val -o glsl_shader.frag.u32 glsl_shader.frag
+glslangValidator -V -x --spirv-val -o glsl_shader.vert.u32 glsl_shader.vert
+glslangValidator -V -x --spirv-val -o glsl_shader_sdf.frag.u32 glsl_shader_sdf.frag
+glslangValidator -V -x --spirv-val -o glsl_shader_sdf.vert.u32 glsl_shader_sdf.vert
+glslangValidator -V -x --spirv-val -o glsl_shader_bindless.frag.u32 glsl_shader_bindless.frag
+glslangValidator -V -x --spirv-val -o glsl_shader_bindless.vert.u32 glsl_shader_bindless.vert
+glslangValidator -V -x --spirv-val -o glsl_shader_sdf_bindless.frag.u32 glsl_shader_sdf_bindless.frag
+glslangValidator -V -x --spirv-val -o glsl_shader_sdf_bindless.vert.u32 glsl_shader_sdf_bindless.vert
@@ -0,0 +1,16 @@
+#version 450 core
+#extension GL_EXT_nonuniform_qualifier : require
+layout(location = 0) out vec4 fColor;
+
+layout(set=0, binding=0) uniform sampler2D sTextures[];
+
+layout(location = 0) in struct {
+    vec4 Color;
+    vec2 UV;
+} In;
+layout(location = 2) flat in uint TexIndex;
+
+void main()
+{
+    fColor = In.Color * texture(sTextures[nonuniformEXT(TexIndex)], In.UV.st);
+}
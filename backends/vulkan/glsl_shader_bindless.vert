@@ -0,0 +1,28 @@
+#version 450 core
+layout(location = 0) in vec2 aPos;
+layout(location = 1) in vec2 aUV;
+layout(location = 2) in vec4 aColor;
+layout(location = 3) in uint aTexIndex;
+
+layout(push_constant) uniform uPushConstant {
+    vec2 uScale;
+    vec2 uTranslate;
+} pc;
+
+out gl_PerVertex {
+    vec4 gl_Position;
+};
+
+layout(location = 0) out struct {
+    vec4 Color;
+    vec2 UV;
+} Out;
+layout(location = 2) flat out uint TexIndex;
+
+void main()
+{
+    Out.Color = aColor;
+    Out.UV = aUV;
+    TexIndex = aTexIndex;
+    gl_Position = vec4(aPos * pc.uScale + pc.uTranslate, 0, 1);
+}
@@ -0,0 +1,31 @@
+#version 450 core
+layout(location = 0) out vec4 fColor;
+
+layout(set=0, binding=0) uniform sampler2D sTexture;
+
+layout(location = 0) in struct {
+    vec4 Color;
+    vec2 UV;
+    vec2 SdfPos;
+    vec4 SdfShape;
+    vec4 SdfRadii;
+} In;
+
+void main()
+{
+    if (In.SdfShape.x > 0.0)
+    {
+        // Rounded box distance, with the radius of the quadrant we are in
+        vec2 p = In.SdfPos;
+        vec2 radii = (p.x > 0.0) ? In.SdfRadii.yw : In.SdfRadii.xz;
+        float r = (p.y > 0.0) ? radii.y : radii.x;
+        vec2 q = abs(p) - In.SdfShape.xy + r;
+        float d = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - r;
+        d = (In.SdfShape.z > 0.0) ? abs(d) - In.SdfShape.z * 0.5 : d;
+        fColor = vec4(In.Color.rgb, In.Color.a * clamp(0.5 - d, 0.0, 1.0));
+    }
+    else
+    {
+        fColor = In.Color * texture(sTexture, In.UV.st);
+    }
+}
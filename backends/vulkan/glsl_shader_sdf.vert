@@ -0,0 +1,35 @@
+#version 450 core
+layout(location = 0) in vec2 aPos;
+layout(location = 1) in vec2 aUV;
+layout(location = 2) in vec4 aColor;
+layout(location = 3) in vec4 aSdf;
+
+layout(push_constant) uniform uPushConstant {
+    vec2 uScale;
+    vec2 uTranslate;
+} pc;
+
+out gl_PerVertex {
+    vec4 gl_Position;
+};
+
+layout(location = 0) out struct {
+    vec4 Color;
+    vec2 UV;
+    vec2 SdfPos;
+    vec4 SdfShape;
+    vec4 SdfRadii;
+} Out;
+
+// Decode DrawVert::sdf (see USE_DRAWVERT_SDF in gui.hpp)
+void main()
+{
+    Out.Color = aColor;
+    Out.UV = aUV;
+    vec4 sdf = floor(aSdf * 65535.0 + 0.5);
+    float corners = floor(sdf.z / 4096.0);
+    Out.SdfShape = vec4(sdf.xyw * 0.25, 0.0);
+    Out.SdfRadii = (sdf.z - corners * 4096.0) * 0.25 * mod(floor(corners / vec4(1, 2, 4, 8)), 2.0);
+    Out.SdfPos = (aUV * 2.0 - 1.0) * (Out.SdfShape.xy + Out.SdfShape.z * 0.5 + 1.0);
+    gl_Position = vec4(aPos * pc.uScale + pc.uTranslate, 0, 1);
+}
@@ -14,6 +14,9 @@
 #include "../gui.hpp"
 #ifndef DISABLE
 #include "wgpu.hpp"
+#ifdef USE_DRAWVERT_COMPACT
+#error "This backend doesn't support USE_DRAWVERT_COMPACT"
+#endif
 #include <limits.h>
 #include <webgpu/webgpu.h>
 
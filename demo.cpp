@@ -511,6 +511,7 @@ void Gui::ShowDemoWindow(bool *p_open) {
       if (io.ConfigFlags & ConfigFlags_NoMouse) {
         // The "NoMouse" option can get us stuck with a disabled mouse! Let's
         // provide an alternative way to fix it:
+        Gui::RequestRedraw(); // Blinking text below
         if (fmodf((float)Gui::GetTime(), 0.40f) < 0.20f) {
           Gui::SameLine();
           Gui::Text("<<PRESS SPACE TO DISABLE>>");
@@ -640,6 +641,11 @@ void Gui::ShowDemoWindow(bool *p_open) {
       Gui::Checkbox("io.ConfigWindowsMoveFromTitleBarOnly",
                     &io.ConfigWindowsMoveFromTitleBarOnly);
       Gui::Checkbox("io.ConfigMacOSXBehaviors", &io.ConfigMacOSXBehaviors);
+      Gui::Checkbox("io.ConfigRenderOcclusionCulling",
+                    &io.ConfigRenderOcclusionCulling);
+      Gui::SameLine();
+      HelpMarker("Skip draw lists and draw commands hidden behind windows with "
+                 "a fully opaque background.\nSee Col_WindowBg alpha.");
       Gui::Text("Also see Style->Rendering for rendering options.");
 
       Gui::SeparatorText("Debug");
@@ -696,6 +702,8 @@ void Gui::ShowDemoWindow(bool *p_open) {
                          BackendFlags_HasMouseHoveredViewport);
       Gui::CheckboxFlags("io.BackendFlags: RendererHasVtxOffset",
                          &io.BackendFlags, BackendFlags_RendererHasVtxOffset);
+      Gui::CheckboxFlags("io.BackendFlags: RendererHasSdfShapes",
+                         &io.BackendFlags, BackendFlags_RendererHasSdfShapes);
       Gui::CheckboxFlags("io.BackendFlags: RendererHasViewports",
                          &io.BackendFlags, BackendFlags_RendererHasViewports);
       Gui::EndDisabled();
@@ -1049,6 +1057,7 @@ static void ShowDemoWindowWidgets() {
       static float arr[] = {0.6f, 0.1f, 1.0f, 0.5f, 0.92f, 0.1f, 0.2f};
       Gui::PlotLines("Curve", arr, ARRAYSIZE(arr));
       Gui::Text("Sin(time) = %f", sinf((float)Gui::GetTime()));
+      Gui::RequestRedraw();
       Gui::EndTooltip();
     }
 
@@ -1067,6 +1076,7 @@ static void ShowDemoWindowWidgets() {
     else if (always_on == 2 && Gui::BeginTooltip()) {
       Gui::ProgressBar(sinf((float)Gui::GetTime()) * 0.5f + 0.5f,
                        Vec2(Gui::GetFontSize() * 25, 0.0f));
+      Gui::RequestRedraw();
       Gui::EndTooltip();
     }
 
@@ -1249,6 +1259,47 @@ static void ShowDemoWindowWidgets() {
         Gui::Indent(Gui::GetTreeNodeToLabelSpacing());
       Gui::TreePop();
     }
+
+    DEMO_MARKER("Widgets/Tree Nodes/Large trees, with clipping");
+    if (Gui::TreeNode("Large trees, with clipping")) {
+      HelpMarker(
+          "TreeClipper keeps the expanded hierarchy as a flat list of rows "
+          "and only submits the visible ones. Opening or closing a node only "
+          "costs its visible descendants.\n\n"
+          "This tree has 6 levels of 8 nodes (~300k nodes).");
+      // Nodes are numbered breadth-first: the children of node n are
+      // 8*(n+1)+0 to 8*(n+1)+7 and the roots are 0 to 7.
+      struct Funcs {
+        static int GetChildrenCount(void *, int node) {
+          const int nodes_count = 8 * (1 + 8 + 64 + 512 + 4096 + 32768);
+          return (8 * (node + 1) < nodes_count) ? 8 : 0;
+        }
+        static int GetChild(void *, int node, int child_n) {
+          return 8 * (node + 1) + child_n;
+        }
+      };
+      static int selected_node = -1;
+      Gui::BeginChild("large_tree", Vec2(0, Gui::GetFontSize() * 20.0f),
+                      ChildFlags_Border);
+      TreeClipper clipper;
+      clipper.Begin("tree", Funcs::GetChildrenCount, Funcs::GetChild, NULL);
+      while (clipper.Step())
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+          const int node = clipper.GetRowNode(row);
+          char label[32];
+          sprintf(label, "Node %d", node);
+          int node_flags = TreeNodeFlags_OpenOnArrow |
+                           TreeNodeFlags_OpenOnDoubleClick |
+                           TreeNodeFlags_SpanAvailWidth;
+          if (node == selected_node)
+            node_flags |= TreeNodeFlags_Selected;
+          clipper.TreeNode(row, label, node_flags);
+          if (Gui::IsItemClicked() && !Gui::IsItemToggledOpen())
+            selected_node = node;
+        }
+      Gui::EndChild();
+      Gui::TreePop();
+    }
     Gui::TreePop();
   }
 
@@ -1739,10 +1790,12 @@ static void ShowDemoWindowWidgets() {
       const float time = (float)Gui::GetTime();
       const bool winning_state = memchr(selected, 0, sizeof(selected)) ==
                                  NULL; // If all cells are selected...
-      if (winning_state)
+      if (winning_state) {
         Gui::PushStyleVar(StyleVar_SelectableTextAlign,
                           Vec2(0.5f + 0.5f * cosf(time * 2.0f),
                                0.5f + 0.5f * sinf(time * 3.0f)));
+        Gui::RequestRedraw();
+      }
 
       for (int y = 0; y < 4; y++)
         for (int x = 0; x < 4; x++) {
@@ -2197,6 +2250,8 @@ static void ShowDemoWindowWidgets() {
   if (Gui::TreeNode("Plotting")) {
     static bool animate = true;
     Gui::Checkbox("Animate", &animate);
+    if (animate)
+      Gui::RequestRedraw(); // Keep animating when the app waits for events
 
     // Plot as lines and plot as histogram
     DEMO_MARKER("Widgets/Plotting/PlotLines, PlotHistogram");
@@ -4324,6 +4379,42 @@ static void ShowDemoWindowLayout() {
     Gui::TreePop();
   }
 
+  DEMO_MARKER("Layout/Lazy Regions");
+  if (Gui::TreeNode("Lazy Regions")) {
+    HelpMarker("BeginLazyRegion() remembers the size of a block of items and "
+               "skips submitting it entirely while it is scrolled out of "
+               "view, advancing the cursor instead.\n"
+               "Unlike ListClipper, regions may all have different sizes and "
+               "be nested in any layout.");
+    static bool use_lazy_regions = true;
+    static float values[5000];
+    Gui::Checkbox("Use lazy regions", &use_lazy_regions);
+    int submitted_count = 0;
+    if (Gui::BeginChild("##lazy", Vec2(0.0f, Gui::GetFontSize() * 20.0f),
+                        ChildFlags_Border)) {
+      for (int n = 0; n < ARRAYSIZE(values); n++) {
+        Gui::PushID(n);
+        if (!use_lazy_regions || Gui::BeginLazyRegion("section")) {
+          submitted_count++;
+          Gui::SeparatorText("Section");
+          Gui::SameLine();
+          Gui::Text("%d", n);
+          for (int line = 0; line < 1 + (n % 4); line++) {
+            Gui::PushID(line);
+            Gui::SliderFloat("Value", &values[n], 0.0f, 1.0f);
+            Gui::PopID();
+          }
+          if (use_lazy_regions)
+            Gui::EndLazyRegion();
+        }
+        Gui::PopID();
+      }
+    }
+    Gui::EndChild();
+    Gui::Text("%d/%d sections submitted", submitted_count, ARRAYSIZE(values));
+    Gui::TreePop();
+  }
+
   DEMO_MARKER("Layout/Overlap Mode");
   if (Gui::TreeNode("Overlap Mode")) {
     static bool enable_allow_overlap = true;
@@ -5543,6 +5634,42 @@ static void ShowDemoWindowTables() {
     Gui::TreePop();
   }
 
+  if (open_action != -1)
+    Gui::SetNextItemOpen(open_action != 0);
+  DEMO_MARKER("Tables/Vertical scrolling, with variable row heights");
+  if (Gui::TreeNode("Vertical scrolling, with variable row heights")) {
+    HelpMarker(
+        "We demonstrate using TableRowClipper to virtualize the submission of "
+        "rows which don't all have the same height.\n\nRow heights are "
+        "measured as they become visible and remembered by the table, so the "
+        "scrollbar stays accurate.");
+    Vec2 outer_size = Vec2(0.0f, TEXT_BASE_HEIGHT * 12);
+    if (Gui::BeginTable("table_variable_rows", 2,
+                        TableFlags_ScrollY | TableFlags_RowBg |
+                            TableFlags_BordersOuter | TableFlags_BordersV,
+                        outer_size)) {
+      Gui::TableSetupScrollFreeze(0, 1); // Make top row always visible
+      Gui::TableSetupColumn("ID", TableColumnFlags_WidthFixed);
+      Gui::TableSetupColumn("Description");
+      Gui::TableHeadersRow();
+
+      TableRowClipper clipper;
+      clipper.Begin(100000);
+      while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+          Gui::TableNextRow();
+          Gui::TableSetColumnIndex(0);
+          Gui::Text("%06d", row);
+          Gui::TableSetColumnIndex(1);
+          for (int line = 0; line < 1 + (row % 4); line++)
+            Gui::Text("Line %d", line);
+        }
+      }
+      Gui::EndTable();
+    }
+    Gui::TreePop();
+  }
+
   if (open_action != -1)
     Gui::SetNextItemOpen(open_action != 0);
   DEMO_MARKER("Tables/Horizontal scrolling");
@@ -5647,6 +5774,60 @@ static void ShowDemoWindowTables() {
     Gui::TreePop();
   }
 
+  if (open_action != -1)
+    Gui::SetNextItemOpen(open_action != 0);
+  DEMO_MARKER("Tables/Horizontal scrolling, with virtual columns");
+  if (Gui::TreeNode("Horizontal scrolling, with virtual columns")) {
+    HelpMarker(
+        "With TableFlags_VirtualColumns, TableSetupVirtualColumns() appends "
+        "logical columns of which only those in sight are laid out and "
+        "submitted, so a table can have a very large number of columns.\n\n"
+        "Columns widths are remembered by the table and can be resized. "
+        "Headers need to be submitted manually.");
+    static int columns_count = 10000;
+    PushStyleCompact();
+    Gui::SetNextItemWidth(TEXT_BASE_WIDTH * 12);
+    Gui::DragInt("Columns", &columns_count, 10.0f, 0, 1000000);
+    PopStyleCompact();
+    const int flags = TableFlags_ScrollX | TableFlags_ScrollY |
+                      TableFlags_VirtualColumns | TableFlags_RowBg |
+                      TableFlags_BordersOuter | TableFlags_BordersV |
+                      TableFlags_Resizable;
+    Vec2 outer_size = Vec2(0.0f, TEXT_BASE_HEIGHT * 10);
+    if (Gui::BeginTable("table_virtual_columns", 1, flags, outer_size)) {
+      Gui::TableSetupScrollFreeze(1, 1);
+      Gui::TableSetupColumn("Row", TableColumnFlags_WidthFixed,
+                            TEXT_BASE_WIDTH * 6);
+      Gui::TableSetupVirtualColumns(columns_count, TEXT_BASE_WIDTH * 8);
+      int column_start, column_end;
+      Gui::TableGetVirtualColumnsRange(&column_start, &column_end);
+
+      Gui::TableNextRow(TableRowFlags_Headers);
+      Gui::TableSetColumnIndex(0);
+      Gui::TableHeader("Row");
+      for (int column = column_start; column < column_end; column++) {
+        char label[32];
+        sprintf(label, "C%d", column);
+        Gui::TableSetVirtualColumnIndex(column);
+        Gui::TableHeader(label);
+      }
+
+      ListClipper clipper;
+      clipper.Begin(1000);
+      while (clipper.Step())
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+          Gui::TableNextRow();
+          Gui::TableSetColumnIndex(0);
+          Gui::Text("%d", row);
+          for (int column = column_start; column < column_end; column++)
+            if (Gui::TableSetVirtualColumnIndex(column))
+              Gui::Text("%d", row * column);
+        }
+      Gui::EndTable();
+    }
+    Gui::TreePop();
+  }
+
   if (open_action != -1)
     Gui::SetNextItemOpen(open_action != 0);
   DEMO_MARKER("Tables/Columns flags");
@@ -7642,6 +7823,8 @@ void Gui::ShowAboutWindow(bool *p_open) {
     if (io.ConfigMemoryCompactTimer >= 0.0f)
       Gui::Text("io.ConfigMemoryCompactTimer = %.1f",
                 io.ConfigMemoryCompactTimer);
+    if (io.ConfigRenderOcclusionCulling)
+      Gui::Text("io.ConfigRenderOcclusionCulling");
     Gui::Text("io.BackendFlags: 0x%08X", io.BackendFlags);
     if (io.BackendFlags & BackendFlags_HasGamepad)
       Gui::Text(" HasGamepad");
@@ -7655,6 +7838,8 @@ void Gui::ShowAboutWindow(bool *p_open) {
       Gui::Text(" HasMouseHoveredViewport");
     if (io.BackendFlags & BackendFlags_RendererHasVtxOffset)
       Gui::Text(" RendererHasVtxOffset");
+    if (io.BackendFlags & BackendFlags_RendererHasSdfShapes)
+      Gui::Text(" RendererHasSdfShapes");
     if (io.BackendFlags & BackendFlags_RendererHasViewports)
       Gui::Text(" RendererHasViewports");
     Gui::Separator();
@@ -9375,6 +9560,7 @@ static void ShowExampleAppWindowTitles(bool *) {
   char buf[128];
   sprintf(buf, "Animated title %c %d###AnimatedTitle",
           "|/-\\"[(int)(Gui::GetTime() / 0.25f) & 3], Gui::GetFrameCount());
+  Gui::RequestRedraw(0.25f);
   Gui::SetNextWindowPos(Vec2(base_pos.x + 100, base_pos.y + 300),
                         Cond_FirstUseEver);
   Gui::Begin(buf);
@@ -9,6 +9,7 @@
 // [SECTION] FontAtlas glyph ranges helpers
 // [SECTION] FontGlyphRangesBuilder
 // [SECTION] Font
+// [SECTION] ImageAtlas
 // [SECTION] Gui Internal Render Helpers
 // [SECTION] Decompression code
 // [SECTION] Default font data (ProggyClean.ttf)
@@ -507,6 +508,9 @@ DrawList *DrawList::CloneOutput() const {
   dst->IdxBuffer = IdxBuffer;
   dst->VtxBuffer = VtxBuffer;
   dst->Flags = Flags;
+#ifdef USE_DRAWVERT_COMPACT
+  dst->VtxOrigin = VtxOrigin;
+#endif
   return dst;
 }
 
@@ -756,18 +760,10 @@ void DrawList::PrimRect(const Vec2 &a, const Vec2 &c, unsigned int col) {
   _IdxWritePtr[3] = idx;
   _IdxWritePtr[4] = (DrawIdx)(idx + 2);
   _IdxWritePtr[5] = (DrawIdx)(idx + 3);
-  _VtxWritePtr[0].pos = a;
-  _VtxWritePtr[0].uv = uv;
-  _VtxWritePtr[0].col = col;
-  _VtxWritePtr[1].pos = b;
-  _VtxWritePtr[1].uv = uv;
-  _VtxWritePtr[1].col = col;
-  _VtxWritePtr[2].pos = c;
-  _VtxWritePtr[2].uv = uv;
-  _VtxWritePtr[2].col = col;
-  _VtxWritePtr[3].pos = d;
-  _VtxWritePtr[3].uv = uv;
-  _VtxWritePtr[3].col = col;
+  _VtxWrite(&_VtxWritePtr[0], a, uv, col);
+  _VtxWrite(&_VtxWritePtr[1], b, uv, col);
+  _VtxWrite(&_VtxWritePtr[2], c, uv, col);
+  _VtxWrite(&_VtxWritePtr[3], d, uv, col);
   _VtxWritePtr += 4;
   _VtxCurrentIdx += 4;
   _IdxWritePtr += 6;
@@ -783,18 +779,10 @@ void DrawList::PrimRectUV(const Vec2 &a, const Vec2 &c, const Vec2 &uv_a,
   _IdxWritePtr[3] = idx;
   _IdxWritePtr[4] = (DrawIdx)(idx + 2);
   _IdxWritePtr[5] = (DrawIdx)(idx + 3);
-  _VtxWritePtr[0].pos = a;
-  _VtxWritePtr[0].uv = uv_a;
-  _VtxWritePtr[0].col = col;
-  _VtxWritePtr[1].pos = b;
-  _VtxWritePtr[1].uv = uv_b;
-  _VtxWritePtr[1].col = col;
-  _VtxWritePtr[2].pos = c;
-  _VtxWritePtr[2].uv = uv_c;
-  _VtxWritePtr[2].col = col;
-  _VtxWritePtr[3].pos = d;
-  _VtxWritePtr[3].uv = uv_d;
-  _VtxWritePtr[3].col = col;
+  _VtxWrite(&_VtxWritePtr[0], a, uv_a, col);
+  _VtxWrite(&_VtxWritePtr[1], b, uv_b, col);
+  _VtxWrite(&_VtxWritePtr[2], c, uv_c, col);
+  _VtxWrite(&_VtxWritePtr[3], d, uv_d, col);
   _VtxWritePtr += 4;
   _VtxCurrentIdx += 4;
   _IdxWritePtr += 6;
@@ -811,18 +799,10 @@ void DrawList::PrimQuadUV(const Vec2 &a, const Vec2 &b, const Vec2 &c,
   _IdxWritePtr[3] = idx;
   _IdxWritePtr[4] = (DrawIdx)(idx + 2);
   _IdxWritePtr[5] = (DrawIdx)(idx + 3);
-  _VtxWritePtr[0].pos = a;
-  _VtxWritePtr[0].uv = uv_a;
-  _VtxWritePtr[0].col = col;
-  _VtxWritePtr[1].pos = b;
-  _VtxWritePtr[1].uv = uv_b;
-  _VtxWritePtr[1].col = col;
-  _VtxWritePtr[2].pos = c;
-  _VtxWritePtr[2].uv = uv_c;
-  _VtxWritePtr[2].col = col;
-  _VtxWritePtr[3].pos = d;
-  _VtxWritePtr[3].uv = uv_d;
-  _VtxWritePtr[3].col = col;
+  _VtxWrite(&_VtxWritePtr[0], a, uv_a, col);
+  _VtxWrite(&_VtxWritePtr[1], b, uv_b, col);
+  _VtxWrite(&_VtxWritePtr[2], c, uv_c, col);
+  _VtxWrite(&_VtxWritePtr[3], d, uv_d, col);
   _VtxWritePtr += 4;
   _VtxCurrentIdx += 4;
   _IdxWritePtr += 6;
@@ -1038,26 +1018,21 @@ void DrawList::AddPolyline(const Vec2 *points, const int points_count,
         Vec2 tex_uv0(tex_uvs.x, tex_uvs.y);
         Vec2 tex_uv1(tex_uvs.z, tex_uvs.w);
         for (int i = 0; i < points_count; i++) {
-          _VtxWritePtr[0].pos = temp_points[i * 2 + 0];
-          _VtxWritePtr[0].uv = tex_uv0;
-          _VtxWritePtr[0].col = col; // Left-side outer edge
-          _VtxWritePtr[1].pos = temp_points[i * 2 + 1];
-          _VtxWritePtr[1].uv = tex_uv1;
-          _VtxWritePtr[1].col = col; // Right-side outer edge
+          _VtxWrite(&_VtxWritePtr[0], temp_points[i * 2 + 0], tex_uv0,
+                    col); // Left-side outer edge
+          _VtxWrite(&_VtxWritePtr[1], temp_points[i * 2 + 1], tex_uv1,
+                    col); // Right-side outer edge
           _VtxWritePtr += 2;
         }
       } else {
         // If we're not using a texture, we need the center vertex as well
         for (int i = 0; i < points_count; i++) {
-          _VtxWritePtr[0].pos = points[i];
-          _VtxWritePtr[0].uv = opaque_uv;
-          _VtxWritePtr[0].col = col; // Center of line
-          _VtxWritePtr[1].pos = temp_points[i * 2 + 0];
-          _VtxWritePtr[1].uv = opaque_uv;
-          _VtxWritePtr[1].col = col_trans; // Left-side outer edge
-          _VtxWritePtr[2].pos = temp_points[i * 2 + 1];
-          _VtxWritePtr[2].uv = opaque_uv;
-          _VtxWritePtr[2].col = col_trans; // Right-side outer edge
+          _VtxWrite(&_VtxWritePtr[0], points[i], opaque_uv,
+                    col); // Center of line
+          _VtxWrite(&_VtxWritePtr[1], temp_points[i * 2 + 0], opaque_uv,
+                    col_trans); // Left-side outer edge
+          _VtxWrite(&_VtxWritePtr[2], temp_points[i * 2 + 1], opaque_uv,
+                    col_trans); // Right-side outer edge
           _VtxWritePtr += 3;
         }
       }
@@ -1156,18 +1131,12 @@ void DrawList::AddPolyline(const Vec2 *points, const int points_count,
 
       // Add vertices
       for (int i = 0; i < points_count; i++) {
-        _VtxWritePtr[0].pos = temp_points[i * 4 + 0];
-        _VtxWritePtr[0].uv = opaque_uv;
-        _VtxWritePtr[0].col = col_trans;
-        _VtxWritePtr[1].pos = temp_points[i * 4 + 1];
-        _VtxWritePtr[1].uv = opaque_uv;
-        _VtxWritePtr[1].col = col;
-        _VtxWritePtr[2].pos = temp_points[i * 4 + 2];
-        _VtxWritePtr[2].uv = opaque_uv;
-        _VtxWritePtr[2].col = col;
-        _VtxWritePtr[3].pos = temp_points[i * 4 + 3];
-        _VtxWritePtr[3].uv = opaque_uv;
-        _VtxWritePtr[3].col = col_trans;
+        _VtxWrite(&_VtxWritePtr[0], temp_points[i * 4 + 0], opaque_uv,
+                  col_trans);
+        _VtxWrite(&_VtxWritePtr[1], temp_points[i * 4 + 1], opaque_uv, col);
+        _VtxWrite(&_VtxWritePtr[2], temp_points[i * 4 + 2], opaque_uv, col);
+        _VtxWrite(&_VtxWritePtr[3], temp_points[i * 4 + 3], opaque_uv,
+                  col_trans);
         _VtxWritePtr += 4;
       }
     }
@@ -1189,22 +1158,10 @@ void DrawList::AddPolyline(const Vec2 *points, const int points_count,
       dx *= (thickness * 0.5f);
       dy *= (thickness * 0.5f);
 
-      _VtxWritePtr[0].pos.x = p1.x + dy;
-      _VtxWritePtr[0].pos.y = p1.y - dx;
-      _VtxWritePtr[0].uv = opaque_uv;
-      _VtxWritePtr[0].col = col;
-      _VtxWritePtr[1].pos.x = p2.x + dy;
-      _VtxWritePtr[1].pos.y = p2.y - dx;
-      _VtxWritePtr[1].uv = opaque_uv;
-      _VtxWritePtr[1].col = col;
-      _VtxWritePtr[2].pos.x = p2.x - dy;
-      _VtxWritePtr[2].pos.y = p2.y + dx;
-      _VtxWritePtr[2].uv = opaque_uv;
-      _VtxWritePtr[2].col = col;
-      _VtxWritePtr[3].pos.x = p1.x - dy;
-      _VtxWritePtr[3].pos.y = p1.y + dx;
-      _VtxWritePtr[3].uv = opaque_uv;
-      _VtxWritePtr[3].col = col;
+      _VtxWrite(&_VtxWritePtr[0], Vec2(p1.x + dy, p1.y - dx), opaque_uv, col);
+      _VtxWrite(&_VtxWritePtr[1], Vec2(p2.x + dy, p2.y - dx), opaque_uv, col);
+      _VtxWrite(&_VtxWritePtr[2], Vec2(p2.x - dy, p2.y + dx), opaque_uv, col);
+      _VtxWrite(&_VtxWritePtr[3], Vec2(p1.x - dy, p1.y + dx), opaque_uv, col);
       _VtxWritePtr += 4;
 
       _IdxWritePtr[0] = (DrawIdx)(_VtxCurrentIdx);
@@ -1273,14 +1230,12 @@ void DrawList::AddConvexPolyFilled(const Vec2 *points, const int points_count,
       dm_y *= AA_SIZE * 0.5f;
 
       // Add vertices
-      _VtxWritePtr[0].pos.x = (points[i1].x - dm_x);
-      _VtxWritePtr[0].pos.y = (points[i1].y - dm_y);
-      _VtxWritePtr[0].uv = uv;
-      _VtxWritePtr[0].col = col; // Inner
-      _VtxWritePtr[1].pos.x = (points[i1].x + dm_x);
-      _VtxWritePtr[1].pos.y = (points[i1].y + dm_y);
-      _VtxWritePtr[1].uv = uv;
-      _VtxWritePtr[1].col = col_trans; // Outer
+      _VtxWrite(&_VtxWritePtr[0],
+                Vec2((points[i1].x - dm_x), (points[i1].y - dm_y)), uv,
+                col); // Inner
+      _VtxWrite(&_VtxWritePtr[1],
+                Vec2((points[i1].x + dm_x), (points[i1].y + dm_y)), uv,
+                col_trans); // Outer
       _VtxWritePtr += 2;
 
       // Add indexes for fringes
@@ -1299,9 +1254,7 @@ void DrawList::AddConvexPolyFilled(const Vec2 *points, const int points_count,
     const int vtx_count = points_count;
     PrimReserve(idx_count, vtx_count);
     for (int i = 0; i < vtx_count; i++) {
-      _VtxWritePtr[0].pos = points[i];
-      _VtxWritePtr[0].uv = uv;
-      _VtxWritePtr[0].col = col;
+      _VtxWrite(&_VtxWritePtr[0], points[i], uv, col);
       _VtxWritePtr++;
     }
     for (int i = 2; i < points_count; i++) {
@@ -1640,28 +1593,25 @@ with DrawFlags_RoundCornersNone or use 'float rounding = 0.0f' #endif
   return flags;
 }
 
+// Clamp rounding so that the corners of a side don't overlap
+static inline float ClampRectRounding(const Vec2 &a, const Vec2 &b,
+                                      float rounding, int flags) {
+  const bool full_x =
+      ((flags & DrawFlags_RoundCornersTop) == DrawFlags_RoundCornersTop) ||
+      ((flags & DrawFlags_RoundCornersBottom) == DrawFlags_RoundCornersBottom);
+  const bool full_y =
+      ((flags & DrawFlags_RoundCornersLeft) == DrawFlags_RoundCornersLeft) ||
+      ((flags & DrawFlags_RoundCornersRight) == DrawFlags_RoundCornersRight);
+  rounding = Min(rounding, Fabs(b.x - a.x) * (full_x ? 0.5f : 1.0f) - 1.0f);
+  rounding = Min(rounding, Fabs(b.y - a.y) * (full_y ? 0.5f : 1.0f) - 1.0f);
+  return rounding;
+}
+
 void DrawList::PathRect(const Vec2 &a, const Vec2 &b, float rounding,
                         int flags) {
   if (rounding >= 0.5f) {
     flags = FixRectCornerFlags(flags);
-    rounding = Min(rounding,
-                   Fabs(b.x - a.x) *
-                           (((flags & DrawFlags_RoundCornersTop) ==
-                             DrawFlags_RoundCornersTop) ||
-                                    ((flags & DrawFlags_RoundCornersBottom) ==
-                                     DrawFlags_RoundCornersBottom)
-                                ? 0.5f
-                                : 1.0f) -
-                       1.0f);
-    rounding =
-        Min(rounding,
-            Fabs(b.y - a.y) * (((flags & DrawFlags_RoundCornersLeft) ==
-                                DrawFlags_RoundCornersLeft) ||
-                                       ((flags & DrawFlags_RoundCornersRight) ==
-                                        DrawFlags_RoundCornersRight)
-                                   ? 0.5f
-                                   : 1.0f) -
-                1.0f);
+    rounding = ClampRectRounding(a, b, rounding, flags);
   }
   if (rounding < 0.5f ||
       (flags & DrawFlags_RoundCornersMask_) == DrawFlags_RoundCornersNone) {
@@ -1689,6 +1639,60 @@ void DrawList::PathRect(const Vec2 &a, const Vec2 &b, float rounding,
   }
 }
 
+#ifdef USE_DRAWVERT_SDF
+// Emit a rounded rectangle as a single quad whose coverage is evaluated by the
+// renderer (see DrawVert::sdf). 'rounding' must already be clamped to the
+// rectangle size, 'thickness' is 0.0f for a filled shape. Return false when
+// the shape can't be encoded: the caller then tessellates it as usual.
+bool DrawList::_AddSdfRect(const Vec2 &p_min, const Vec2 &p_max,
+                           float rounding, int flags, float thickness,
+                           unsigned int col) {
+  const int aa_flag = (thickness > 0.0f) ? DrawListFlags_AntiAliasedLines
+                                         : DrawListFlags_AntiAliasedFill;
+  if (!(Flags & DrawListFlags_SdfShapes) || !(Flags & aa_flag) ||
+      _FringeScale != 1.0f)
+    return false;
+  const Vec2 half_size = (p_max - p_min) * 0.5f;
+  if (half_size.x < 1.0f || half_size.y < 1.0f)
+    return false;
+
+  // Quantize to the vertex encoding
+  const int size_x = (int)(half_size.x * DRAWVERT_SDF_SCALE + 0.5f);
+  const int size_y = (int)(half_size.y * DRAWVERT_SDF_SCALE + 0.5f);
+  const int radius = (int)(Max(rounding, 0.0f) * DRAWVERT_SDF_SCALE + 0.5f);
+  const int width = (int)(thickness * DRAWVERT_SDF_SCALE + 0.5f);
+  if (size_x > 0xFFFF || size_y > 0xFFFF || radius > 0x0FFF ||
+      radius > Min(size_x, size_y) || width > 0xFFFF ||
+      (thickness > 0.0f && width == 0))
+    return false;
+  STATIC_assert(DrawFlags_RoundCornersTopRight ==
+                    DrawFlags_RoundCornersTopLeft << 1 &&
+                DrawFlags_RoundCornersBottomLeft ==
+                    DrawFlags_RoundCornersTopLeft << 2 &&
+                DrawFlags_RoundCornersBottomRight ==
+                    DrawFlags_RoundCornersTopLeft << 3);
+  const int corners = (radius > 0) ? (flags & DrawFlags_RoundCornersAll) /
+                                         DrawFlags_RoundCornersTopLeft
+                                   : 0;
+
+  // The quad covers the outline and 1 pixel of anti-aliasing margin
+  const float margin = (float)width * (0.5f / DRAWVERT_SDF_SCALE) + 1.0f;
+  const Vec2 center = (p_min + p_max) * 0.5f;
+  const Vec2 extent((float)size_x / DRAWVERT_SDF_SCALE + margin,
+                    (float)size_y / DRAWVERT_SDF_SCALE + margin);
+  PrimReserve(6, 4);
+  PrimRectUV(center - extent, center + extent, Vec2(0.0f, 0.0f),
+             Vec2(1.0f, 1.0f), col);
+  for (DrawVert *vtx = _VtxWritePtr - 4; vtx < _VtxWritePtr; vtx++) {
+    vtx->sdf[0] = (unsigned short)size_x;
+    vtx->sdf[1] = (unsigned short)size_y;
+    vtx->sdf[2] = (unsigned short)(radius | (corners << 12));
+    vtx->sdf[3] = (unsigned short)width;
+  }
+  return true;
+}
+#endif
+
 void DrawList::AddLine(const Vec2 &p1, const Vec2 &p2, unsigned int col,
                        float thickness) {
   if ((col & COL32_A_MASK) == 0)
@@ -1704,6 +1708,16 @@ void DrawList::AddRect(const Vec2 &p_min, const Vec2 &p_max, unsigned int col,
                        float rounding, int flags, float thickness) {
   if ((col & COL32_A_MASK) == 0)
     return;
+#ifdef USE_DRAWVERT_SDF
+  if (rounding >= 0.5f && thickness > 0.0f) {
+    flags = FixRectCornerFlags(flags);
+    const Vec2 a = p_min + Vec2(0.50f, 0.50f), b = p_max - Vec2(0.50f, 0.50f);
+    if ((flags & DrawFlags_RoundCornersMask_) != DrawFlags_RoundCornersNone &&
+        _AddSdfRect(a, b, ClampRectRounding(a, b, rounding, flags), flags,
+                    thickness, col))
+      return;
+  }
+#endif
   if (Flags & DrawListFlags_AntiAliasedLines)
     PathRect(p_min + Vec2(0.50f, 0.50f), p_max - Vec2(0.50f, 0.50f), rounding,
              flags);
@@ -1723,6 +1737,13 @@ void DrawList::AddRectFilled(const Vec2 &p_min, const Vec2 &p_max,
     PrimReserve(6, 4);
     PrimRect(p_min, p_max, col);
   } else {
+#ifdef USE_DRAWVERT_SDF
+    flags = FixRectCornerFlags(flags);
+    if (_AddSdfRect(p_min, p_max,
+                    ClampRectRounding(p_min, p_max, rounding, flags), flags,
+                    0.0f, col))
+      return;
+#endif
     PathRect(p_min, p_max, rounding, flags);
     PathFillConvex(col);
   }
@@ -1803,6 +1824,15 @@ void DrawList::AddCircle(const Vec2 &center, float radius, unsigned int col,
   if ((col & COL32_A_MASK) == 0 || radius < 0.5f)
     return;
 
+#ifdef USE_DRAWVERT_SDF
+  const float sdf_radius = radius - 0.5f;
+  if (num_segments <= 0 && thickness > 0.0f &&
+      _AddSdfRect(center - Vec2(sdf_radius, sdf_radius),
+                  center + Vec2(sdf_radius, sdf_radius), sdf_radius,
+                  DrawFlags_RoundCornersAll, thickness, col))
+    return;
+#endif
+
   if (num_segments <= 0) {
     // Use arc with automatic segment count
     _PathArcToFastEx(center, radius - 0.5f, 0, DRAWLIST_ARCFAST_SAMPLE_MAX, 0);
@@ -1827,6 +1857,13 @@ void DrawList::AddCircleFilled(const Vec2 &center, float radius,
   if ((col & COL32_A_MASK) == 0 || radius < 0.5f)
     return;
 
+#ifdef USE_DRAWVERT_SDF
+  if (num_segments <= 0 &&
+      _AddSdfRect(center - Vec2(radius, radius), center + Vec2(radius, radius),
+                  radius, DrawFlags_RoundCornersAll, 0.0f, col))
+    return;
+#endif
+
   if (num_segments <= 0) {
     // Use arc with automatic segment count
     _PathArcToFastEx(center, radius, 0, DRAWLIST_ARCFAST_SAMPLE_MAX, 0);
@@ -1977,18 +2014,39 @@ void DrawList::AddText(const Vec2 &pos, unsigned int col,
   AddText(NULL, 0.0f, pos, col, text_begin, text_end);
 }
 
+// Redirect a user image registered in io.Images to its page of the atlas,
+// remapping its texture coordinates into the image sub-rectangle.
+static void DrawListRemapAtlasImage(const Gui::ImageAtlas *atlas,
+                                    TextureID *tex_id, Vec2 *uv,
+                                    int uv_count) {
+  const Gui::ImageAtlasImage *image = atlas->FindImage(*tex_id);
+  if (image == NULL || !image->IsPacked())
+    return;
+  const TextureID page_tex_id = atlas->Pages[image->PageIndex].TexID;
+  if (page_tex_id == TextureID())
+    return; // Page not uploaded yet
+  *tex_id = page_tex_id;
+  const Vec2 uv_scale = image->Uv1 - image->Uv0;
+  for (int n = 0; n < uv_count; n++)
+    uv[n] = image->Uv0 + uv[n] * uv_scale;
+}
+
 void DrawList::AddImage(TextureID user_texture_id, const Vec2 &p_min,
                         const Vec2 &p_max, const Vec2 &uv_min,
                         const Vec2 &uv_max, unsigned int col) {
   if ((col & COL32_A_MASK) == 0)
     return;
 
+  Vec2 uv[2] = {uv_min, uv_max};
+  if (_Data->Images)
+    DrawListRemapAtlasImage(_Data->Images, &user_texture_id, uv, 2);
+
   const bool push_texture_id = user_texture_id != _CmdHeader.TextureId;
   if (push_texture_id)
     PushTextureID(user_texture_id);
 
   PrimReserve(6, 4);
-  PrimRectUV(p_min, p_max, uv_min, uv_max, col);
+  PrimRectUV(p_min, p_max, uv[0], uv[1], col);
 
   if (push_texture_id)
     PopTextureID();
@@ -2001,12 +2059,16 @@ void DrawList::AddImageQuad(TextureID user_texture_id, const Vec2 &p1,
   if ((col & COL32_A_MASK) == 0)
     return;
 
+  Vec2 uv[4] = {uv1, uv2, uv3, uv4};
+  if (_Data->Images)
+    DrawListRemapAtlasImage(_Data->Images, &user_texture_id, uv, 4);
+
   const bool push_texture_id = user_texture_id != _CmdHeader.TextureId;
   if (push_texture_id)
     PushTextureID(user_texture_id);
 
   PrimReserve(6, 4);
-  PrimQuadUV(p1, p2, p3, p4, uv1, uv2, uv3, uv4, col);
+  PrimQuadUV(p1, p2, p3, p4, uv[0], uv[1], uv[2], uv[3], col);
 
   if (push_texture_id)
     PopTextureID();
@@ -2026,6 +2088,10 @@ void DrawList::AddImageRounded(TextureID user_texture_id, const Vec2 &p_min,
     return;
   }
 
+  Vec2 uv[2] = {uv_min, uv_max};
+  if (_Data->Images)
+    DrawListRemapAtlasImage(_Data->Images, &user_texture_id, uv, 2);
+
   const bool push_texture_id = user_texture_id != _CmdHeader.TextureId;
   if (push_texture_id)
     PushTextureID(user_texture_id);
@@ -2035,7 +2101,7 @@ void DrawList::AddImageRounded(TextureID user_texture_id, const Vec2 &p_min,
   PathFillConvex(col);
   int vert_end_idx = VtxBuffer.Size;
   Gui::ShadeVertsLinearUV(this, vert_start_idx, vert_end_idx, p_min, p_max,
-                          uv_min, uv_max, true);
+                          uv[0], uv[1], true);
 
   if (push_texture_id)
     PopTextureID();
@@ -2060,6 +2126,8 @@ void DrawListSplitter::ClearFreeMemory() {
   _Current = 0;
   _Count = 1;
   _Channels.clear();
+  _MergeCmds.clear();
+  _MergeCmdsRemap.clear();
 }
 
 void DrawListSplitter::Split(DrawList *draw_list, int channels_count) {
@@ -2092,6 +2160,13 @@ void DrawListSplitter::Split(DrawList *draw_list, int channels_count) {
   }
 }
 
+// Returns true when the two clip rectangles share at least one pixel, in which
+// case the draw order of the commands using them must be preserved.
+static inline bool DrawCmd_ClipRectOverlap(const DrawCmd *a, const DrawCmd *b) {
+  return a->ClipRect.x < b->ClipRect.z && b->ClipRect.x < a->ClipRect.z &&
+         a->ClipRect.y < b->ClipRect.w && b->ClipRect.y < a->ClipRect.w;
+}
+
 void DrawListSplitter::Merge(DrawList *draw_list) {
   // Note that we never use or rely on _Channels.Size because it is merely a
   // buffer that we never shrink back to 0 to keep all sub-buffers ready for
@@ -2102,68 +2177,106 @@ void DrawListSplitter::Merge(DrawList *draw_list) {
   SetCurrentChannel(draw_list, 0);
   draw_list->_PopUnusedDrawCmd();
 
-  // Calculate our final buffer sizes. Also fix the incorrect IdxOffset values
-  // in each command.
-  int new_cmd_buffer_count = 0;
+  // 1. Assign every command of channels 1+ to a destination command, in a
+  // single pass and without touching the channel buffers.
+  // - A command is folded into the last destination command when their
+  // headers match (same as a regular DrawList would do).
+  // - Otherwise we look further back for a destination command with the same
+  // header. Moving a command before others is only valid if their clip
+  // rectangles don't overlap (they can't touch the same pixels), and never
+  // across a callback (it may alter the render state).
+  // Destination 0 stands for the last command already in the draw list, its
+  // ElemCount only counts the indices we are going to append to it.
+  // Do not include DrawCmd_AreSequentialIdxOffset() in the compare as we
+  // rebuild IdxOffset values ourselves. Manipulating IdxOffset (e.g. by
+  // reordering draw commands like done by RenderDimmedBackgroundBehindWindow())
+  // is not supported within a splitter.
+  Vector<DrawCmd> &dst_cmds = _MergeCmds;
+  Vector<int> &src_to_dst = _MergeCmdsRemap;
+  dst_cmds.resize(0);
+  src_to_dst.resize(0);
+  const bool has_host_cmd = (draw_list->CmdBuffer.Size > 0);
+  if (has_host_cmd) {
+    dst_cmds.push_back(draw_list->CmdBuffer.back());
+    dst_cmds.back().ElemCount = 0;
+  }
   int new_idx_buffer_count = 0;
-  DrawCmd *last_cmd = (_Count > 0 && draw_list->CmdBuffer.Size > 0)
-                          ? &draw_list->CmdBuffer.back()
-                          : NULL;
-  int idx_offset = last_cmd ? last_cmd->IdxOffset + last_cmd->ElemCount : 0;
   for (int i = 1; i < _Count; i++) {
     DrawChannel &ch = _Channels[i];
     if (ch._CmdBuffer.Size > 0 && ch._CmdBuffer.back().ElemCount == 0 &&
         ch._CmdBuffer.back().UserCallback ==
             NULL) // Equivalent of PopUnusedDrawCmd()
       ch._CmdBuffer.pop_back();
-
-    if (ch._CmdBuffer.Size > 0 && last_cmd != NULL) {
-      // Do not include DrawCmd_AreSequentialIdxOffset() in the compare as we
-      // rebuild IdxOffset values ourselves. Manipulating IdxOffset (e.g. by
-      // reordering draw commands like done by
-      // RenderDimmedBackgroundBehindWindow()) is not supported within a
-      // splitter.
-      DrawCmd *next_cmd = &ch._CmdBuffer[0];
-      if (DrawCmd_HeaderCompare(last_cmd, next_cmd) == 0 &&
-          last_cmd->UserCallback == NULL && next_cmd->UserCallback == NULL) {
-        // Merge previous channel last draw command with current channel first
-        // draw command if matching.
-        last_cmd->ElemCount += next_cmd->ElemCount;
-        idx_offset += next_cmd->ElemCount;
-        ch._CmdBuffer.erase(
-            ch._CmdBuffer.Data); // FIXME-OPT: Improve for multiple merges.
-      }
-    }
-    if (ch._CmdBuffer.Size > 0)
-      last_cmd = &ch._CmdBuffer.back();
-    new_cmd_buffer_count += ch._CmdBuffer.Size;
     new_idx_buffer_count += ch._IdxBuffer.Size;
+
     for (int cmd_n = 0; cmd_n < ch._CmdBuffer.Size; cmd_n++) {
-      ch._CmdBuffer.Data[cmd_n].IdxOffset = idx_offset;
-      idx_offset += ch._CmdBuffer.Data[cmd_n].ElemCount;
+      const DrawCmd *src_cmd = &ch._CmdBuffer.Data[cmd_n];
+      int dst_n = -1;
+      if (src_cmd->UserCallback == NULL)
+        for (int n = dst_cmds.Size - 1; n >= 0; n--) {
+          const DrawCmd *dst_cmd = &dst_cmds.Data[n];
+          if (dst_cmd->UserCallback != NULL)
+            break;
+          if (DrawCmd_HeaderCompare(dst_cmd, src_cmd) == 0) {
+            dst_n = n;
+            break;
+          }
+          if (DrawCmd_ClipRectOverlap(dst_cmd, src_cmd))
+            break;
+        }
+      if (dst_n == -1) {
+        dst_n = dst_cmds.Size;
+        dst_cmds.push_back(*src_cmd);
+        dst_cmds.back().ElemCount = 0;
+      }
+      dst_cmds.Data[dst_n].ElemCount += src_cmd->ElemCount;
+      src_to_dst.push_back(dst_n);
     }
   }
-  draw_list->CmdBuffer.resize(draw_list->CmdBuffer.Size + new_cmd_buffer_count);
+
+  // 2. Calculate final offsets of each destination command. ElemCount is
+  // reset and used as a write cursor by the copy below.
+  const int first_new_cmd = has_host_cmd ? 1 : 0;
+  const int new_cmd_buffer_count = dst_cmds.Size - first_new_cmd;
+  unsigned int idx_offset = (unsigned int)draw_list->IdxBuffer.Size;
+  for (int n = 0; n < dst_cmds.Size; n++) {
+    DrawCmd *dst_cmd = &dst_cmds.Data[n];
+    dst_cmd->IdxOffset = idx_offset;
+    idx_offset += dst_cmd->ElemCount;
+    dst_cmd->ElemCount = 0;
+  }
   draw_list->IdxBuffer.resize(draw_list->IdxBuffer.Size + new_idx_buffer_count);
 
-  // Write commands and indices in order (they are fairly small structures, we
-  // don't copy vertices only indices)
-  DrawCmd *cmd_write = draw_list->CmdBuffer.Data + draw_list->CmdBuffer.Size -
-                       new_cmd_buffer_count;
-  DrawIdx *idx_write = draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size -
-                       new_idx_buffer_count;
+  // 3. Write indices straight to their final location (they are fairly small
+  // structures, we don't copy vertices only indices)
+  DrawIdx *idx_buffer = draw_list->IdxBuffer.Data;
+  int src_cmd_n = 0;
   for (int i = 1; i < _Count; i++) {
     DrawChannel &ch = _Channels[i];
-    if (int sz = ch._CmdBuffer.Size) {
-      memcpy(cmd_write, ch._CmdBuffer.Data, sz * sizeof(DrawCmd));
-      cmd_write += sz;
-    }
-    if (int sz = ch._IdxBuffer.Size) {
-      memcpy(idx_write, ch._IdxBuffer.Data, sz * sizeof(DrawIdx));
-      idx_write += sz;
+    const DrawIdx *idx_read = ch._IdxBuffer.Data;
+    for (int cmd_n = 0; cmd_n < ch._CmdBuffer.Size; cmd_n++) {
+      const unsigned int elem_count = ch._CmdBuffer.Data[cmd_n].ElemCount;
+      DrawCmd *dst_cmd = &dst_cmds.Data[src_to_dst.Data[src_cmd_n++]];
+      if (elem_count > 0)
+        memcpy(idx_buffer + dst_cmd->IdxOffset + dst_cmd->ElemCount, idx_read,
+               elem_count * sizeof(DrawIdx));
+      dst_cmd->ElemCount += elem_count;
+      idx_read += elem_count;
     }
   }
-  draw_list->_IdxWritePtr = idx_write;
+  draw_list->_IdxWritePtr = draw_list->IdxBuffer.Data + idx_offset;
+
+  // 4. Write commands
+  if (has_host_cmd)
+    draw_list->CmdBuffer.back().ElemCount += dst_cmds.Data[0].ElemCount;
+  if (new_cmd_buffer_count > 0) {
+    draw_list->CmdBuffer.resize(draw_list->CmdBuffer.Size +
+                                new_cmd_buffer_count);
+    memcpy(draw_list->CmdBuffer.Data + draw_list->CmdBuffer.Size -
+               new_cmd_buffer_count,
+           dst_cmds.Data + first_new_cmd,
+           new_cmd_buffer_count * sizeof(DrawCmd));
+  }
 
   // Ensure there's always a non-callback draw command trailing the
   // command-buffer
@@ -2352,7 +2465,7 @@ void Gui::ShadeVertsLinearColorGradientKeepAlpha(
   const int col_delta_g = ((int)(col1 >> COL32_G_SHIFT) & 0xFF) - col0_g;
   const int col_delta_b = ((int)(col1 >> COL32_B_SHIFT) & 0xFF) - col0_b;
   for (DrawVert *vert = vert_start; vert < vert_end; vert++) {
-    float d = Dot(vert->pos - gradient_p0, gradient_extent);
+    float d = Dot(draw_list->_VtxGetPos(vert) - gradient_p0, gradient_extent);
     float t = Clamp(d * gradient_inv_length2, 0.0f, 1.0f);
     int r = (int)(col0_r + col_delta_r * t);
     int g = (int)(col0_g + col_delta_g * t);
@@ -2377,11 +2490,14 @@ void Gui::ShadeVertsLinearUV(DrawList *draw_list, int vert_start_idx,
     const Vec2 min = Min(uv_a, uv_b);
     const Vec2 max = Max(uv_a, uv_b);
     for (DrawVert *vertex = vert_start; vertex < vert_end; ++vertex)
-      vertex->uv = Clamp(
-          uv_a + Mul(Vec2(vertex->pos.x, vertex->pos.y) - a, scale), min, max);
+      draw_list->_VtxSetUV(
+          vertex,
+          Clamp(uv_a + Mul(draw_list->_VtxGetPos(vertex) - a, scale), min,
+                max));
   } else {
     for (DrawVert *vertex = vert_start; vertex < vert_end; ++vertex)
-      vertex->uv = uv_a + Mul(Vec2(vertex->pos.x, vertex->pos.y) - a, scale);
+      draw_list->_VtxSetUV(
+          vertex, uv_a + Mul(draw_list->_VtxGetPos(vertex) - a, scale));
   }
 }
 
@@ -2392,7 +2508,10 @@ void Gui::ShadeVertsTransformPos(DrawList *draw_list, int vert_start_idx,
   DrawVert *vert_start = draw_list->VtxBuffer.Data + vert_start_idx;
   DrawVert *vert_end = draw_list->VtxBuffer.Data + vert_end_idx;
   for (DrawVert *vertex = vert_start; vertex < vert_end; ++vertex)
-    vertex->pos = Rotate(vertex->pos - pivot_in, cos_a, sin_a) + pivot_out;
+    draw_list->_VtxSetPos(vertex,
+                          Rotate(draw_list->_VtxGetPos(vertex) - pivot_in,
+                                 cos_a, sin_a) +
+                              pivot_out);
 }
 
 //-----------------------------------------------------------------------------
@@ -3227,8 +3346,7 @@ static bool FontAtlasBuildWithStbTruetype(Gui::FontAtlas *atlas) {
 }
 
 const FontBuilderIO *FontAtlasGetBuilderForStbTruetype() {
-  static FontBuilderIO io;
-  io.FontBuilder_Build = FontAtlasBuildWithStbTruetype;
+  static const FontBuilderIO io = {FontAtlasBuildWithStbTruetype};
   return &io;
 }
 
@@ -3714,7 +3832,7 @@ const Wchar *FontAtlas::GetGlyphRangesChineseSimplifiedCommon() {
       6,  10,  3,   4,   48, 100, 6,   2,   16, 296, 5,   27,  387, 2,  2,   3,
       7,  16,  8,   5,   38, 15,  39,  21,  9,  10,  3,   7,   59,  13, 27,  21,
       47, 5,   21,  6};
-  static Wchar base_ranges[] = // not zero-terminated
+  static const Wchar base_ranges[] = // not zero-terminated
       {
           0x0020, 0x00FF, // Basic Latin + Latin Supplement
           0x2000, 0x206F, // General Punctuation
@@ -3723,17 +3841,20 @@ const Wchar *FontAtlas::GetGlyphRangesChineseSimplifiedCommon() {
           0xFF00, 0xFFEF, // Half-width characters
           0xFFFD, 0xFFFD  // Invalid
       };
-  static Wchar full_ranges[ARRAYSIZE(base_ranges) +
-                           ARRAYSIZE(accumulative_offsets_from_0x4E00) * 2 +
-                           1] = {0};
-  if (!full_ranges[0]) {
-    memcpy(full_ranges, base_ranges, sizeof(base_ranges));
-    UnpackAccumulativeOffsetsIntoRanges(
-        0x4E00, accumulative_offsets_from_0x4E00,
-        ARRAYSIZE(accumulative_offsets_from_0x4E00),
-        full_ranges + ARRAYSIZE(base_ranges));
-  }
-  return &full_ranges[0];
+  // Unpacked once, thread-safe initialization of the static
+  struct FullRanges {
+    Wchar Data[ARRAYSIZE(base_ranges) +
+               ARRAYSIZE(accumulative_offsets_from_0x4E00) * 2 + 1];
+    FullRanges() {
+      memcpy(Data, base_ranges, sizeof(base_ranges));
+      UnpackAccumulativeOffsetsIntoRanges(
+          0x4E00, accumulative_offsets_from_0x4E00,
+          ARRAYSIZE(accumulative_offsets_from_0x4E00),
+          Data + ARRAYSIZE(base_ranges));
+    }
+  };
+  static const FullRanges full_ranges;
+  return &full_ranges.Data[0];
 }
 
 const Wchar *FontAtlas::GetGlyphRangesJapanese() {
@@ -3955,7 +4076,7 @@ const Wchar *FontAtlas::GetGlyphRangesJapanese() {
       1,  1,  1,   1,  1,  1,  1,  1,   1,  1,  2,   1,  1,  1,   3,     2,
       1,  1,  1,   1,  2,  1,  1,
   };
-  static Wchar base_ranges[] = // not zero-terminated
+  static const Wchar base_ranges[] = // not zero-terminated
       {
           0x0020, 0x00FF, // Basic Latin + Latin Supplement
           0x3000, 0x30FF, // CJK Symbols and Punctuations, Hiragana, Katakana
@@ -3963,17 +4084,20 @@ const Wchar *FontAtlas::GetGlyphRangesJapanese() {
           0xFF00, 0xFFEF, // Half-width characters
           0xFFFD, 0xFFFD  // Invalid
       };
-  static Wchar full_ranges[ARRAYSIZE(base_ranges) +
-                           ARRAYSIZE(accumulative_offsets_from_0x4E00) * 2 +
-                           1] = {0};
-  if (!full_ranges[0]) {
-    memcpy(full_ranges, base_ranges, sizeof(base_ranges));
-    UnpackAccumulativeOffsetsIntoRanges(
-        0x4E00, accumulative_offsets_from_0x4E00,
-        ARRAYSIZE(accumulative_offsets_from_0x4E00),
-        full_ranges + ARRAYSIZE(base_ranges));
-  }
-  return &full_ranges[0];
+  // Unpacked once, thread-safe initialization of the static
+  struct FullRanges {
+    Wchar Data[ARRAYSIZE(base_ranges) +
+               ARRAYSIZE(accumulative_offsets_from_0x4E00) * 2 + 1];
+    FullRanges() {
+      memcpy(Data, base_ranges, sizeof(base_ranges));
+      UnpackAccumulativeOffsetsIntoRanges(
+          0x4E00, accumulative_offsets_from_0x4E00,
+          ARRAYSIZE(accumulative_offsets_from_0x4E00),
+          Data + ARRAYSIZE(base_ranges));
+    }
+  };
+  static const FullRanges full_ranges;
+  return &full_ranges.Data[0];
 }
 
 const Wchar *FontAtlas::GetGlyphRangesCyrillic() {
@@ -4564,6 +4688,9 @@ void Font::RenderText(DrawList *draw_list, float size, const Vec2 &pos,
   const int idx_expected_size = draw_list->IdxBuffer.Size + idx_count_max;
   draw_list->PrimReserve(idx_count_max, vtx_count_max);
   DrawVert *vtx_write = draw_list->_VtxWritePtr;
+#ifdef USE_DRAWVERT_COMPACT
+  const Vec2 vtx_origin = draw_list->VtxOrigin;
+#endif
   DrawIdx *idx_write = draw_list->_IdxWritePtr;
   unsigned int vtx_index = draw_list->_VtxCurrentIdx;
 
@@ -4658,6 +4785,37 @@ void Font::RenderText(DrawList *draw_list, float size, const Vec2 &pos,
         // We are NOT calling PrimRectUV() here because non-inlined causes too
         // much overhead in a debug builds. Inlined here:
         {
+#ifdef USE_DRAWVERT_COMPACT
+          // Encode each coordinate once, they are shared by two vertices
+          const signed short px1 = DrawList::_VtxPackPos(x1 - vtx_origin.x);
+          const signed short px2 = DrawList::_VtxPackPos(x2 - vtx_origin.x);
+          const signed short py1 = DrawList::_VtxPackPos(y1 - vtx_origin.y);
+          const signed short py2 = DrawList::_VtxPackPos(y2 - vtx_origin.y);
+          const unsigned short pu1 = DrawList::_VtxPackUV(u1);
+          const unsigned short pu2 = DrawList::_VtxPackUV(u2);
+          const unsigned short pv1 = DrawList::_VtxPackUV(v1);
+          const unsigned short pv2 = DrawList::_VtxPackUV(v2);
+          vtx_write[0].pos[0] = px1;
+          vtx_write[0].pos[1] = py1;
+          vtx_write[0].col = glyph_col;
+          vtx_write[0].uv[0] = pu1;
+          vtx_write[0].uv[1] = pv1;
+          vtx_write[1].pos[0] = px2;
+          vtx_write[1].pos[1] = py1;
+          vtx_write[1].col = glyph_col;
+          vtx_write[1].uv[0] = pu2;
+          vtx_write[1].uv[1] = pv1;
+          vtx_write[2].pos[0] = px2;
+          vtx_write[2].pos[1] = py2;
+          vtx_write[2].col = glyph_col;
+          vtx_write[2].uv[0] = pu2;
+          vtx_write[2].uv[1] = pv2;
+          vtx_write[3].pos[0] = px1;
+          vtx_write[3].pos[1] = py2;
+          vtx_write[3].col = glyph_col;
+          vtx_write[3].uv[0] = pu1;
+          vtx_write[3].uv[1] = pv2;
+#else
           vtx_write[0].pos.x = x1;
           vtx_write[0].pos.y = y1;
           vtx_write[0].col = glyph_col;
@@ -4678,6 +4836,13 @@ void Font::RenderText(DrawList *draw_list, float size, const Vec2 &pos,
           vtx_write[3].col = glyph_col;
           vtx_write[3].uv.x = u1;
           vtx_write[3].uv.y = v2;
+#endif
+#ifdef USE_DRAWVERT_SDF
+          DrawList::_VtxClearSdf(&vtx_write[0]);
+          DrawList::_VtxClearSdf(&vtx_write[1]);
+          DrawList::_VtxClearSdf(&vtx_write[2]);
+          DrawList::_VtxClearSdf(&vtx_write[3]);
+#endif
           idx_write[0] = (DrawIdx)(vtx_index);
           idx_write[1] = (DrawIdx)(vtx_index + 1);
           idx_write[2] = (DrawIdx)(vtx_index + 2);
@@ -4705,6 +4870,156 @@ void Font::RenderText(DrawList *draw_list, float size, const Vec2 &pos,
   draw_list->_VtxCurrentIdx = vtx_index;
 }
 } // namespace Gui
+
+//-----------------------------------------------------------------------------
+// [SECTION] ImageAtlas
+//-----------------------------------------------------------------------------
+
+namespace Gui {
+static int ImageAtlasHashTexID(TextureID tex_id) {
+  return HashData(&tex_id, sizeof(tex_id));
+}
+
+ImageAtlas::ImageAtlas() {
+  PageWidth = PageHeight = 1024;
+  ImageMaxSize = 256;
+  ImagePadding = 1;
+}
+
+ImageAtlas::~ImageAtlas() { Clear(); }
+
+int ImageAtlas::AddImage(TextureID tex_id, const unsigned char *pixels_rgba32,
+                         int width, int height) {
+  assert(pixels_rgba32 != NULL);
+  assert(width > 0 && width <= 0xFFFF && height > 0 && height <= 0xFFFF);
+  const int key = ImageAtlasHashTexID(tex_id);
+  assert(Map.GetInt(key, -1) == -1 &&
+         "TextureID was already added to the atlas!");
+
+  ImageAtlasImage image;
+  image.SourceTexID = tex_id;
+  image.Width = (unsigned short)width;
+  image.Height = (unsigned short)height;
+  image.Pixels = (unsigned int *)ALLOC((size_t)width * height * 4);
+  memcpy(image.Pixels, pixels_rgba32, (size_t)width * height * 4);
+  Images.push_back(image);
+  Map.SetInt(key, Images.Size - 1);
+  return Images.Size - 1;
+}
+
+const ImageAtlasImage *ImageAtlas::FindImage(TextureID tex_id) const {
+  const int index = Map.GetInt(ImageAtlasHashTexID(tex_id), -1);
+  if (index < 0 || !(Images[index].SourceTexID == tex_id))
+    return NULL;
+  return &Images[index];
+}
+
+bool ImageAtlas::Build() {
+  assert(PageWidth > 0 && PageHeight > 0 && ImagePadding >= 0);
+  ClearTexData();
+  Pages.clear();
+
+  // Rectangles to pack, including the padding around images
+  Vector<rect> pack_rects;
+  for (int i = 0; i < Images.Size; i++) {
+    ImageAtlasImage &image = Images[i];
+    image.PageIndex = -1;
+    rect r;
+    memset(&r, 0, sizeof(r));
+    r.id = i;
+    r.w = image.Width + ImagePadding * 2;
+    r.h = image.Height + ImagePadding * 2;
+    if (image.Pixels == NULL || image.Width > ImageMaxSize ||
+        image.Height > ImageMaxSize || r.w > PageWidth || r.h > PageHeight)
+      continue;
+    pack_rects.push_back(r);
+  }
+
+  // Fill pages one after another, with the images which didn't fit in the
+  // previous ones.
+  Vector<node> pack_nodes;
+  pack_nodes.resize(PageWidth);
+  while (pack_rects.Size > 0) {
+    context pack_context;
+    init_target(&pack_context, PageWidth, PageHeight, pack_nodes.Data,
+                pack_nodes.Size);
+    ::pack_rects(&pack_context, pack_rects.Data, pack_rects.Size);
+
+    ImageAtlasPage page;
+    memset(&page, 0, sizeof(page));
+    page.TexWidth = PageWidth;
+    int remaining_count = 0;
+    for (int n = 0; n < pack_rects.Size; n++) {
+      const rect &r = pack_rects[n];
+      if (!r.was_packed) {
+        pack_rects[remaining_count++] = r;
+        continue;
+      }
+      ImageAtlasImage &image = Images[r.id];
+      image.PageIndex = Pages.Size;
+      image.X = (unsigned short)(r.x + ImagePadding);
+      image.Y = (unsigned short)(r.y + ImagePadding);
+      page.TexHeight = Max(page.TexHeight, r.y + r.h);
+    }
+    assert(remaining_count < pack_rects.Size); // Any image fits an empty page
+    pack_rects.resize(remaining_count);
+
+    page.TexHeight = Min(UpperPowerOfTwo(page.TexHeight), PageHeight);
+    const size_t tex_size = (size_t)page.TexWidth * page.TexHeight * 4;
+    page.TexPixelsRGBA32 = (unsigned int *)ALLOC(tex_size);
+    memset(page.TexPixelsRGBA32, 0, tex_size);
+    Pages.push_back(page);
+  }
+
+  // Render images, repeating their edge pixels into the padding
+  for (ImageAtlasImage &image : Images) {
+    if (!image.IsPacked())
+      continue;
+    const ImageAtlasPage &page = Pages[image.PageIndex];
+    const int w = image.Width, h = image.Height;
+    for (int y = -ImagePadding; y < h + ImagePadding; y++) {
+      const unsigned int *src = image.Pixels + Clamp(y, 0, h - 1) * w;
+      unsigned int *dst =
+          page.TexPixelsRGBA32 + (image.Y + y) * page.TexWidth + image.X;
+      for (int x = -ImagePadding; x < 0; x++)
+        dst[x] = src[0];
+      memcpy(dst, src, (size_t)w * 4);
+      for (int x = w; x < w + ImagePadding; x++)
+        dst[x] = src[w - 1];
+    }
+    image.Uv0 = Vec2((float)image.X / page.TexWidth,
+                     (float)image.Y / page.TexHeight);
+    image.Uv1 = Vec2((float)(image.X + w) / page.TexWidth,
+                     (float)(image.Y + h) / page.TexHeight);
+  }
+  return true;
+}
+
+void ImageAtlas::ClearInputData() {
+  for (ImageAtlasImage &image : Images)
+    if (image.Pixels) {
+      FREE(image.Pixels);
+      image.Pixels = NULL;
+    }
+}
+
+void ImageAtlas::ClearTexData() {
+  for (ImageAtlasPage &page : Pages)
+    if (page.TexPixelsRGBA32) {
+      FREE(page.TexPixelsRGBA32);
+      page.TexPixelsRGBA32 = NULL;
+    }
+}
+
+void ImageAtlas::Clear() {
+  ClearInputData();
+  ClearTexData();
+  Pages.clear();
+  Images.clear();
+  Map.Clear();
+}
+} // namespace Gui
+
 //-----------------------------------------------------------------------------
 // [SECTION] Gui Internal Render Helpers
 //-----------------------------------------------------------------------------
@@ -5029,63 +5344,70 @@ static unsigned int decompress_length(const unsigned char *input) {
   return (input[8] << 24) + (input[9] << 16) + (input[10] << 8) + input[11];
 }
 
-static unsigned char *_barrier_out_e, *_barrier_out_b;
-static const unsigned char *_barrier_in_b;
-static unsigned char *_dout;
-static void _match(const unsigned char *data, unsigned int length) {
+// Decompressor state, on the stack of decompress() so that fonts can be
+// decompressed by several threads at the same time.
+struct decompress_state {
+  unsigned char *barrier_out_e, *barrier_out_b;
+  const unsigned char *barrier_in_b;
+  unsigned char *dout;
+};
+static void _match(decompress_state *s, const unsigned char *data,
+                   unsigned int length) {
   // INVERSE of memmove... write each byte before copying the next...
-  assert(_dout + length <= _barrier_out_e);
-  if (_dout + length > _barrier_out_e) {
-    _dout += length;
+  assert(s->dout + length <= s->barrier_out_e);
+  if (s->dout + length > s->barrier_out_e) {
+    s->dout += length;
     return;
   }
-  if (data < _barrier_out_b) {
-    _dout = _barrier_out_e + 1;
+  if (data < s->barrier_out_b) {
+    s->dout = s->barrier_out_e + 1;
     return;
   }
   while (length--)
-    *_dout++ = *data++;
+    *s->dout++ = *data++;
 }
 
-static void _lit(const unsigned char *data, unsigned int length) {
-  assert(_dout + length <= _barrier_out_e);
-  if (_dout + length > _barrier_out_e) {
-    _dout += length;
+static void _lit(decompress_state *s, const unsigned char *data,
+                 unsigned int length) {
+  assert(s->dout + length <= s->barrier_out_e);
+  if (s->dout + length > s->barrier_out_e) {
+    s->dout += length;
     return;
   }
-  if (data < _barrier_in_b) {
-    _dout = _barrier_out_e + 1;
+  if (data < s->barrier_in_b) {
+    s->dout = s->barrier_out_e + 1;
     return;
   }
-  memcpy(_dout, data, length);
-  _dout += length;
+  memcpy(s->dout, data, length);
+  s->dout += length;
 }
 
 #define _in2(x) ((i[x] << 8) + i[(x) + 1])
 #define _in3(x) ((i[x] << 16) + _in2((x) + 1))
 #define _in4(x) ((i[x] << 24) + _in3((x) + 1))
 
-static const unsigned char *decompress_token(const unsigned char *i) {
+static const unsigned char *decompress_token(decompress_state *s,
+                                            const unsigned char *i) {
   if (*i >= 0x20) { // use fewer if's for cases that expand small
     if (*i >= 0x80)
-      _match(_dout - i[1] - 1, i[0] - 0x80 + 1), i += 2;
+      _match(s, s->dout - i[1] - 1, i[0] - 0x80 + 1), i += 2;
     else if (*i >= 0x40)
-      _match(_dout - (_in2(0) - 0x4000 + 1), i[2] + 1), i += 3;
+      _match(s, s->dout - (_in2(0) - 0x4000 + 1), i[2] + 1), i += 3;
     else /* *i >= 0x20 */
-      _lit(i + 1, i[0] - 0x20 + 1), i += 1 + (i[0] - 0x20 + 1);
+      _lit(s, i + 1, i[0] - 0x20 + 1), i += 1 + (i[0] - 0x20 + 1);
   } else { // more ifs for cases that expand large, since overhead is amortized
     if (*i >= 0x18)
-      _match(_dout - (_in3(0) - 0x180000 + 1), i[3] + 1), i += 4;
+      _match(s, s->dout - (_in3(0) - 0x180000 + 1), i[3] + 1), i += 4;
     else if (*i >= 0x10)
-      _match(_dout - (_in3(0) - 0x100000 + 1), _in2(3) + 1), i += 5;
+      _match(s, s->dout - (_in3(0) - 0x100000 + 1), _in2(3) + 1), i += 5;
     else if (*i >= 0x08)
-      _lit(i + 2, _in2(0) - 0x0800 + 1), i += 2 + (_in2(0) - 0x0800 + 1);
+      _lit(s, i + 2, _in2(0) - 0x0800 + 1), i += 2 + (_in2(0) - 0x0800 + 1);
     else if (*i == 0x07)
-      _lit(i + 3, _in2(1) + 1), i += 3 + (_in2(1) + 1);
+      _lit(s, i + 3, _in2(1) + 1), i += 3 + (_in2(1) + 1);
     else if (*i == 0x06)
-      _match(_dout - (_in3(1) + 1), i[4] + 1), i += 5;
+      _match(s, s->dout - (_in3(1) + 1), i[4] + 1), i += 5;
     else if (*i == 0x04)
-      _match(_dout - (_in3(1) + 1), _in2(4) + 1), i += 6;
+      _match(s, s->dout - (_in3(1) + 1), _in2(4) + 1), i += 6;
   }
   return i;
 }
@@ -5128,19 +5450,21 @@ static unsigned int decompress(unsigned char *output, const unsigned char *i,
   if (_in4(4) != 0)
     return 0; // error! stream is > 4GB
   const unsigned int olen = decompress_length(i);
-  _barrier_in_b = i;
-  _barrier_out_e = output + olen;
-  _barrier_out_b = output;
+  decompress_state state;
+  decompress_state *s = &state;
+  s->barrier_in_b = i;
+  s->barrier_out_e = output + olen;
+  s->barrier_out_b = output;
   i += 16;
 
-  _dout = output;
+  s->dout = output;
   for (;;) {
     const unsigned char *old_i = i;
-    i = decompress_token(i);
+    i = decompress_token(s, i);
     if (i == old_i) {
       if (*i == 0x05 && i[1] == 0xfa) {
-        assert(_dout == output + olen);
-        if (_dout != output + olen)
+        assert(s->dout == output + olen);
+        if (s->dout != output + olen)
           return 0;
         if (adler32(1, output, olen) != (unsigned int)_in4(2))
           return 0;
@@ -5150,8 +5474,8 @@ static unsigned int decompress(unsigned char *output, const unsigned char *i,
         return 0;
       }
     }
-    assert(_dout <= output + olen);
-    if (_dout > output + olen)
+    assert(s->dout <= output + olen);
+    if (s->dout > output + olen)
       return 0;
   }
 }
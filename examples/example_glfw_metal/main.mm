@@ -105,6 +105,10 @@ int main(int, char **) {
   // Main loop
   while (!glfwWindowShouldClose(window)) {
     @autoreleasepool {
+      // Sleep until new events arrive while the UI is idle, or until its next
+      // animation or timer is due (see Gui::GetNextRedrawDeadline())
+      Glfw_WaitForEvents();
+
       // Poll and handle events (inputs, window resize, etc.)
       // You can read the io.WantCaptureMouse, io.WantCaptureKeyboard flags to
       // tell if gui wants to use your inputs.
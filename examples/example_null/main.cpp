@@ -1,37 +1,625 @@
-// gui: "null" example application
+// gui: "null" example application, used as a headless benchmark
 // (compile and link imgui, create context, run headless with NO INPUTS, NO
-// GRAPHICS OUTPUT) This is useful to test building, but you cannot interact
-// with anything here!
+// GRAPHICS OUTPUT) You cannot interact with anything here!
+// It runs scripted scenes through NewFrame()/Render() and reports, for each
+// scene: CPU time of each phase, vertices/indices/draw commands per frame,
+// allocations per frame and peak memory. Use --json to write the results in a
+// machine-readable format, to track performance regressions over time.
+// Usage:
+//   example_null [--frames N] [--scene NAME] [--software] [--threads N]
+//                [--json FILE|-] [--record FILE]
+//   --frames N    Measured frames per scene (default 100, after 10 warm-up
+//                 frames)
+//   --scene NAME  Only run scenes whose name contains NAME
+//   --software    Also rasterize each frame with backends/software.cpp
+//   --threads N   Stress test: run each scene on N threads at the same time,
+//                 one context per thread sharing a single font atlas.
+//                 Requires building with USE_THREAD_LOCAL_CONTEXT
+//                 (make WITH_THREAD_LOCAL_CONTEXT=1)
+//   --json FILE   Write results as JSON to FILE ('-' for stdout)
+//   --record FILE Record the draw data of all frames to FILE, to replay them
+//                 with misc/draw_stream/draw_stream_replay.cpp. Allocations
+//                 of the recorder are included in the allocation stats.
+#include "draw_stream.hpp"
 #include "gui.hpp"
+#include "software.hpp"
+#include <chrono>
+#include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
 
-int main(int, char **) {
-  CHECKVERSION();
-  Gui::CreateContext();
+//-----------------------------------------------------------------------------
+// Allocation tracking
+//-----------------------------------------------------------------------------
+
+// Every allocation made by the library goes through those functions. We store
+// the size in front of each block to track the current and peak memory usage.
+// The allocator user data points to the BenchAllocStats to update: with
+// USE_THREAD_LOCAL_CONTEXT each thread sets its own.
+struct BenchAllocStats {
+  long long AllocCount;
+  long long AllocBytes;
+  long long CurrentBytes;
+  long long PeakBytes;
+};
+static BenchAllocStats g_AllocStats;
+
+static const size_t BENCH_ALLOC_HEADER = 16; // Keep 16-byte alignment
+
+static void *BenchMemAlloc(size_t size, void *user_data) {
+  BenchAllocStats *stats = (BenchAllocStats *)user_data;
+  char *ptr = (char *)malloc(size + BENCH_ALLOC_HEADER);
+  if (ptr == nullptr)
+    return nullptr;
+  *(size_t *)ptr = size;
+  stats->AllocCount++;
+  stats->AllocBytes += (long long)size;
+  stats->CurrentBytes += (long long)size;
+  if (stats->CurrentBytes > stats->PeakBytes)
+    stats->PeakBytes = stats->CurrentBytes;
+  return ptr + BENCH_ALLOC_HEADER;
+}
+
+static void BenchMemFree(void *ptr, void *user_data) {
+  BenchAllocStats *stats = (BenchAllocStats *)user_data;
+  if (ptr == nullptr)
+    return;
+  char *block = (char *)ptr - BENCH_ALLOC_HEADER;
+  stats->CurrentBytes -= (long long)*(size_t *)block;
+  free(block);
+}
+
+//-----------------------------------------------------------------------------
+// Recording
+//-----------------------------------------------------------------------------
+
+// With --record, the draw data of every frame (including warm-up frames) is
+// appended to the file. Each scene starts with the font atlas of its context.
+static FILE *g_RecordFile = nullptr;
+static DrawStreamWriter *g_RecordWriter = nullptr;
+
+static void RecordFrame(int frame) {
+  if (frame == 0)
+    g_RecordWriter->WriteFontAtlas(Gui::GetIO().Fonts);
+  g_RecordWriter->WriteFrame(Gui::GetDrawData());
+  fwrite(g_RecordWriter->Buffer.Data, 1, (size_t)g_RecordWriter->Buffer.Size,
+         g_RecordFile);
+  g_RecordWriter->Buffer.resize(0);
+}
+
+//-----------------------------------------------------------------------------
+// Scenes
+//-----------------------------------------------------------------------------
+
+// Each scene submits its UI for one frame. 'frame' increases every frame so
+// scenes can animate (e.g. scroll) to avoid measuring a static layout only.
+// Scenes keeping static data use thread_local so that --threads can run them.
+struct BenchScene {
+  const char *Name;
+  void (*Submit)(int frame);
+  int ConfigFlags;
+  bool ThreadSafe; // false: skipped by --threads (e.g. demo code uses statics)
+};
+
+static void SceneDemo(int) {
+  Gui::ShowDemoWindow(nullptr);
+  Gui::ShowMetricsWindow(nullptr);
+}
+
+static void SceneTableHuge(int frame) {
+  const int ROWS_COUNT = 1000000;
+  const int COLUMNS_COUNT = 12;
+  Gui::SetNextWindowPos(Vec2(0, 0));
+  Gui::SetNextWindowSize(Gui::GetIO().DisplaySize);
+  Gui::Begin("Huge table", nullptr, WindowFlags_NoSavedSettings);
+  const int flags = TableFlags_ScrollY | TableFlags_ScrollX |
+                    TableFlags_RowBg | TableFlags_Borders |
+                    TableFlags_Resizable | TableFlags_Reorderable |
+                    TableFlags_Hideable | TableFlags_Sortable;
+  if (Gui::BeginTable("table", COLUMNS_COUNT, flags)) {
+    Gui::TableSetupScrollFreeze(1, 1);
+    for (int column_n = 0; column_n < COLUMNS_COUNT; column_n++) {
+      char label[32];
+      snprintf(label, sizeof(label), "Column %d", column_n);
+      Gui::TableSetupColumn(label);
+    }
+    Gui::TableHeadersRow();
+    ListClipper clipper;
+    clipper.Begin(ROWS_COUNT);
+    while (clipper.Step())
+      for (int row_n = clipper.DisplayStart; row_n < clipper.DisplayEnd;
+           row_n++) {
+        Gui::TableNextRow();
+        for (int column_n = 0; column_n < COLUMNS_COUNT; column_n++) {
+          Gui::TableSetColumnIndex(column_n);
+          if (column_n == 0)
+            Gui::Text("Row %d", row_n);
+          else
+            Gui::Text("%d,%d %.3f", column_n, row_n,
+                      (float)(row_n * column_n) * 0.001f);
+        }
+      }
+    Gui::SetScrollY((float)(frame * 97 % ROWS_COUNT) *
+                    Gui::GetTextLineHeightWithSpacing());
+    Gui::EndTable();
+  }
+  Gui::End();
+}
+
+// Property inspector: hundreds of Drag/Slider/Input widgets, dominated by the
+// formatting of their values. Build with DISABLE_FAST_DATATYPE_FORMAT to
+// compare with formatting through vsnprintf().
+static void SceneInspector(int frame) {
+  const int ROWS_COUNT = 10000;
+  Gui::SetNextWindowPos(Vec2(0, 0));
+  Gui::SetNextWindowSize(Gui::GetIO().DisplaySize);
+  Gui::Begin("Inspector", nullptr, WindowFlags_NoSavedSettings);
+  const int flags = TableFlags_ScrollY | TableFlags_RowBg | TableFlags_Borders;
+  if (Gui::BeginTable("properties", 4, flags)) {
+    ListClipper clipper;
+    clipper.Begin(ROWS_COUNT);
+    while (clipper.Step())
+      for (int row_n = clipper.DisplayStart; row_n < clipper.DisplayEnd;
+           row_n++) {
+        const float t = (float)(row_n + frame) * 0.37f;
+        float position[4] = {t * 3.1f, -t * 0.7f, t * 1000.3f, 1.0f / t};
+        float scale[3] = {sinf(t), cosf(t), t * 0.01f};
+        int count = (row_n * 7919 + frame) % 1000;
+        double mass = (double)t * 1.0e-3;
+        Gui::PushID(row_n);
+        Gui::TableNextRow();
+        Gui::TableNextColumn();
+        Gui::SetNextItemWidth(-FLT_MIN);
+        Gui::DragFloat4("##position", position);
+        Gui::TableNextColumn();
+        Gui::SetNextItemWidth(-FLT_MIN);
+        Gui::DragFloat3("##scale", scale, 0.01f, 0.0f, 0.0f, "%.2f");
+        Gui::TableNextColumn();
+        Gui::SetNextItemWidth(-FLT_MIN);
+        Gui::SliderInt("##count", &count, 0, 1000, "%d items");
+        Gui::TableNextColumn();
+        Gui::SetNextItemWidth(-FLT_MIN);
+        Gui::InputDouble("##mass", &mass, 0.0, 0.0, "%g");
+        Gui::PopID();
+      }
+    Gui::SetScrollY((float)(frame * 97 % ROWS_COUNT) *
+                    Gui::GetFrameHeightWithSpacing());
+    Gui::EndTable();
+  }
+  Gui::End();
+}
+
+static void SceneTreeDeepRec(int depth, int max_depth) {
+  for (int n = 0; n < 3; n++) {
+    Gui::PushID(n);
+    Gui::SetNextItemOpen(true, Cond_Always);
+    if (depth < max_depth && Gui::TreeNode("Node", "Node %d.%d", depth, n)) {
+      Gui::Text("Leaf at depth %d", depth);
+      SceneTreeDeepRec(depth + 1, max_depth);
+      Gui::TreePop();
+    }
+    Gui::PopID();
+  }
+}
+
+static void SceneTreeDeep(int frame) {
+  Gui::SetNextWindowPos(Vec2(0, 0));
+  Gui::SetNextWindowSize(Gui::GetIO().DisplaySize);
+  Gui::Begin("Deep tree", nullptr, WindowFlags_NoSavedSettings);
+  SceneTreeDeepRec(0, 8); // 3^8 nodes, mostly clipped
+  Gui::SetScrollY((float)(frame * 331) * Gui::GetTextLineHeightWithSpacing());
+  Gui::End();
+}
+
+static void SceneManyWindows(int frame) {
+  const int WINDOWS_COUNT = 2000;
+  const Vec2 display_size = Gui::GetIO().DisplaySize;
+  for (int n = 0; n < WINDOWS_COUNT; n++) {
+    char name[32];
+    snprintf(name, sizeof(name), "Window %d", n);
+    Gui::SetNextWindowPos(Vec2(fmodf((float)(n * 37 + frame), display_size.x),
+                               fmodf((float)(n * 53), display_size.y)));
+    Gui::SetNextWindowSize(Vec2(200, 100));
+    Gui::Begin(name, nullptr, WindowFlags_NoSavedSettings);
+    Gui::Text("Window %d", n);
+    Gui::Button("Button");
+    Gui::End();
+  }
+}
+
+static void SceneLongText(int frame) {
+  static thread_local std::vector<char> text;
+  if (text.empty()) {
+    const char *words[] = {"lorem", "ipsum", "dolor", "sit", "amet",
+                           "consectetur", "adipiscing", "elit"};
+    for (int n = 0; text.size() < 4 * 1024 * 1024; n++) {
+      const char *word = words[(n * 7) % 8];
+      text.insert(text.end(), word, word + strlen(word));
+      text.push_back((n % 12) == 11 ? '\n' : ' ');
+    }
+    text.push_back(0);
+  }
+  Gui::SetNextWindowPos(Vec2(0, 0));
+  Gui::SetNextWindowSize(Gui::GetIO().DisplaySize);
+  Gui::Begin("Long text", nullptr, WindowFlags_NoSavedSettings);
+  Gui::TextWrapped("%.*s", 64 * 1024, text.data()); // Wrapped paragraph
+  Gui::TextUnformatted(text.data(), text.data() + text.size() - 1);
+  Gui::SetScrollY((float)(frame * 1013) * Gui::GetTextLineHeight());
+  Gui::End();
+}
+
+static void SceneDocking(int) {
+  const int dockspace_id = Gui::DockSpaceOverViewport();
+  for (int n = 0; n < 64; n++) {
+    char name[32];
+    snprintf(name, sizeof(name), "Docked %d", n);
+    Gui::SetNextWindowDockID(dockspace_id, Cond_FirstUseEver);
+    Gui::Begin(name);
+    for (int line_n = 0; line_n < 20; line_n++)
+      Gui::Text("Line %d of docked window %d", line_n, n);
+    Gui::End();
+  }
+}
+
+static void ScenePolylines(int frame) {
+  const int POINTS_COUNT = 20000;
+  static thread_local std::vector<Vec2> points(POINTS_COUNT);
+  const Vec2 display_size = Gui::GetIO().DisplaySize;
+  for (int n = 0; n < POINTS_COUNT; n++) {
+    const float t = (float)n / POINTS_COUNT;
+    points[n] = Vec2(t * display_size.x,
+                     display_size.y * 0.5f +
+                         sinf(t * 200.0f + frame * 0.1f) * display_size.y *
+                             0.4f);
+  }
+  DrawList *draw_list = Gui::GetBackgroundDrawList();
+  draw_list->AddPolyline(points.data(), POINTS_COUNT, COL32(255, 255, 0, 255),
+                         DrawFlags_None, 1.0f);
+  draw_list->AddPolyline(points.data(), POINTS_COUNT, COL32(0, 255, 255, 128),
+                         DrawFlags_None, 4.0f);
+  for (int n = 0; n < 500; n++) {
+    const Vec2 p0((float)(n * 3), 100.0f);
+    draw_list->AddBezierCubic(p0, Vec2(p0.x + 100, 0), Vec2(p0.x + 200, 600),
+                              Vec2(p0.x + 300, 300), COL32(255, 0, 255, 255),
+                              2.0f);
+    draw_list->AddCircle(Vec2((float)(n * 3), 800.0f), 50.0f,
+                         COL32(255, 255, 255, 64), 0, 1.5f);
+  }
+}
+
+static const BenchScene g_Scenes[] = {
+    {"demo", SceneDemo, 0, false},
+    {"table_huge", SceneTableHuge, 0, true},
+    {"inspector", SceneInspector, 0, true},
+    {"tree_deep", SceneTreeDeep, 0, true},
+    {"windows_many", SceneManyWindows, 0, true},
+    {"text_long", SceneLongText, 0, true},
+    {"docking", SceneDocking, ConfigFlags_DockingEnable, true},
+    {"polylines", ScenePolylines, 0, true},
+};
+
+//-----------------------------------------------------------------------------
+// Measurements
+//-----------------------------------------------------------------------------
+
+enum BenchPhase_ {
+  BenchPhase_NewFrame,
+  BenchPhase_Submit,
+  BenchPhase_EndFrame,
+  BenchPhase_Render,
+  BenchPhase_Raster, // Only with --software
+  BenchPhase_COUNT
+};
+static const char *g_PhaseNames[BenchPhase_COUNT] = {
+    "new_frame", "submit", "end_frame", "render", "raster"};
+
+struct BenchTiming {
+  double TotalMs, MinMs, MaxMs;
+  void Add(double ms) {
+    TotalMs += ms;
+    MinMs = (MinMs == 0.0 || ms < MinMs) ? ms : MinMs;
+    MaxMs = (ms > MaxMs) ? ms : MaxMs;
+  }
+  void Merge(const BenchTiming &other) {
+    TotalMs += other.TotalMs;
+    MinMs = (MinMs == 0.0 || other.MinMs < MinMs) ? other.MinMs : MinMs;
+    MaxMs = (other.MaxMs > MaxMs) ? other.MaxMs : MaxMs;
+  }
+};
+
+struct BenchResult {
+  const char *Name;
+  int Frames;
+  BenchTiming Phases[BenchPhase_COUNT];
+  BenchTiming Frame;
+  double Vertices, Indices, DrawCmds, DrawLists; // Per frame averages
+  double AllocCount, AllocBytes;                 // Per frame averages
+  long long PeakBytes;
+  long long PixelsWritten; // Per frame average, only with --software
+};
+
+typedef std::chrono::steady_clock BenchClock;
+static double BenchElapsedMs(BenchClock::time_point t0,
+                             BenchClock::time_point t1) {
+  return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+// 'stats' must be the allocator user data of the calling thread.
+static BenchResult RunScene(const BenchScene &scene, int frames_count,
+                            bool software, Gui::FontAtlas *shared_font_atlas,
+                            BenchAllocStats *stats) {
+  const int WARMUP_FRAMES = 10;
+  BenchResult result;
+  memset(&result, 0, sizeof(result));
+  result.Name = scene.Name;
+  result.Frames = frames_count;
+
+  stats->PeakBytes = stats->CurrentBytes;
+  Gui::CreateContext(shared_font_atlas);
   IO &io = Gui::GetIO();
+  io.IniFilename = nullptr;
+  io.ConfigFlags |= scene.ConfigFlags;
+  io.BackendFlags |= BackendFlags_RendererHasVtxOffset; // Allow large meshes
+  io.DisplaySize = Vec2(1920, 1080);
+  io.DeltaTime = 1.0f / 60.0f;
 
-  // Build atlas
+  // Build atlas (a shared atlas is already built)
   unsigned char *tex_pixels = nullptr;
   int tex_w, tex_h;
-  io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
-
-  for (int n = 0; n < 20; n++) {
-    printf("NewFrame() %d\n", n);
-    io.DisplaySize = Vec2(1920, 1080);
-    io.DeltaTime = 1.0f / 60.0f;
-    Gui::NewFrame();
+  if (shared_font_atlas == nullptr)
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+  std::vector<unsigned int> framebuffer;
+  if (software) {
+    Software_Init();
+    framebuffer.resize((size_t)(io.DisplaySize.x * io.DisplaySize.y));
+  }
 
-    static float f = 0.0f;
-    Gui::Text("Hello, world!");
-    Gui::SliderFloat("float", &f, 0.0f, 1.0f);
-    Gui::Text("Application average %.3f ms/frame (%.1f FPS)",
-              1000.0f / io.Framerate, io.Framerate);
-    Gui::ShowDemoWindow(nullptr);
+  for (int frame = 0; frame < WARMUP_FRAMES + frames_count; frame++) {
+    const bool measure = (frame >= WARMUP_FRAMES);
+    const BenchAllocStats alloc_start = *stats;
+    BenchClock::time_point times[BenchPhase_COUNT + 1];
 
+    times[BenchPhase_NewFrame] = BenchClock::now();
+    if (software)
+      Software_NewFrame();
+    Gui::NewFrame();
+    times[BenchPhase_Submit] = BenchClock::now();
+    scene.Submit(frame);
+    times[BenchPhase_EndFrame] = BenchClock::now();
+    Gui::EndFrame();
+    times[BenchPhase_Render] = BenchClock::now();
     Gui::Render();
+    times[BenchPhase_Raster] = BenchClock::now();
+    if (software) {
+      memset(framebuffer.data(), 0, framebuffer.size() * sizeof(unsigned int));
+      Software_RenderDrawData(Gui::GetDrawData(), framebuffer.data(),
+                              (int)io.DisplaySize.x, (int)io.DisplaySize.y,
+                              (int)io.DisplaySize.x * 4);
+    }
+    times[BenchPhase_COUNT] = BenchClock::now();
+    if (g_RecordWriter)
+      RecordFrame(frame);
+    if (!measure)
+      continue;
+
+    for (int phase = 0; phase < BenchPhase_COUNT; phase++)
+      result.Phases[phase].Add(BenchElapsedMs(times[phase], times[phase + 1]));
+    result.Frame.Add(
+        BenchElapsedMs(times[BenchPhase_NewFrame], times[BenchPhase_COUNT]));
+    const DrawData *draw_data = Gui::GetDrawData();
+    result.Vertices += draw_data->TotalVtxCount;
+    result.Indices += draw_data->TotalIdxCount;
+    result.DrawLists += draw_data->CmdListsCount;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+      result.DrawCmds += draw_data->CmdLists[n]->CmdBuffer.Size;
+    result.AllocCount += (double)(stats->AllocCount - alloc_start.AllocCount);
+    result.AllocBytes += (double)(stats->AllocBytes - alloc_start.AllocBytes);
+    if (software)
+      result.PixelsWritten += Software_GetStats().PixelsWritten;
   }
 
-  printf("DestroyContext()\n");
+  if (software)
+    Software_Shutdown();
   Gui::DestroyContext();
+  result.PeakBytes = stats->PeakBytes;
+  result.Vertices /= frames_count;
+  result.Indices /= frames_count;
+  result.DrawCmds /= frames_count;
+  result.DrawLists /= frames_count;
+  result.AllocCount /= frames_count;
+  result.AllocBytes /= frames_count;
+  result.PixelsWritten /= frames_count;
+  return result;
+}
+
+#ifdef USE_THREAD_LOCAL_CONTEXT
+// Run the scene on 'threads_count' threads at the same time, each with its own
+// context and allocator, all sharing 'font_atlas'. Timings are merged over all
+// threads, peak memory is the sum of all threads.
+static BenchResult RunSceneThreaded(const BenchScene &scene, int frames_count,
+                                    int threads_count,
+                                    Gui::FontAtlas *font_atlas) {
+  std::vector<BenchResult> results((size_t)threads_count);
+  std::vector<BenchAllocStats> stats((size_t)threads_count);
+  std::vector<std::thread> threads;
+  for (int n = 0; n < threads_count; n++)
+    threads.emplace_back([&, n]() {
+      Gui::SetAllocatorFunctions(BenchMemAlloc, BenchMemFree, &stats[n]);
+      results[n] = RunScene(scene, frames_count, false, font_atlas, &stats[n]);
+    });
+  for (std::thread &thread : threads)
+    thread.join();
+
+  BenchResult result = results[0];
+  for (int n = 1; n < threads_count; n++) {
+    result.Frames += results[n].Frames;
+    for (int phase = 0; phase < BenchPhase_COUNT; phase++)
+      result.Phases[phase].Merge(results[n].Phases[phase]);
+    result.Frame.Merge(results[n].Frame);
+    result.PeakBytes += results[n].PeakBytes;
+  }
+  return result;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// Output
+//-----------------------------------------------------------------------------
+
+static void PrintResult(const BenchResult &r, bool software) {
+  printf("%-14s frame %8.3f ms (min %.3f, max %.3f) |", r.Name,
+         r.Frame.TotalMs / r.Frames, r.Frame.MinMs, r.Frame.MaxMs);
+  for (int phase = 0; phase < BenchPhase_COUNT; phase++)
+    if (phase != BenchPhase_Raster || software)
+      printf(" %s %.3f", g_PhaseNames[phase],
+             r.Phases[phase].TotalMs / r.Frames);
+  printf(" | vtx %.0f idx %.0f cmds %.0f lists %.0f | allocs %.1f (%.0f "
+         "bytes) peak %lld KB\n",
+         r.Vertices, r.Indices, r.DrawCmds, r.DrawLists, r.AllocCount,
+         r.AllocBytes, r.PeakBytes / 1024);
+}
+
+static void WriteJson(FILE *f, const std::vector<BenchResult> &results,
+                      int frames_count, bool software, int threads_count) {
+  fprintf(f, "{\n  \"version\": \"%s\",\n  \"frames\": %d,\n"
+             "  \"software\": %s,\n  \"threads\": %d,\n  \"scenes\": [\n",
+          Gui::GetVersion(), frames_count, software ? "true" : "false",
+          threads_count);
+  for (size_t n = 0; n < results.size(); n++) {
+    const BenchResult &r = results[n];
+    fprintf(f, "    {\n      \"name\": \"%s\",\n", r.Name);
+    fprintf(f,
+            "      \"frame_ms\": {\"mean\": %.4f, \"min\": %.4f, \"max\": "
+            "%.4f},\n",
+            r.Frame.TotalMs / r.Frames, r.Frame.MinMs, r.Frame.MaxMs);
+    for (int phase = 0; phase < BenchPhase_COUNT; phase++)
+      if (phase != BenchPhase_Raster || software)
+        fprintf(f,
+                "      \"%s_ms\": {\"mean\": %.4f, \"min\": %.4f, \"max\": "
+                "%.4f},\n",
+                g_PhaseNames[phase], r.Phases[phase].TotalMs / r.Frames,
+                r.Phases[phase].MinMs, r.Phases[phase].MaxMs);
+    if (software)
+      fprintf(f, "      \"pixels_written\": %lld,\n", r.PixelsWritten);
+    fprintf(f,
+            "      \"vertices\": %.1f,\n      \"indices\": %.1f,\n"
+            "      \"draw_cmds\": %.1f,\n      \"draw_lists\": %.1f,\n"
+            "      \"allocs\": %.1f,\n      \"alloc_bytes\": %.1f,\n"
+            "      \"peak_bytes\": %lld\n    }%s\n",
+            r.Vertices, r.Indices, r.DrawCmds, r.DrawLists, r.AllocCount,
+            r.AllocBytes, r.PeakBytes,
+            (n + 1 < results.size()) ? "," : "");
+  }
+  fprintf(f, "  ]\n}\n");
+}
+
+int main(int argc, char **argv) {
+  CHECKVERSION();
+  int frames_count = 100;
+  const char *scene_filter = nullptr;
+  const char *json_path = nullptr;
+  const char *record_path = nullptr;
+  bool software = false;
+  int threads_count = 0;
+  for (int n = 1; n < argc; n++) {
+    if (strcmp(argv[n], "--frames") == 0 && n + 1 < argc)
+      frames_count = atoi(argv[++n]);
+    else if (strcmp(argv[n], "--scene") == 0 && n + 1 < argc)
+      scene_filter = argv[++n];
+    else if (strcmp(argv[n], "--json") == 0 && n + 1 < argc)
+      json_path = argv[++n];
+    else if (strcmp(argv[n], "--software") == 0)
+      software = true;
+    else if (strcmp(argv[n], "--threads") == 0 && n + 1 < argc)
+      threads_count = atoi(argv[++n]);
+    else if (strcmp(argv[n], "--record") == 0 && n + 1 < argc)
+      record_path = argv[++n];
+    else {
+      fprintf(stderr, "Usage: %s [--frames N] [--scene NAME] [--software] "
+                      "[--threads N] [--json FILE|-] [--record FILE]\n",
+              argv[0]);
+      return 1;
+    }
+  }
+  if (frames_count < 1)
+    frames_count = 1;
+#ifndef USE_THREAD_LOCAL_CONTEXT
+  if (threads_count > 0) {
+    fprintf(stderr, "--threads requires building with "
+                    "USE_THREAD_LOCAL_CONTEXT\n");
+    return 1;
+  }
+#endif
+  if (threads_count > 0 && software) {
+    fprintf(stderr, "--threads can't be used with --software\n");
+    return 1;
+  }
+  if (threads_count > 0 && record_path) {
+    fprintf(stderr, "--threads can't be used with --record\n");
+    return 1;
+  }
+
+  // Allocator must be set before creating contexts
+  Gui::SetAllocatorFunctions(BenchMemAlloc, BenchMemFree, &g_AllocStats);
+
+  if (record_path) {
+    g_RecordFile = fopen(record_path, "wb");
+    if (g_RecordFile == nullptr) {
+      fprintf(stderr, "Could not open '%s'\n", record_path);
+      return 1;
+    }
+    g_RecordWriter = new DrawStreamWriter();
+  }
+
+  // With --threads, all contexts share one atlas built up front
+  Gui::FontAtlas *shared_font_atlas = nullptr;
+  if (threads_count > 0) {
+    unsigned char *tex_pixels = nullptr;
+    int tex_w, tex_h;
+    shared_font_atlas = new Gui::FontAtlas();
+    shared_font_atlas->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+  }
+
+  const bool json_to_stdout = json_path && strcmp(json_path, "-") == 0;
+  std::vector<BenchResult> results;
+  for (const BenchScene &scene : g_Scenes) {
+    if (scene_filter && strstr(scene.Name, scene_filter) == nullptr)
+      continue;
+    if (threads_count > 0 && !scene.ThreadSafe)
+      continue;
+#ifdef USE_THREAD_LOCAL_CONTEXT
+    if (threads_count > 0)
+      results.push_back(RunSceneThreaded(scene, frames_count, threads_count,
+                                         shared_font_atlas));
+    else
+#endif
+      results.push_back(
+          RunScene(scene, frames_count, software, nullptr, &g_AllocStats));
+    if (!json_to_stdout)
+      PrintResult(results.back(), software);
+  }
+
+  if (json_path) {
+    FILE *f = json_to_stdout ? stdout : fopen(json_path, "wb");
+    if (f == nullptr) {
+      fprintf(stderr, "Could not open '%s'\n", json_path);
+      return 1;
+    }
+    WriteJson(f, results, frames_count, software, threads_count);
+    if (f != stdout)
+      fclose(f);
+  }
+  if (g_RecordWriter) {
+    if (!json_to_stdout)
+      printf("Recorded %d frames: %d draw lists sent, %d reused\n",
+             g_RecordWriter->FramesCount, g_RecordWriter->ListsSent,
+             g_RecordWriter->ListsReused);
+    delete g_RecordWriter;
+    fclose(g_RecordFile);
+  }
+  delete shared_font_atlas;
   return 0;
 }
@@ -10,6 +10,7 @@
 //  [SECTION] Storage
 //  [SECTION] TextFilter
 //  [SECTION] TextBuffer, TextIndex
+//  [SECTION] FrameArena
 //  [SECTION] ListClipper
 //  [SECTION] STYLING
 //  [SECTION] RENDER HELPERS
@@ -375,27 +376,37 @@ static void UpdateViewportPlatformMonitor(ViewportP *viewport);
 // pointer.
 //   If you want thread-safety to allow N threads to access N different
 //   contexts:
-//   - Change this variable to use thread local storage so each thread can refer
-//   to a different context, in your config.hpp:
+//   - '#define USE_THREAD_LOCAL_CONTEXT' in your config.hpp. This pointer and
+//   the allocator functions below are then stored in thread local storage:
+//   each thread calls SetCurrentContext() with its own context (and
+//   SetAllocatorFunctions() if needed). No other mutable state is shared
+//   between contexts, except a FontAtlas passed to CreateContext(), which
+//   must be built before and not modified while contexts are using it.
+//   - Alternatively you may define GGui to your own thread local variable in
+//   your config.hpp:
 //         struct Context;
 //         extern thread_local Context* MyTLS;
 //         #define GGui MyTLS
-//     And then define MyTLS in one of your cpp files. Note that
-//     thread_local is a C++11 keyword, earlier C++ uses compiler-specific
-//     keyword.
-//   - Future development aims to make this context pointer explicit to all
-//   calls.
+//     And then define MyTLS in one of your cpp files.
 //   - If you need a finite number of contexts, you may compile and use multiple
 //   instances of the Gui code from a different namespace.
 // - DLL users: read comments above.
 #ifndef GGui
+#ifdef USE_THREAD_LOCAL_CONTEXT
+thread_local Context *GGui = NULL;
+#else
 Context *GGui = NULL;
 #endif
+#endif
 
 // Memory Allocator functions. Use SetAllocatorFunctions() to change them.
 // - You probably don't want to modify that mid-program, and if you use
 // global/static e.g. Vector<> instances you may need to keep them accessible
 // during program destruction.
+// - With USE_THREAD_LOCAL_CONTEXT they are set per thread, so a custom
+// allocator doesn't need to be thread-safe. Memory must then be freed on a
+// thread using the same allocator (e.g. create/destroy a context on the same
+// thread, build/destroy a shared FontAtlas on the same thread).
 // - DLL users: read comments above.
 #ifndef DISABLE_DEFAULT_ALLOCATORS
 static void *MallocWrapper(size_t size, void *user_data) {
@@ -419,9 +430,15 @@ static void FreeWrapper(void *ptr, void *user_data) {
   assert(0);
 }
 #endif
+#ifdef USE_THREAD_LOCAL_CONTEXT
+static thread_local MemAllocFunc GAllocatorAllocFunc = MallocWrapper;
+static thread_local MemFreeFunc GAllocatorFreeFunc = FreeWrapper;
+static thread_local void *GAllocatorUserData = NULL;
+#else
 static MemAllocFunc GAllocatorAllocFunc = MallocWrapper;
 static MemFreeFunc GAllocatorFreeFunc = FreeWrapper;
 static void *GAllocatorUserData = NULL;
+#endif
 
 //-----------------------------------------------------------------------------
 // [SECTION] USER FACING STRUCTURES (Style, IO)
@@ -634,6 +651,7 @@ IO::IO() {
   Fonts = NULL;
   FontGlobalScale = 1.0f;
   FontDefault = NULL;
+  Images = NULL;
   FontAllowUserScaling = false;
   DisplayFramebufferScale = Vec2(1.0f, 1.0f);
 
@@ -658,12 +676,14 @@ IO::IO() {
   ConfigMacOSXBehaviors = false;
 #endif
   ConfigInputTrickleEventQueue = true;
+  ConfigInputEventsAnyThread = false;
   ConfigInputTextCursorBlink = true;
   ConfigInputTextEnterKeepActive = false;
   ConfigDragClickToInputText = false;
   ConfigWindowsResizeFromEdges = true;
   ConfigWindowsMoveFromTitleBarOnly = false;
   ConfigMemoryCompactTimer = 60.0f;
+  ConfigRenderOcclusionCulling = false;
   ConfigDebugBeginReturnValueOnce = false;
   ConfigDebugBeginReturnValueLoop = false;
 
@@ -696,6 +716,8 @@ IO::IO() {
       true; // assume using legacy array until proven wrong
 }
 
+static void PostInputEvent(Context *ctx, const InputEvent &e);
+
 // Pass in translated ASCII characters for text input.
 // - with glfw you can get those from the callback set in glfwSetCharCallback()
 // - on Windows you can get those using ToAscii+keyboard state, or via the
@@ -704,16 +726,14 @@ IO::IO() {
 // new API
 void IO::AddInputCharacter(unsigned int c) {
   assert(Ctx != NULL);
-  Context &g = *Ctx;
   if (c == 0 || !AppAcceptingEvents)
     return;
 
   InputEvent e;
   e.Type = InputEventType_Text;
   e.Source = InputSource_Keyboard;
-  e.EventId = g.InputEventsNextEventId++;
   e.Text.Char = c;
-  g.InputEventsQueue.push_back(e);
+  PostInputEvent(Ctx, e);
 }
 
 // UTF16 strings use surrogate pairs to encode codepoints >= 0x10000, so
@@ -764,6 +784,9 @@ void IO::ClearEventsQueue() {
   assert(Ctx != NULL);
   Context &g = *Ctx;
   g.InputEventsQueue.clear();
+  InputEvent e;
+  while (g.InputEventsPosted.Pop(&e)) {
+  }
 }
 
 // Clear current keyboard/mouse/gamepad state + current frame text input buffer.
@@ -811,6 +834,136 @@ static InputEvent *FindLatestInputEvent(Context *ctx, InputEventType type,
   return NULL;
 }
 
+// Filter duplicate events then append to g.InputEventsQueue. Called by the
+// io.AddXXX functions, or by NewFrame() for events posted from other threads.
+static void QueueInputEvent(Context *ctx, const InputEvent *e) {
+  Context &g = *ctx;
+  IO &io = g.IO;
+  switch (e->Type) {
+  case InputEventType_Key: {
+    // Verify that backend isn't mixing up using new io.AddKeyEvent() api and
+    // old io.KeysDown[] + io.KeyMap[] data.
+#ifndef DISABLE_OBSOLETE_KEYIO
+    assert((io.BackendUsingLegacyKeyArrays == -1 ||
+            io.BackendUsingLegacyKeyArrays == 0) &&
+           "Backend needs to either only use io.AddKeyEvent(), either only "
+           "fill legacy io.KeysDown[] + io.KeyMap[]. Not both!");
+    if (io.BackendUsingLegacyKeyArrays == -1)
+      for (int n = Key_NamedKey_BEGIN; n < Key_NamedKey_END; n++)
+        assert(io.KeyMap[n] == -1 &&
+               "Backend needs to either only use io.AddKeyEvent(), either "
+               "only fill legacy io.KeysDown[] + io.KeyMap[]. Not both!");
+    io.BackendUsingLegacyKeyArrays = 0;
+#endif
+    if (Gui::IsGamepadKey(e->Key.Key))
+      io.BackendUsingLegacyNavInputArray = false;
+
+    // Filter duplicate (in particular: key mods and gamepad analog values are
+    // commonly spammed)
+    const InputEvent *latest_event =
+        FindLatestInputEvent(&g, InputEventType_Key, (int)e->Key.Key);
+    const KeyData *key_data = Gui::GetKeyData(&g, e->Key.Key);
+    const bool latest_key_down =
+        latest_event ? latest_event->Key.Down : key_data->Down;
+    const float latest_key_analog =
+        latest_event ? latest_event->Key.AnalogValue : key_data->AnalogValue;
+    if (latest_key_down == e->Key.Down &&
+        latest_key_analog == e->Key.AnalogValue)
+      return;
+    break;
+  }
+  case InputEventType_MousePos: {
+    const InputEvent *latest_event =
+        FindLatestInputEvent(&g, InputEventType_MousePos);
+    const Vec2 latest_pos = latest_event ? Vec2(latest_event->MousePos.PosX,
+                                                latest_event->MousePos.PosY)
+                                         : io.MousePos;
+    if (latest_pos.x == e->MousePos.PosX && latest_pos.y == e->MousePos.PosY)
+      return;
+    break;
+  }
+  case InputEventType_MouseButton: {
+    const InputEvent *latest_event = FindLatestInputEvent(
+        &g, InputEventType_MouseButton, e->MouseButton.Button);
+    const bool latest_button_down = latest_event
+                                        ? latest_event->MouseButton.Down
+                                        : io.MouseDown[e->MouseButton.Button];
+    if (latest_button_down == e->MouseButton.Down)
+      return;
+    break;
+  }
+  case InputEventType_MouseViewport: {
+    const InputEvent *latest_event =
+        FindLatestInputEvent(&g, InputEventType_MouseViewport);
+    const int latest_viewport_id =
+        latest_event ? latest_event->MouseViewport.HoveredViewportID
+                     : io.MouseHoveredViewport;
+    if (latest_viewport_id == e->MouseViewport.HoveredViewportID)
+      return;
+    break;
+  }
+  case InputEventType_Focus: {
+    const InputEvent *latest_event =
+        FindLatestInputEvent(&g, InputEventType_Focus);
+    const bool latest_focused =
+        latest_event ? latest_event->AppFocused.Focused : !io.AppFocusLost;
+    if (latest_focused == e->AppFocused.Focused ||
+        (io.ConfigDebugIgnoreFocusLoss && !e->AppFocused.Focused))
+      return;
+    break;
+  }
+  default:
+    break;
+  }
+
+  g.InputEventsQueue.push_back(*e);
+  g.InputEventsQueue.back().EventId = g.InputEventsNextEventId++;
+}
+
+// Queue directly, or post to the lock-free queue when the io.AddXXX functions
+// may be called from other threads. Filtering is then done by NewFrame().
+static void PostInputEvent(Context *ctx, const InputEvent &e) {
+  Context &g = *ctx;
+  if (g.IO.ConfigInputEventsAnyThread)
+    g.InputEventsPosted.Post(e);
+  else
+    QueueInputEvent(&g, &e);
+}
+
+// Vyukov bounded MPSC queue: producers claim a position with a CAS on PostPos,
+// each cell sequence number tells whether it is free or holds an event.
+bool InputEventPostQueue::Post(const InputEvent &e) {
+  const unsigned int mask = INPUT_EVENTS_POST_CAPACITY - 1;
+  unsigned int pos = AtomicLoad(&PostPos);
+  Cell *cell;
+  for (;;) {
+    cell = &Cells[pos & mask];
+    const int diff = (int)(AtomicLoad(&cell->Sequence) - pos);
+    if (diff == 0) {
+      if (AtomicCompareExchange(&PostPos, &pos, pos + 1))
+        break;
+    } else if (diff < 0) {
+      AtomicAdd(&DroppedCount, 1); // Full: consumer is a whole lap behind
+      return false;
+    } else {
+      pos = AtomicLoad(&PostPos); // Another producer claimed this position
+    }
+  }
+  cell->Event = e;
+  AtomicStore(&cell->Sequence, pos + 1);
+  return true;
+}
+
+bool InputEventPostQueue::Pop(InputEvent *out_e) {
+  Cell *cell = &Cells[PopPos & (INPUT_EVENTS_POST_CAPACITY - 1)];
+  if (AtomicLoad(&cell->Sequence) != PopPos + 1)
+    return false;
+  *out_e = cell->Event;
+  AtomicStore(&cell->Sequence, PopPos + INPUT_EVENTS_POST_CAPACITY);
+  PopPos++;
+  return true;
+}
+
 // Queue a new key down/up event.
 // - Key key:       Translated key (as in, generally Key_A matches the
 // key end-user would use to emit an 'A' character)
@@ -826,7 +979,6 @@ void IO::AddKeyAnalogEvent(Key key, bool down, float analog_value) {
   assert(Ctx != NULL);
   if (key == Key_None || !AppAcceptingEvents)
     return;
-  Context &g = *Ctx;
   assert(Gui::IsNamedKeyOrModKey(
       key)); // Backend needs to pass a valid Key_ constant. 0..511 values
              // are legacy native key codes which are not accepted by this API.
@@ -837,45 +989,15 @@ void IO::AddKeyAnalogEvent(Key key, bool down, float analog_value) {
                                // here but it seems saner to not accept it
                                // (TestEngine perform a translation itself)
 
-  // Verify that backend isn't mixing up using new io.AddKeyEvent() api and old
-  // io.KeysDown[] + io.KeyMap[] data.
-#ifndef DISABLE_OBSOLETE_KEYIO
-  assert(
-      (BackendUsingLegacyKeyArrays == -1 || BackendUsingLegacyKeyArrays == 0) &&
-      "Backend needs to either only use io.AddKeyEvent(), either only fill "
-      "legacy io.KeysDown[] + io.KeyMap[]. Not both!");
-  if (BackendUsingLegacyKeyArrays == -1)
-    for (int n = Key_NamedKey_BEGIN; n < Key_NamedKey_END; n++)
-      assert(KeyMap[n] == -1 &&
-             "Backend needs to either only use io.AddKeyEvent(), either "
-             "only fill legacy io.KeysDown[] + io.KeyMap[]. Not both!");
-  BackendUsingLegacyKeyArrays = 0;
-#endif
-  if (Gui::IsGamepadKey(key))
-    BackendUsingLegacyNavInputArray = false;
-
-  // Filter duplicate (in particular: key mods and gamepad analog values are
-  // commonly spammed)
-  const InputEvent *latest_event =
-      FindLatestInputEvent(&g, InputEventType_Key, (int)key);
-  const KeyData *key_data = Gui::GetKeyData(&g, key);
-  const bool latest_key_down =
-      latest_event ? latest_event->Key.Down : key_data->Down;
-  const float latest_key_analog =
-      latest_event ? latest_event->Key.AnalogValue : key_data->AnalogValue;
-  if (latest_key_down == down && latest_key_analog == analog_value)
-    return;
-
   // Add event
   InputEvent e;
   e.Type = InputEventType_Key;
   e.Source =
       Gui::IsGamepadKey(key) ? InputSource_Gamepad : InputSource_Keyboard;
-  e.EventId = g.InputEventsNextEventId++;
   e.Key.Key = key;
   e.Key.Down = down;
   e.Key.AnalogValue = analog_value;
-  g.InputEventsQueue.push_back(e);
+  PostInputEvent(Ctx, e);
 }
 
 void IO::AddKeyEvent(Key key, bool down) {
@@ -932,23 +1054,13 @@ void IO::AddMousePosEvent(float x, float y) {
   // Apply same flooring as UpdateMouseInputs()
   Vec2 pos((x > -FLT_MAX) ? Floor(x) : x, (y > -FLT_MAX) ? Floor(y) : y);
 
-  // Filter duplicate
-  const InputEvent *latest_event =
-      FindLatestInputEvent(&g, InputEventType_MousePos);
-  const Vec2 latest_pos = latest_event ? Vec2(latest_event->MousePos.PosX,
-                                              latest_event->MousePos.PosY)
-                                       : g.IO.MousePos;
-  if (latest_pos.x == pos.x && latest_pos.y == pos.y)
-    return;
-
   InputEvent e;
   e.Type = InputEventType_MousePos;
   e.Source = InputSource_Mouse;
-  e.EventId = g.InputEventsNextEventId++;
   e.MousePos.PosX = pos.x;
   e.MousePos.PosY = pos.y;
   e.MousePos.MouseSource = g.InputEventsNextMouseSource;
-  g.InputEventsQueue.push_back(e);
+  PostInputEvent(&g, e);
 }
 
 void IO::AddMouseButtonEvent(int mouse_button, bool down) {
@@ -958,22 +1070,13 @@ void IO::AddMouseButtonEvent(int mouse_button, bool down) {
   if (!AppAcceptingEvents)
     return;
 
-  // Filter duplicate
-  const InputEvent *latest_event =
-      FindLatestInputEvent(&g, InputEventType_MouseButton, (int)mouse_button);
-  const bool latest_button_down = latest_event ? latest_event->MouseButton.Down
-                                               : g.IO.MouseDown[mouse_button];
-  if (latest_button_down == down)
-    return;
-
   InputEvent e;
   e.Type = InputEventType_MouseButton;
   e.Source = InputSource_Mouse;
-  e.EventId = g.InputEventsNextEventId++;
   e.MouseButton.Button = mouse_button;
   e.MouseButton.Down = down;
   e.MouseButton.MouseSource = g.InputEventsNextMouseSource;
-  g.InputEventsQueue.push_back(e);
+  PostInputEvent(&g, e);
 }
 
 // Queue a mouse wheel event (some mouse/API may only have a Y component)
@@ -989,11 +1092,10 @@ void IO::AddMouseWheelEvent(float wheel_x, float wheel_y) {
   InputEvent e;
   e.Type = InputEventType_MouseWheel;
   e.Source = InputSource_Mouse;
-  e.EventId = g.InputEventsNextEventId++;
   e.MouseWheel.WheelX = wheel_x;
   e.MouseWheel.WheelY = wheel_y;
   e.MouseWheel.MouseSource = g.InputEventsNextMouseSource;
-  g.InputEventsQueue.push_back(e);
+  PostInputEvent(&g, e);
 }
 
 // This is not a real event, the data is latched in order to be stored in actual
@@ -1008,44 +1110,24 @@ void IO::AddMouseSourceEvent(::MouseSource source) {
 
 void IO::AddMouseViewportEvent(int viewport_id) {
   assert(Ctx != NULL);
-  Context &g = *Ctx;
   // assert(g.IO.ConfigFlags & BackendFlags_HasMouseHoveredViewport);
   if (!AppAcceptingEvents)
     return;
 
-  // Filter duplicate
-  const InputEvent *latest_event =
-      FindLatestInputEvent(&g, InputEventType_MouseViewport);
-  const int latest_viewport_id =
-      latest_event ? latest_event->MouseViewport.HoveredViewportID
-                   : g.IO.MouseHoveredViewport;
-  if (latest_viewport_id == viewport_id)
-    return;
-
   InputEvent e;
   e.Type = InputEventType_MouseViewport;
   e.Source = InputSource_Mouse;
   e.MouseViewport.HoveredViewportID = viewport_id;
-  g.InputEventsQueue.push_back(e);
+  PostInputEvent(Ctx, e);
 }
 
 void IO::AddFocusEvent(bool focused) {
   assert(Ctx != NULL);
-  Context &g = *Ctx;
-
-  // Filter duplicate
-  const InputEvent *latest_event =
-      FindLatestInputEvent(&g, InputEventType_Focus);
-  const bool latest_focused =
-      latest_event ? latest_event->AppFocused.Focused : !g.IO.AppFocusLost;
-  if (latest_focused == focused || (ConfigDebugIgnoreFocusLoss && !focused))
-    return;
 
   InputEvent e;
   e.Type = InputEventType_Focus;
-  e.EventId = g.InputEventsNextEventId++;
   e.AppFocused.Focused = focused;
-  g.InputEventsQueue.push_back(e);
+  PostInputEvent(Ctx, e);
 }
 
 //-----------------------------------------------------------------------------
@@ -1493,6 +1575,23 @@ int HashStr(const char *data_p, size_t data_size, int seed) {
   return ~crc;
 }
 
+// Hash of a string hashed at compile-time, combined with a runtime seed.
+// CRC32 being linear, hashing data from a seed equals hashing it from a zero
+// seed, xored with the seed multiplied by x^(8*data_size) modulo the CRC32
+// polynomial (same as zlib's crc32_combine()). Multiplying by x^8 is one step
+// of the lookup table without input byte, so this doesn't read the string nor
+// look for "###". See Window::GetID() caching the products for a given seed.
+static inline unsigned int HashSeedShift(unsigned int seed_shifted) {
+  return (seed_shifted >> 8) ^ GCrc32LookupTable[seed_shifted & 0xFF];
+}
+
+int HashStr(const StrID &str_id, int seed) {
+  unsigned int seed_shifted = (unsigned int)seed;
+  for (int n = seed ? str_id.HashedLen : 0; n > 0; n--)
+    seed_shifted = HashSeedShift(seed_shifted);
+  return (int)(seed_shifted ^ (unsigned int)str_id.Hash);
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] MISC HELPERS/UTILITIES (File functions)
 //-----------------------------------------------------------------------------
@@ -2019,7 +2118,11 @@ void Storage::SetAllInt(int v) {
 TextFilter::TextFilter(const char *default_filter) //-V1077
 {
   InputBuf[0] = 0;
+  CompiledBuf[0] = 0;
   CountGrep = 0;
+  BatchInputBuf[0] = 0;
+  BatchItems = NULL;
+  BatchItemsCount = 0;
   if (default_filter) {
     Strncpy(InputBuf, default_filter, ARRAYSIZE(InputBuf));
     Build();
@@ -2057,6 +2160,8 @@ void TextFilter::Build() {
   input_range.split(',', &Filters);
 
   CountGrep = 0;
+  CompiledFilters.resize(0);
+  int compiled_offset = 0;
   for (TextRange &f : Filters) {
     while (f.b < f.e && CharIsBlankA(f.b[0]))
       f.b++;
@@ -2064,9 +2169,94 @@ void TextFilter::Build() {
       f.e--;
     if (f.empty())
       continue;
-    if (f.b[0] != '-')
+    const bool subtract = (f.b[0] == '-');
+    if (!subtract)
       CountGrep += 1;
+
+    // Compile non-empty needles: lower-case them once and build the skip
+    // table used by PassFilter() (Boyer-Moore-Horspool).
+    const char *needle = subtract ? f.b + 1 : f.b;
+    const int needle_len = (int)(f.e - needle);
+    if (needle_len == 0)
+      continue;
+    CompiledFilters.resize(CompiledFilters.Size + 1);
+    CompiledFilter &cf = CompiledFilters.back();
+    cf.NeedleOffset = compiled_offset;
+    cf.NeedleLen = needle_len;
+    cf.Subtract = subtract;
+    char *compiled_needle = CompiledBuf + compiled_offset;
+    for (int n = 0; n < needle_len; n++)
+      compiled_needle[n] = ToLower(needle[n]);
+    compiled_needle[needle_len] = 0;
+    compiled_offset += needle_len + 1;
+    memset(cf.Skip, needle_len, sizeof(cf.Skip));
+    for (int n = 0; n < needle_len - 1; n++)
+      cf.Skip[(unsigned char)compiled_needle[n]] =
+          (unsigned char)(needle_len - 1 - n);
+  }
+  assert(compiled_offset <= ARRAYSIZE(CompiledBuf));
+}
+
+// SSE2 is required for byte comparisons
+#if defined(ENABLE_SSE) &&                                                     \
+    (defined(__SSE2__) || defined(_M_X64) ||                                   \
+     (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define TEXTFILTER_USE_SSE2
+static inline __m128i TextFilter_ToLowerSSE2(__m128i v) {
+  const __m128i is_upper =
+      _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)),
+                    _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+  return _mm_or_si128(v, _mm_and_si128(is_upper, _mm_set1_epi8(32)));
+}
+#endif
+
+// Compare 'len' bytes of haystack (any case) with a lower-cased needle
+static inline bool TextFilter_MatchLower(const char *haystack,
+                                         const char *needle, int len) {
+  for (int n = 0; n < len; n++)
+    if (ToLower(haystack[n]) != needle[n])
+      return false;
+  return true;
+}
+
+static bool TextFilter_Search(const TextFilter::CompiledFilter &f,
+                              const char *needle, const char *haystack,
+                              const char *haystack_end) {
+  const int needle_len = f.NeedleLen;
+  if (haystack_end - haystack < needle_len)
+    return false;
+  const char *haystack_last = haystack_end - needle_len; // Last candidate
+
+#ifdef TEXTFILTER_USE_SSE2
+  // Test 16 candidate positions at a time on their first and last bytes, only
+  // verify the middle bytes of positions matching both.
+  const __m128i needle_first = _mm_set1_epi8(needle[0]);
+  const __m128i needle_last = _mm_set1_epi8(needle[needle_len - 1]);
+  for (; haystack + 16 <= haystack_last + 1; haystack += 16) {
+    const __m128i block_first =
+        TextFilter_ToLowerSSE2(_mm_loadu_si128((const __m128i *)haystack));
+    const __m128i block_last = TextFilter_ToLowerSSE2(
+        _mm_loadu_si128((const __m128i *)(haystack + needle_len - 1)));
+    unsigned int mask = (unsigned int)_mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(block_first, needle_first),
+                      _mm_cmpeq_epi8(block_last, needle_last)));
+    for (int n = 0; mask != 0; n++, mask >>= 1)
+      if ((mask & 1) && TextFilter_MatchLower(haystack + n + 1, needle + 1,
+                                              needle_len - 2))
+        return true;
   }
+#endif
+
+  // Boyer-Moore-Horspool on the remaining positions
+  const unsigned char needle_last_c = (unsigned char)needle[needle_len - 1];
+  while (haystack <= haystack_last) {
+    const unsigned char c = (unsigned char)ToLower(haystack[needle_len - 1]);
+    if (c == needle_last_c &&
+        TextFilter_MatchLower(haystack, needle, needle_len - 1))
+      return true;
+    haystack += f.Skip[c];
+  }
+  return false;
 }
 
 bool TextFilter::PassFilter(const char *text, const char *text_end) const {
@@ -2075,19 +2265,12 @@ bool TextFilter::PassFilter(const char *text, const char *text_end) const {
 
   if (text == NULL)
     text = "";
+  if (text_end == NULL)
+    text_end = text + strlen(text);
 
-  for (const TextRange &f : Filters) {
-    if (f.empty())
-      continue;
-    if (f.b[0] == '-') {
-      // Subtract
-      if (Stristr(text, text_end, f.b + 1, f.e) != NULL)
-        return false;
-    } else {
-      // Grep
-      if (Stristr(text, text_end, f.b, f.e) != NULL)
-        return true;
-    }
+  for (const CompiledFilter &f : CompiledFilters) {
+    if (TextFilter_Search(f, CompiledBuf + f.NeedleOffset, text, text_end))
+      return !f.Subtract; // Subtract or Grep
   }
 
   // Implicit * grep
@@ -2097,6 +2280,53 @@ bool TextFilter::PassFilter(const char *text, const char *text_end) const {
   return false;
 }
 
+// Return true if every text passing 'new_filter' also passes 'old_filter'.
+// This is the case when the filter text was extended without adding a new
+// term, and the last term is a grep term (so it only gets more specific).
+static bool TextFilter_IsRefinement(const char *old_filter,
+                                    const char *new_filter) {
+  const size_t old_len = strlen(old_filter);
+  if (strncmp(old_filter, new_filter, old_len) != 0)
+    return false;
+  if (new_filter[old_len] == 0)
+    return true; // Same filter
+  if (strchr(new_filter + old_len, ',') != NULL)
+    return false; // Added a term
+  const char *old_last_term = strrchr(old_filter, ',');
+  old_last_term = old_last_term ? old_last_term + 1 : old_filter;
+  while (CharIsBlankA(*old_last_term))
+    old_last_term++;
+  if (old_last_term[0] == 0)
+    return StrSkipBlank(old_filter)[0] == 0; // Previous filter was empty
+  return old_last_term[0] != '-';
+}
+
+void TextFilter::PassFilterBatch(const char *const *items, int items_count,
+                                 Vector<int> *out_indices) {
+  assert(items != NULL || items_count == 0);
+  if (items == BatchItems && items_count == BatchItemsCount &&
+      TextFilter_IsRefinement(BatchInputBuf, InputBuf)) {
+    // Only items which passed the previous filter may pass this one
+    int write_n = 0;
+    for (int read_n = 0; read_n < out_indices->Size; read_n++) {
+      const int item_n = out_indices->Data[read_n];
+      if (PassFilter(items[item_n]))
+        out_indices->Data[write_n++] = item_n;
+    }
+    out_indices->resize(write_n);
+  } else {
+    out_indices->resize(items_count);
+    int write_n = 0;
+    for (int item_n = 0; item_n < items_count; item_n++)
+      if (PassFilter(items[item_n]))
+        out_indices->Data[write_n++] = item_n;
+    out_indices->resize(write_n);
+  }
+  Strncpy(BatchInputBuf, InputBuf, ARRAYSIZE(BatchInputBuf));
+  BatchItems = items;
+  BatchItemsCount = items_count;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] TextBuffer, TextIndex
 //-----------------------------------------------------------------------------
@@ -2177,6 +2407,52 @@ void TextIndex::append(const char *base, int old_size, int new_size) {
   EndOffset = Max(EndOffset, new_size);
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] FrameArena
+//-----------------------------------------------------------------------------
+
+void *FrameArena::AllocOverflow(size_t size) {
+  void *ptr = ALLOC(size);
+  OverflowBlocks.push_back(ptr);
+  OverflowSize += (int)size;
+  return ptr;
+}
+
+void FrameArena::Reset() {
+  LastFrameSize = Size + OverflowSize;
+  if (OverflowBlocks.Size > 0) {
+    for (void *ptr : OverflowBlocks)
+      FREE(ptr);
+    OverflowBlocks.resize(0);
+
+    // Grow the block so the same workload fits without overflowing
+    const int new_capacity =
+        Min(LastFrameSize + LastFrameSize / 2, FRAMEARENA_MAX_BLOCK_SIZE);
+    if (new_capacity > Capacity) {
+      FREE(Data);
+      Data = (char *)ALLOC((size_t)new_capacity);
+      Capacity = new_capacity;
+    }
+  }
+  Size = OverflowSize = 0;
+}
+
+void FrameArena::ClearFreeMemory() {
+  for (void *ptr : OverflowBlocks)
+    FREE(ptr);
+  OverflowBlocks.clear();
+  if (Data)
+    FREE(Data);
+  Data = NULL;
+  Size = Capacity = OverflowSize = 0;
+}
+
+void *Gui::FrameAlloc(size_t size, size_t align) {
+  Context &g = *GGui;
+  assert(IsPowerOfTwo((int)align));
+  return g.FrameArena.Alloc(size, align);
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ListClipper
 //-----------------------------------------------------------------------------
@@ -3280,11 +3556,14 @@ void Gui::Shutdown() {
   // even if g.Initialized is FALSE (which would happen if we never called
   // NewFrame)
   if (g.IO.Fonts && g.FontAtlasOwnedByContext) {
-    g.IO.Fonts->Locked = false;
+    g.IO.Fonts->Locked = 0;
     DELETE(g.IO.Fonts);
+  } else if (g.IO.Fonts && g.WithinFrameScope) {
+    AtomicAdd(&g.IO.Fonts->Locked, (unsigned int)-1);
   }
   g.IO.Fonts = NULL;
   g.DrawListSharedData.TempBuffer.clear();
+  g.FrameArena.ClearFreeMemory();
 
   // Cleanup of other data are conditional on actually having initialized
   // Gui.
@@ -3339,6 +3618,11 @@ void Gui::Shutdown() {
   g.TablesTempData.clear_destruct();
   g.DrawChannelsTempMergeBuffer.clear();
 
+  g.LazyRegions.Clear();
+  g.LazyRegionStack.clear();
+
+  g.TreeClippers.Clear();
+
   g.ClipboardHandlerData.clear();
   g.MenusIdSubmittedThisFrame.clear();
   g.InputTextState.ClearFreeMemory();
@@ -3460,6 +3744,29 @@ int Window::GetID(int n) {
   return id;
 }
 
+// Static labels are generally submitted in series under the same seed: cache
+// the seed multiplied for each length so most calls are a lookup and a xor.
+int Window::GetID(const StrID &str_id) {
+  int seed = IDStack.back();
+  int id;
+  if (seed == 0 || str_id.HashedLen >= (int)ARRAYSIZE(IDSeedShifted)) {
+    id = HashStr(str_id, seed);
+  } else {
+    if (IDSeedShiftedCount == 0 || IDSeedShifted[0] != (unsigned int)seed) {
+      IDSeedShifted[0] = (unsigned int)seed;
+      IDSeedShiftedCount = 1;
+    }
+    for (; IDSeedShiftedCount <= str_id.HashedLen; IDSeedShiftedCount++)
+      IDSeedShifted[IDSeedShiftedCount] =
+          HashSeedShift(IDSeedShifted[IDSeedShiftedCount - 1]);
+    id = (int)(IDSeedShifted[str_id.HashedLen] ^ (unsigned int)str_id.Hash);
+  }
+  Context &g = *Ctx;
+  if (g.DebugHookIdInfo == id)
+    Gui::DebugHookIdInfo(id, DataType_String, str_id.Str, NULL);
+  return id;
+}
+
 // This is only used in rare/specific situations to manufacture an int out of
 // nowhere.
 int Window::GetIDFromRectangle(const struct Rect &r_abs) {
@@ -3485,6 +3792,7 @@ void Gui::GcCompactTransientMiscBuffers() {
   Context &g = *GGui;
   g.ItemFlagsStack.clear();
   g.GroupStack.clear();
+  g.FrameArena.ClearFreeMemory();
   TableGcCompactSettings();
 }
 
@@ -3499,6 +3807,7 @@ void Gui::GcCompactTransientWindowBuffers(Window *window) {
   window->MemoryDrawListVtxCapacity = window->DrawList->VtxBuffer.Capacity;
   window->IDStack.clear();
   window->DrawList->_ClearFreeMemory();
+  window->OccluderRects.clear();
   window->DC.ChildWindows.clear();
   window->DC.ItemWidthStack.clear();
   window->DC.TextWrapPosStack.clear();
@@ -3923,12 +4232,25 @@ float Gui::CalcWrapWidthForPos(const Vec2 &pos, float wrap_pos_x) {
   return Max(wrap_pos_x - pos.x, 1.0f);
 }
 
+// Number of warm-up frames after io.ConfigDebugAssertNoSteadyStateAllocs is
+// set, after which any heap allocation asserts.
+static const int DEBUG_STEADY_STATE_FRAMES = 10;
+
 // ALLOC() == Gui::MemAlloc()
 void *Gui::MemAlloc(size_t size) {
   void *ptr = (*GAllocatorAllocFunc)(size, GAllocatorUserData);
 #ifndef DISABLE_DEBUG_TOOLS
-  if (Context *ctx = GGui)
+  Context *ctx = GGui;
+  if (ctx && !ctx->DebugAllocHookDisabled) {
     DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, size);
+    // Heap allocation after the warm-up frames: if your UI is the same every
+    // frame, use FrameAlloc() or keep the buffer around.
+    assert((!ctx->IO.ConfigDebugAssertNoSteadyStateAllocs ||
+            !ctx->WithinFrameScope ||
+            ctx->DebugAllocInfo.AssertFramesCount <=
+                DEBUG_STEADY_STATE_FRAMES) &&
+           "Heap allocation in a steady-state frame!");
+  }
 #endif
   return ptr;
 }
@@ -3938,7 +4260,9 @@ void Gui::MemFree(void *ptr) {
 #ifndef DISABLE_DEBUG_TOOLS
   if (ptr != NULL)
     if (Context *ctx = GGui)
-      DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, (size_t)-1);
+      if (!ctx->DebugAllocHookDisabled)
+        DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr,
+                       (size_t)-1);
 #endif
   return (*GAllocatorFreeFunc)(ptr, GAllocatorUserData);
 }
@@ -4009,6 +4333,75 @@ double Gui::GetTime() { return GGui->Time; }
 
 int Gui::GetFrameCount() { return GGui->FrameCount; }
 
+void Gui::RequestRedraw(float delay) {
+  Context &g = *GGui;
+  g.RedrawRequestTime = Min(g.RedrawRequestTime, g.Time + Max(delay, 0.0f));
+}
+
+// Return the time (in GetTime() units) at which the next frame needs to be
+// rendered for the UI to stay up to date, assuming no new input arrives.
+// Animations driven by user code are not visible here: call RequestRedraw().
+double Gui::GetNextRedrawDeadline() {
+  Context &g = *GGui;
+  const double now = g.Time;
+  if (g.FrameCount <= 2 || g.RedrawSettleFrames > 0 ||
+      g.InputEventsQueue.Size > 0 || !g.InputEventsPosted.IsEmpty())
+    return now;
+
+  // Held keys auto-repeat, held mouse buttons drive active widgets (drag,
+  // repeat buttons, auto-scroll while selecting text..)
+  for (int key = Key_Keyboard_BEGIN; key < Key_Gamepad_END; key++)
+    if (GetKeyData(&g, (Key)key)->Down &&
+        (key < Key_LeftCtrl || key > Key_RightSuper))
+      return now;
+  if (g.ActiveId != 0 || g.DragDropActive)
+    for (int n = 0; n < ARRAYSIZE(g.IO.MouseDown); n++)
+      if (g.IO.MouseDown[n])
+        return now;
+
+  // Animations and one-frame deferred requests
+  if (g.NavWindowingTarget != NULL || g.NavWindowingHighlightAlpha > 0.0f ||
+      (g.DimBgRatio > 0.0f && g.DimBgRatio < 1.0f) || g.NavAnyRequest ||
+      g.DebugItemPickerActive)
+    return now;
+  for (Window *window : g.Windows) {
+    if (!window->Active && !window->WasActive)
+      continue;
+    if (window->Appearing || window->HiddenFramesCanSkipItems > 0 ||
+        window->HiddenFramesCannotSkipItems > 0 ||
+        window->AutoFitFramesX > 0 || window->AutoFitFramesY > 0 ||
+        window->ScrollTarget.x != FLT_MAX || window->ScrollTarget.y != FLT_MAX)
+      return now;
+  }
+
+  // Timers
+  double deadline = g.RedrawRequestTime;
+  if (g.WheelingWindow != NULL)
+    deadline = Min(deadline, now + g.WheelingWindowReleaseTimer);
+  if (g.SettingsDirtyTimer > 0.0f)
+    deadline = Min(deadline, now + g.SettingsDirtyTimer);
+  if (g.HoverItemDelayId != 0) {
+    const float delays[] = {g.Style.HoverDelayShort, g.Style.HoverDelayNormal};
+    for (float delay : delays)
+      if (g.HoverItemDelayTimer < delay)
+        deadline = Min(deadline, now + (delay - g.HoverItemDelayTimer));
+  }
+  if ((g.HoverItemDelayId != 0 || g.HoveredWindow != NULL) &&
+      g.MouseStationaryTimer < g.Style.HoverStationaryDelay)
+    deadline = Min(deadline, now + (g.Style.HoverStationaryDelay -
+                                    g.MouseStationaryTimer));
+
+  // Text cursor blink (see InputTextEx(): visible for 0.80f out of 1.20f)
+  if (g.InputTextState.ID != 0 && g.InputTextState.ID == g.ActiveId &&
+      g.IO.ConfigInputTextCursorBlink) {
+    const float anim = g.InputTextState.CursorAnim;
+    const float phase = (anim <= 0.0f) ? anim : Fmod(anim, 1.20f);
+    deadline = Min(deadline, now + ((phase <= 0.80f) ? 0.80f - phase
+                                                     : 1.20f - phase));
+  }
+  return deadline;
+}
+
 static DrawList *GetViewportBgFgDrawList(ViewportP *viewport,
                                          size_t drawlist_no,
                                          const char *drawlist_name) {
@@ -4026,6 +4419,9 @@ static DrawList *GetViewportBgFgDrawList(ViewportP *viewport,
   // Our DrawList system requires that there is always a command
   if (viewport->BgFgDrawListsLastFrame[drawlist_no] != g.FrameCount) {
     draw_list->_ResetForNewFrame();
+#ifdef USE_DRAWVERT_COMPACT
+    draw_list->VtxOrigin = viewport->Pos;
+#endif
     draw_list->PushTextureID(g.IO.Fonts->TexID);
     draw_list->PushClipRect(viewport->Pos, viewport->Pos + viewport->Size,
                             false);
@@ -4406,6 +4802,21 @@ void Gui::NewFrame() {
   // Load settings on first frame, save settings when modified (after a delay)
   UpdateSettings();
 
+  // Transient allocations of the previous frame are released
+  g.FrameArena.Reset();
+#ifndef DISABLE_DEBUG_TOOLS
+  DebugAllocInfo *alloc_info = &g.DebugAllocInfo;
+  if (alloc_info->LastEntriesBuf[alloc_info->LastEntriesIdx].FrameCount ==
+      g.FrameCount)
+    alloc_info->NoAllocFramesCount = 0;
+  else
+    alloc_info->NoAllocFramesCount++;
+  alloc_info->AssertFramesCount =
+      g.IO.ConfigDebugAssertNoSteadyStateAllocs
+          ? alloc_info->AssertFramesCount + 1
+          : 0;
+#endif
+
   g.Time += g.IO.DeltaTime;
   g.WithinFrameScope = true;
   g.FrameCount += 1;
@@ -4431,13 +4842,21 @@ void Gui::NewFrame() {
   g.InputEventsTrail.resize(0);
   UpdateInputEvents(g.IO.ConfigInputTrickleEventQueue);
 
+  // Idle redraw scheduling: requests are satisfied by this frame
+  if (g.InputEventsTrail.Size > 0)
+    g.RedrawSettleFrames = 2;
+  else if (g.RedrawSettleFrames > 0)
+    g.RedrawSettleFrames--;
+  if (g.RedrawRequestTime <= g.Time)
+    g.RedrawRequestTime = FLT_MAX;
+
   // Update viewports (after processing input queue, so io.MouseHoveredViewport
   // is set)
   UpdateViewportsNewFrame();
 
   // Setup current font and draw list shared data
   // FIXME-VIEWPORT: the concept of a single ClipRectFullscreen is not ideal!
-  g.IO.Fonts->Locked = true;
+  AtomicAdd(&g.IO.Fonts->Locked, 1);
   SetCurrentFont(GetDefaultFont());
   assert(g.Font->IsLoaded());
   Rect virtual_space(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
@@ -4447,6 +4866,8 @@ void Gui::NewFrame() {
   g.DrawListSharedData.CurveTessellationTol = g.Style.CurveTessellationTol;
   g.DrawListSharedData.SetCircleTessellationMaxError(
       g.Style.CircleTessellationMaxError);
+  g.DrawListSharedData.Images =
+      (g.IO.Images && g.IO.Images->Pages.Size > 0) ? g.IO.Images : NULL;
   g.DrawListSharedData.InitialFlags = DrawListFlags_None;
   if (g.Style.AntiAliasedLines)
     g.DrawListSharedData.InitialFlags |= DrawListFlags_AntiAliasedLines;
@@ -4457,6 +4878,10 @@ void Gui::NewFrame() {
     g.DrawListSharedData.InitialFlags |= DrawListFlags_AntiAliasedFill;
   if (g.IO.BackendFlags & BackendFlags_RendererHasVtxOffset)
     g.DrawListSharedData.InitialFlags |= DrawListFlags_AllowVtxOffset;
+#ifdef USE_DRAWVERT_SDF
+  if (g.IO.BackendFlags & BackendFlags_RendererHasSdfShapes)
+    g.DrawListSharedData.InitialFlags |= DrawListFlags_SdfShapes;
+#endif
 
   // Mark rendering data as invalid to prevent user who may have a handle on it
   // to use it.
@@ -4744,6 +5169,33 @@ static void AddWindowToSortBuffer(Vector<Window *> *out_sorted_windows,
   }
 }
 
+// Record an opaque filled rectangle drawn in window->DrawList, for occlusion
+// culling in Render(). Rounded corners and the anti-aliased fringe are
+// excluded, and the result is clipped by the current clipping rectangle and
+// rounded inward to whole pixels.
+static void AddWindowOccluder(Window *window, const Rect &rect,
+                              unsigned int col, float rounding, int flags) {
+  Context &g = *GGui;
+  if (!g.IO.ConfigRenderOcclusionCulling ||
+      (col & COL32_A_MASK) != COL32_A_MASK)
+    return;
+  Rect r = rect;
+  if (rounding >= 0.5f && (flags & DrawFlags_RoundCornersNone) == 0) {
+    if ((flags & DrawFlags_RoundCornersMask_) == 0)
+      flags |= DrawFlags_RoundCornersDefault_;
+    if (flags & DrawFlags_RoundCornersTop)
+      r.Min.y += rounding;
+    if (flags & DrawFlags_RoundCornersBottom)
+      r.Max.y -= rounding;
+    r.Expand(-1.0f);
+  }
+  r.ClipWithFull(Rect(window->DrawList->_CmdHeader.ClipRect));
+  r.Min = Vec2(-Floor(-r.Min.x), -Floor(-r.Min.y));
+  r.Max = Floor(r.Max);
+  if (r.Min.x < r.Max.x && r.Min.y < r.Max.y)
+    window->OccluderRects.push_back(r);
+}
+
 static void AddWindowToDrawData(Window *window, int layer) {
   Context &g = *GGui;
   ViewportP *viewport = window->Viewport;
@@ -4753,9 +5205,18 @@ static void AddWindowToDrawData(Window *window, int layer) {
     window->DrawList->ChannelsMerge(); // Merge if user forgot to merge back.
                                        // Also required in Docking branch for
                                        // WindowFlags_DockNodeHost windows.
-  Gui::AddDrawListToDrawDataEx(&viewport->DrawDataP,
-                               viewport->DrawDataBuilder.Layers[layer],
+  DrawDataBuilder *builder = &viewport->DrawDataBuilder;
+  const int list_count = builder->Layers[layer]->Size;
+  Gui::AddDrawListToDrawDataEx(&viewport->DrawDataP, builder->Layers[layer],
                                window->DrawList);
+  if (g.IO.ConfigRenderOcclusionCulling &&
+      builder->Layers[layer]->Size > list_count)
+    for (const Rect &r : window->OccluderRects) {
+      DrawListOccluder occluder;
+      occluder.ListIndex = list_count;
+      occluder.Bounds = r;
+      builder->Occluders[layer].push_back(occluder);
+    }
   for (Window *child : window->DC.ChildWindows)
     if (IsWindowActiveAndVisible(
             child)) // Clipped children may have been marked not active
@@ -4784,8 +5245,79 @@ static void FlattenDrawDataIntoSingleLayer(DrawDataBuilder *builder) {
       continue;
     memcpy(builder->Layers[0]->Data + n, layer->Data,
            layer->Size * sizeof(DrawList *));
+    for (DrawListOccluder occluder : builder->Occluders[layer_n]) {
+      occluder.ListIndex += n;
+      builder->Occluders[0].push_back(occluder);
+    }
     n += layer->Size;
     layer->resize(0);
+    builder->Occluders[layer_n].resize(0);
+  }
+}
+
+static bool IsRectOccluded(const Rect &r, const DrawListOccluder *occluders,
+                           const DrawListOccluder *occluders_end) {
+  for (; occluders < occluders_end; occluders++)
+    if (occluders->Bounds.Contains(r))
+      return true;
+  return false;
+}
+
+// Occlusion culling (io.ConfigRenderOcclusionCulling): remove draw commands
+// entirely covered by an opaque area of a draw list rendered after them, then
+// remove draw lists left without anything to render. Callbacks are kept.
+// Commands are tested with their clipping rectangle, then with the bounding
+// box of their vertices. We only test against single occluders: commands
+// covered by the union of several of them are still rendered.
+static void CullOccludedDrawLists(DrawData *draw_data,
+                                  const Vector<DrawListOccluder> &occluders) {
+  int occluder_begin = occluders.Size;
+  for (int list_n = draw_data->CmdLists.Size - 1; list_n >= 0; list_n--) {
+    // Occluders in [occluder_begin, occluders.Size) belong to lists above
+    while (occluder_begin > 0 &&
+           occluders[occluder_begin - 1].ListIndex > list_n)
+      occluder_begin--;
+    if (occluder_begin == occluders.Size)
+      continue;
+
+    DrawList *draw_list = draw_data->CmdLists[list_n];
+    int write_n = 0;
+    bool has_visible_cmd = false;
+    for (int cmd_n = 0; cmd_n < draw_list->CmdBuffer.Size; cmd_n++) {
+      const DrawCmd &cmd = draw_list->CmdBuffer[cmd_n];
+      if (cmd.UserCallback == NULL) {
+        // Scissor rectangles are truncated by backends
+        Rect bounds(Floor(cmd.ClipRect.x), Floor(cmd.ClipRect.y),
+                    cmd.ClipRect.z, cmd.ClipRect.w);
+        if (IsRectOccluded(bounds, occluders.begin() + occluder_begin,
+                           occluders.end()))
+          continue;
+        if (cmd.ElemCount > 0) {
+          const DrawIdx *idx = draw_list->IdxBuffer.Data + cmd.IdxOffset;
+          const DrawVert *vtx = draw_list->VtxBuffer.Data + cmd.VtxOffset;
+          Rect vtx_bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+          for (unsigned int n = 0; n < cmd.ElemCount; n++)
+            vtx_bounds.Add(draw_list->_VtxGetPos(&vtx[idx[n]]));
+          vtx_bounds.Min = Floor(vtx_bounds.Min);
+          bounds.ClipWithFull(vtx_bounds);
+          if (IsRectOccluded(bounds, occluders.begin() + occluder_begin,
+                             occluders.end()))
+            continue;
+        }
+      }
+      if (cmd.ElemCount > 0 || cmd.UserCallback != NULL)
+        has_visible_cmd = true;
+      if (write_n != cmd_n)
+        draw_list->CmdBuffer[write_n] = cmd;
+      write_n++;
+    }
+    draw_list->CmdBuffer.resize(write_n);
+    if (has_visible_cmd)
+      continue;
+    draw_data->CmdLists.erase(draw_data->CmdLists.Data + list_n);
+    draw_data->CmdListsCount--;
+    draw_data->TotalVtxCount -= draw_list->VtxBuffer.Size;
+    draw_data->TotalIdxCount -= draw_list->IdxBuffer.Size;
   }
 }
 
@@ -4798,6 +5330,8 @@ static void InitViewportDrawData(ViewportP *viewport) {
   viewport->DrawDataBuilder.Layers[1] = &viewport->DrawDataBuilder.LayerData1;
   viewport->DrawDataBuilder.Layers[0]->resize(0);
   viewport->DrawDataBuilder.Layers[1]->resize(0);
+  viewport->DrawDataBuilder.Occluders[0].resize(0);
+  viewport->DrawDataBuilder.Occluders[1].resize(0);
 
   // When minimized, we report draw_data->DisplaySize as zero to be consistent
   // with non-viewport mode, and to allow applications/backends to easily skip
@@ -5103,7 +5637,7 @@ void Gui::EndFrame() {
   g.IO.MetricsActiveWindows = g.WindowsActiveCount;
 
   // Unlock font atlas
-  g.IO.Fonts->Locked = false;
+  AtomicAdd(&g.IO.Fonts->Locked, (unsigned int)-1);
 
   // Clear Input data for next frame
   g.IO.MousePosPrev = g.IO.MousePos;
@@ -5178,6 +5712,9 @@ void Gui::Render() {
   g.IO.MetricsRenderVertices = g.IO.MetricsRenderIndices = 0;
   for (ViewportP *viewport : g.Viewports) {
     FlattenDrawDataIntoSingleLayer(&viewport->DrawDataBuilder);
+    if (g.IO.ConfigRenderOcclusionCulling)
+      CullOccludedDrawLists(&viewport->DrawDataP,
+                            viewport->DrawDataBuilder.Occluders[0]);
 
     // Add foreground DrawList (for each active viewport)
     if (viewport->BgFgDrawLists[1] != NULL)
@@ -5475,6 +6012,12 @@ bool Gui::BeginChild(int id, const Vec2 &size_arg, int child_flags,
   return BeginChildEx(NULL, id, size_arg, child_flags, window_flags);
 }
 
+bool Gui::BeginChild(const StrID &str_id, const Vec2 &size_arg,
+                     int child_flags, int window_flags) {
+  int id = GetCurrentWindow()->GetID(str_id);
+  return BeginChildEx(str_id.Str, id, size_arg, child_flags, window_flags);
+}
+
 bool Gui::BeginChildEx(const char *name, int id, const Vec2 &size_arg,
                        int child_flags, int window_flags) {
   Context &g = *GGui;
@@ -6502,10 +7045,15 @@ void Gui::RenderWindowDecorations(Window *window, const Rect &title_bar_rect,
                                    : window->DrawList;
       if (window->DockIsActive || (flags & WindowFlags_DockNodeHost))
         bg_draw_list->ChannelsSetCurrent(DOCKING_HOST_DRAW_CHANNEL_BG);
-      bg_draw_list->AddRectFilled(
-          window->Pos + Vec2(0, window->TitleBarHeight()),
-          window->Pos + window->Size, bg_col, window_rounding,
-          (flags & WindowFlags_NoTitleBar) ? 0 : DrawFlags_RoundCornersBottom);
+      const Rect bg_rect(window->Pos + Vec2(0, window->TitleBarHeight()),
+                         window->Pos + window->Size);
+      const int bg_rounding_flags =
+          (flags & WindowFlags_NoTitleBar) ? 0 : DrawFlags_RoundCornersBottom;
+      bg_draw_list->AddRectFilled(bg_rect.Min, bg_rect.Max, bg_col,
+                                  window_rounding, bg_rounding_flags);
+      AddWindowOccluder(window->DockIsActive ? window->DockNode->HostWindow
+                                             : window,
+                        bg_rect, bg_col, window_rounding, bg_rounding_flags);
       if (window->DockIsActive || (flags & WindowFlags_DockNodeHost))
         bg_draw_list->ChannelsSetCurrent(DOCKING_HOST_DRAW_CHANNEL_FG);
     }
@@ -6827,16 +7375,25 @@ Window *Gui::FindBlockingModal(Window *window) {
 // the window, the pointed value will be set to false when the button is
 // pressed.
 bool Gui::Begin(const char *name, bool *p_open, int flags) {
+  assert(name != NULL && name[0] != '\0'); // Window name required
+  return BeginEx(name, HashStr(name), p_open, flags);
+}
+
+bool Gui::Begin(const StrID &name, bool *p_open, int flags) {
+  assert(name.Str != NULL && name.Str[0] != '\0'); // Window name required
+  return BeginEx(name.Str, name.Hash, p_open, flags);
+}
+
+bool Gui::BeginEx(const char *name, int id, bool *p_open, int flags) {
   Context &g = *GGui;
   const Style &style = g.Style;
-  assert(name != NULL && name[0] != '\0'); // Window name required
-  assert(g.WithinFrameScope);              // Forgot to call Gui::NewFrame()
+  assert(g.WithinFrameScope); // Forgot to call Gui::NewFrame()
   assert(g.FrameCountEnded !=
          g.FrameCount); // Called Gui::Render() or Gui::EndFrame() and
                         // haven't called Gui::NewFrame() again yet
 
   // Find or create
-  Window *window = FindWindowByName(name);
+  Window *window = FindWindowByID(id);
   const bool window_just_created = (window == NULL);
   if (window_just_created)
     window = CreateNewWindow(name, flags);
@@ -7058,6 +7615,7 @@ bool Gui::Begin(const char *name, bool *p_open, int flags) {
     window->ClipRect = Vec4(-FLT_MAX, -FLT_MAX, +FLT_MAX, +FLT_MAX);
     window->IDStack.resize(1);
     window->DrawList->_ResetForNewFrame();
+    window->OccluderRects.resize(0);
     window->DC.CurrentTableIdx = -1;
     if (flags & WindowFlags_DockNodeHost) {
       window->DrawList->ChannelsSplit(2);
@@ -7137,6 +7695,10 @@ bool Gui::Begin(const char *name, bool *p_open, int flags) {
 
     WindowSelectViewport(window);
     SetCurrentViewport(window, window->Viewport);
+#ifdef USE_DRAWVERT_COMPACT
+    // Keep compact vertex positions in range on any monitor
+    window->DrawList->VtxOrigin = window->Viewport->Pos;
+#endif
     window->FontDpiScale = (g.IO.ConfigFlags & ConfigFlags_DpiEnableScaleFonts)
                                ? window->Viewport->DpiScale
                                : 1.0f;
@@ -8942,6 +9504,13 @@ void Gui::PushID(int int_id) {
   window->IDStack.push_back(id);
 }
 
+void Gui::PushID(const StrID &str_id) {
+  Context &g = *GGui;
+  Window *window = g.CurrentWindow;
+  int id = window->GetID(str_id);
+  window->IDStack.push_back(id);
+}
+
 // Push a given id value ignoring the int stack as a seed.
 void Gui::PushOverrideID(int id) {
   Context &g = *GGui;
@@ -8995,6 +9564,11 @@ int Gui::GetID(const void *ptr_id) {
   return window->GetID(ptr_id);
 }
 
+int Gui::GetID(const StrID &str_id) {
+  Window *window = GGui->CurrentWindow;
+  return window->GetID(str_id);
+}
+
 bool Gui::IsRectVisible(const Vec2 &size) {
   Window *window = GGui->CurrentWindow;
   return window->ClipRect.Overlaps(
@@ -10379,6 +10953,15 @@ void Gui::UpdateInputEvents(bool trickle_fast_inputs) {
   const bool trickle_interleaved_keys_and_text =
       (trickle_fast_inputs && g.WantTextInputNextFrame == 1);
 
+  // Collect events posted from other threads, in posting order
+  InputEvent posted_event;
+  while (g.InputEventsPosted.Pop(&posted_event))
+    QueueInputEvent(&g, &posted_event);
+  if (unsigned int dropped =
+          AtomicExchange(&g.InputEventsPosted.DroppedCount, 0))
+    DEBUG_LOG_IO("[io] Dropped %u input events: posting queue is full.\n",
+                 dropped);
+
   bool mouse_moved = false, mouse_wheeled = false, key_changed = false,
        text_inputted = false;
   int mouse_button_changed = 0x00;
@@ -10944,6 +11527,8 @@ static void Gui::ErrorCheckEndFrameSanityChecks() {
   }
 
   ASSERT_USER_ERROR(g.GroupStack.Size == 0, "Missing EndGroup call!");
+  ASSERT_USER_ERROR(g.LazyRegionStack.Size == 0,
+                    "Missing EndLazyRegion call!");
 }
 
 // Experimental recovery from incorrect usage of BeginXXX/EndXXX/PushXXX/PopXXX
@@ -11006,6 +11591,16 @@ void Gui::ErrorCheckEndWindowRecover(ErrorLogCallback log_callback,
                    window->Name);
     TreePop();
   }
+  while (g.LazyRegionStack.Size > 0 &&
+         g.GroupStack.Size > stack_sizes->SizeOfGroupStack &&
+         g.LazyRegions.GetByIndex(g.LazyRegionStack.back())->WindowID ==
+             window->ID) {
+    if (log_callback)
+      log_callback(user_data,
+                   "Recovered from missing EndLazyRegion() in '%s'",
+                   window->Name);
+    EndLazyRegion();
+  }
   while (g.GroupStack.Size > stack_sizes->SizeOfGroupStack) //-V1044
   {
     if (log_callback)
@@ -11236,10 +11831,11 @@ bool Gui::ItemAdd(const Rect &bb, int id, const Rect *nav_bb_arg,
     //      unfortunately, but it is still limited to one window. It may not
     //      scale very well for windows with ten of thousands of item, but at
     //      least NavMoveRequest is only set on user interaction, aka maximum
-    //      once a frame. We could early out with "if (is_clipped &&
-    //      !g.NavInitRequest) return false;" but when we wouldn't be able to
-    //      reach unclipped widgets. This would work if user had explicit
-    //      scrolling control (e.g. mapped on a stick).
+    //      once a frame. NavScoreItem() rejects items behind the move
+    //      direction before computing their scores. We could early out with
+    //      "if (is_clipped && !g.NavInitRequest) return false;" but when we
+    //      wouldn't be able to reach unclipped widgets. This would work if
+    //      user had explicit scrolling control (e.g. mapped on a stick).
     // We intentionally don't check if g.NavWindow != NULL because
     // g.NavAnyRequest should only be set when it is non null. If we crash on a
     // NULL g.NavWindow we need to fix the bug elsewhere.
@@ -11680,6 +12276,74 @@ void Gui::EndGroup() {
                               COL32(255, 0, 255, 255)); // [Debug]
 }
 
+bool Gui::BeginLazyRegion(const char *str_id, const Vec2 &size_estimate) {
+  Window *window = GetCurrentWindow();
+  if (window->SkipItems)
+    return false;
+  return BeginLazyRegion(window->GetID(str_id), size_estimate);
+}
+
+// The region is submitted as a group, measured by EndLazyRegion(). When it
+// was measured (or estimated) outside of the clipping rectangle, we emit the
+// same item as EndGroup() would instead, so the layout doesn't change.
+bool Gui::BeginLazyRegion(int id, const Vec2 &size_estimate) {
+  Context &g = *GGui;
+  Window *window = GetCurrentWindow();
+  if (window->SkipItems)
+    return false;
+
+  LazyRegionData *region = NULL;
+  if (g.LazyRegionsNextIdx < g.LazyRegions.Buf.Size &&
+      g.LazyRegions.Buf[g.LazyRegionsNextIdx].ID == id)
+    region = g.LazyRegions.GetByIndex(g.LazyRegionsNextIdx);
+  else
+    region = g.LazyRegions.GetOrAddByKey(id);
+  if (region->ID != id) {
+    region->ID = id;
+    region->Size = size_estimate;
+  }
+  region->WindowID = window->ID;
+  g.LazyRegionsNextIdx = g.LazyRegions.GetIndex(region) + 1;
+
+  const Rect bb(window->DC.CursorPos, window->DC.CursorPos + region->Size);
+  bool submit = region->Size.y <= 0.0f || g.LogEnabled ||
+                (region->ActiveId != 0 && region->ActiveId == g.ActiveId);
+  if (!submit) {
+    // Keep navigation working across skipped regions, like ListClipper
+    Rect clip_rect = window->ClipRect;
+    if (g.NavMoveScoringItems && g.NavWindow &&
+        g.NavWindow->RootWindowForNav == window->RootWindowForNav)
+      clip_rect.Add(g.NavScoringNoClipRect);
+    if (g.NavId != 0 && window->NavLastIds[0] == g.NavId)
+      submit = bb.Overlaps(WindowRectRelToAbs(window, window->NavRectRel[0]));
+    submit |= bb.Overlaps(clip_rect);
+  }
+  if (!submit) {
+    ItemSize(region->Size);
+    ItemAdd(bb, 0, NULL, ItemFlags_NoTabStop);
+    return false;
+  }
+
+  g.LazyRegionStack.push_back(g.LazyRegions.GetIndex(region));
+  BeginGroup();
+  return true;
+}
+
+void Gui::EndLazyRegion() {
+  Context &g = *GGui;
+  Window *window = g.CurrentWindow;
+  assert(g.LazyRegionStack.Size >
+         0); // Mismatched BeginLazyRegion()/EndLazyRegion() calls
+  LazyRegionData *region = g.LazyRegions.GetByIndex(g.LazyRegionStack.back());
+  assert(region->WindowID == window->ID); // EndLazyRegion() in wrong window?
+  g.LazyRegionStack.pop_back();
+
+  // EndGroup() sets LastItemData.ID when the active item was in the group
+  EndGroup();
+  region->Size = g.LastItemData.Rect.GetSize();
+  region->ActiveId = g.LastItemData.ID;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] SCROLLING
 //-----------------------------------------------------------------------------
@@ -12846,6 +13510,23 @@ static bool Gui::NavScoreItem(NavItemData *result) {
                            // candidates in the parent window
   }
 
+  // Compute distance between centers (this is off by a factor of 2, but we only
+  // compare center distances with each other so it doesn't matter)
+  const int move_dir = g.NavMoveDir;
+  float dcx = (cand.Min.x + cand.Max.x) - (curr.Min.x + curr.Max.x);
+  float dcy = (cand.Min.y + cand.Max.y) - (curr.Min.y + curr.Max.y);
+
+  // Early out on candidates whose center lies behind 'curr' in the move
+  // direction: they can't land in the 'move_dir' quadrant nor pass the axial
+  // check below, whether box or center distances are used (box distances on
+  // the move axis have the same sign as center distances when non-zero).
+#if !DEBUG_NAV_SCORING
+  if ((move_dir == Dir_Left && dcx > 0.0f) ||
+      (move_dir == Dir_Right && dcx < 0.0f) ||
+      (move_dir == Dir_Up && dcy > 0.0f) || (move_dir == Dir_Down && dcy < 0.0f))
+    return false;
+#endif
+
   // Compute distance between boxes
   // FIXME-NAV: Introducing biases for vertical navigation, needs to be removed.
   float dbx =
@@ -12859,11 +13540,6 @@ static bool Gui::NavScoreItem(NavItemData *result) {
   if (dby != 0.0f && dbx != 0.0f)
     dbx = (dbx / 1000.0f) + ((dbx > 0.0f) ? +1.0f : -1.0f);
   float dist_box = Fabs(dbx) + Fabs(dby);
-
-  // Compute distance between centers (this is off by a factor of 2, but we only
-  // compare center distances with each other so it doesn't matter)
-  float dcx = (cand.Min.x + cand.Max.x) - (curr.Min.x + curr.Max.x);
-  float dcy = (cand.Min.y + cand.Max.y) - (curr.Min.y + curr.Max.y);
   float dist_center =
       Fabs(dcx) +
       Fabs(dcy); // L1 metric (need this for our connectedness guarantee)
@@ -12892,7 +13568,6 @@ static bool Gui::NavScoreItem(NavItemData *result) {
     quadrant = (g.LastItemData.ID < g.NavId) ? Dir_Left : Dir_Right;
   }
 
-  const int move_dir = g.NavMoveDir;
 #if DEBUG_NAV_SCORING
   char buf[200];
   if (g.IO.KeyCtrl) // Hold CTRL to preview score in matching quadrant.
@@ -16648,28 +17323,101 @@ void Gui::UpdatePlatformWindows() {
 //        == 0)
 //            MySwapBufferFunction(platform_io.Viewports[i], my_args);
 //
+// Job of RenderPlatformWindowsDefault() rendering one viewport, possibly on
+// another thread: the current context and allocator functions of the calling
+// thread are set up first (they are per thread with USE_THREAD_LOCAL_CONTEXT).
+struct RenderPlatformWindowsJobData {
+  Context *Ctx;
+  MemAllocFunc AllocFunc;
+  MemFreeFunc FreeFunc;
+  void *AllocUserData;
+  void *RenderArg;
+};
+
+static void RenderPlatformWindowJob(int n, void *job_data) {
+  RenderPlatformWindowsJobData *data = (RenderPlatformWindowsJobData *)job_data;
+  Context *backup_ctx = Gui::GetCurrentContext();
+  MemAllocFunc backup_alloc_func;
+  MemFreeFunc backup_free_func;
+  void *backup_alloc_user_data;
+  Gui::GetAllocatorFunctions(&backup_alloc_func, &backup_free_func,
+                             &backup_alloc_user_data);
+
+  // Only write when different, as those are shared globals when not using
+  // USE_THREAD_LOCAL_CONTEXT.
+  const bool set_ctx = (backup_ctx != data->Ctx);
+  const bool set_alloc = (backup_alloc_func != data->AllocFunc ||
+                          backup_free_func != data->FreeFunc ||
+                          backup_alloc_user_data != data->AllocUserData);
+  if (set_ctx)
+    Gui::SetCurrentContext(data->Ctx);
+  if (set_alloc)
+    Gui::SetAllocatorFunctions(data->AllocFunc, data->FreeFunc,
+                               data->AllocUserData);
+  PlatformIO &platform_io = data->Ctx->PlatformIO;
+  platform_io.Renderer_RenderWindow(data->Ctx->PlatformWindowsToRender[n],
+                                    data->RenderArg);
+  if (set_alloc)
+    Gui::SetAllocatorFunctions(backup_alloc_func, backup_free_func,
+                               backup_alloc_user_data);
+  if (set_ctx)
+    Gui::SetCurrentContext(backup_ctx);
+}
+
 void Gui::RenderPlatformWindowsDefault(void *platform_render_arg,
                                        void *renderer_render_arg) {
   // Skip the main viewport (index 0), which is always fully handled by the
   // application!
-  PlatformIO &platform_io = Gui::GetPlatformIO();
-  for (int i = 1; i < platform_io.Viewports.Size; i++) {
-    Viewport *viewport = platform_io.Viewports[i];
-    if (viewport->Flags & ViewportFlags_IsMinimized)
-      continue;
+  Context &g = *GGui;
+  PlatformIO &platform_io = g.PlatformIO;
+  Vector<Viewport *> &viewports = g.PlatformWindowsToRender;
+  viewports.resize(0);
+  for (int i = 1; i < platform_io.Viewports.Size; i++)
+    if (!(platform_io.Viewports[i]->Flags & ViewportFlags_IsMinimized))
+      viewports.push_back(platform_io.Viewports[i]);
+
+  const bool render_in_parallel =
+      platform_io.ParallelFor != NULL &&
+      platform_io.Renderer_RenderWindow != NULL &&
+      (g.IO.BackendFlags & BackendFlags_RendererHasParallelViewports) &&
+      viewports.Size > 1;
+  if (render_in_parallel) {
+    // Platform side (e.g. making a graphics context current) stays serial
     if (platform_io.Platform_RenderWindow)
-      platform_io.Platform_RenderWindow(viewport, platform_render_arg);
-    if (platform_io.Renderer_RenderWindow)
-      platform_io.Renderer_RenderWindow(viewport, renderer_render_arg);
+      for (Viewport *viewport : viewports)
+        platform_io.Platform_RenderWindow(viewport, platform_render_arg);
+    RenderPlatformWindowsJobData job_data;
+    job_data.Ctx = &g;
+    GetAllocatorFunctions(&job_data.AllocFunc, &job_data.FreeFunc,
+                          &job_data.AllocUserData);
+    job_data.RenderArg = renderer_render_arg;
+    g.DebugAllocHookDisabled = true;
+    platform_io.ParallelFor(viewports.Size, RenderPlatformWindowJob, &job_data,
+                            platform_io.ParallelForUserData);
+    g.DebugAllocHookDisabled = false;
+  } else {
+    for (Viewport *viewport : viewports) {
+      if (platform_io.Platform_RenderWindow)
+        platform_io.Platform_RenderWindow(viewport, platform_render_arg);
+      if (platform_io.Renderer_RenderWindow)
+        platform_io.Renderer_RenderWindow(viewport, renderer_render_arg);
+    }
   }
-  for (int i = 1; i < platform_io.Viewports.Size; i++) {
-    Viewport *viewport = platform_io.Viewports[i];
-    if (viewport->Flags & ViewportFlags_IsMinimized)
-      continue;
+
+  if (platform_io.Renderer_SwapBuffersBatch) {
     if (platform_io.Platform_SwapBuffers)
-      platform_io.Platform_SwapBuffers(viewport, platform_render_arg);
-    if (platform_io.Renderer_SwapBuffers)
-      platform_io.Renderer_SwapBuffers(viewport, renderer_render_arg);
+      for (Viewport *viewport : viewports)
+        platform_io.Platform_SwapBuffers(viewport, platform_render_arg);
+    if (viewports.Size > 0)
+      platform_io.Renderer_SwapBuffersBatch(viewports.Data, viewports.Size,
+                                            renderer_render_arg);
+  } else {
+    for (Viewport *viewport : viewports) {
+      if (platform_io.Platform_SwapBuffers)
+        platform_io.Platform_SwapBuffers(viewport, platform_render_arg);
+      if (platform_io.Renderer_SwapBuffers)
+        platform_io.Renderer_SwapBuffers(viewport, renderer_render_arg);
+    }
   }
 }
 
@@ -17193,6 +17941,8 @@ void Gui::DockContextEndFrame(Context *ctx) {
         node->HostWindow->DrawList->AddRectFilled(
             bg_rect.Min, bg_rect.Max, node->LastBgColor,
             node->HostWindow->WindowRounding, bg_rounding_flags);
+        AddWindowOccluder(node->HostWindow, bg_rect, node->LastBgColor,
+                          node->HostWindow->WindowRounding, bg_rounding_flags);
       }
 }
 
@@ -21927,9 +22677,9 @@ void Gui::ShowMetricsWindow(bool *p_open) {
         "You can also call Gui::DebugTextEncoding() from your code with a "
         "given string to test that your UTF-8 encoding settings are correct.");
     if (show_encoding_viewer) {
-      static char buf[100] = "";
+      char *buf = cfg->EncodingViewerBuf;
       SetNextItemWidth(-FLT_MIN);
-      InputText("##Text", buf, ARRAYSIZE(buf));
+      InputText("##Text", buf, ARRAYSIZE(cfg->EncodingViewerBuf));
       if (buf[0] != 0)
         DebugTextEncoding(buf);
       TreePop();
@@ -22130,11 +22880,11 @@ void Gui::ShowMetricsWindow(bool *p_open) {
                g.IO.MouseHoveredViewport,
                g.MouseLastHoveredViewport ? g.MouseLastHoveredViewport->ID : 0);
     if (TreeNode("Inferred Z order (front-to-back)")) {
-      static Vector<ViewportP *> viewports;
-      viewports.resize(g.Viewports.Size);
+      Span<ViewportP *> viewports(
+          FrameAllocArray<ViewportP *>(g.Viewports.Size), g.Viewports.Size);
       memcpy(viewports.Data, g.Viewports.Data, g.Viewports.size_in_bytes());
-      if (viewports.Size > 1)
-        Qsort(viewports.Data, viewports.Size, sizeof(Viewport *),
+      if (viewports.size() > 1)
+        Qsort(viewports.Data, viewports.size(), sizeof(Viewport *),
               ViewportComparerByLastFocusedStampCount);
       for (ViewportP *viewport : viewports)
         BulletText(
@@ -22215,9 +22965,8 @@ void Gui::ShowMetricsWindow(bool *p_open) {
   // Details for Docking
 #ifdef HAS_DOCK
   if (TreeNode("Docking")) {
-    static bool root_nodes_only = true;
     DockContext *dc = &g.DockContext;
-    Checkbox("List root nodes", &root_nodes_only);
+    Checkbox("List root nodes", &cfg->ShowDockingRootNodesOnly);
     Checkbox("Ctrl shows window dock info", &cfg->ShowDockingNodes);
     if (SmallButton("Clear nodes")) {
       DockContextClearNodes(&g, 0, true);
@@ -22228,7 +22977,7 @@ void Gui::ShowMetricsWindow(bool *p_open) {
     }
     for (int n = 0; n < dc->Nodes.Data.Size; n++)
       if (DockNode *node = (DockNode *)dc->Nodes.Data[n].val_p)
-        if (!root_nodes_only || node->IsRootNode())
+        if (!cfg->ShowDockingRootNodesOnly || node->IsRootNode())
           DebugNodeDockNode(node, "Node");
     TreePop();
   }
@@ -22332,6 +23081,12 @@ void Gui::ShowMetricsWindow(bool *p_open) {
                  entry->AllocCount, entry->FreeCount,
                  (n == 0) ? " (most recent)" : "");
     }
+    Text("%d consecutive frames without allocations", info->NoAllocFramesCount);
+    Checkbox("io.ConfigDebugAssertNoSteadyStateAllocs",
+             &io.ConfigDebugAssertNoSteadyStateAllocs);
+    FrameArena *arena = &g.FrameArena;
+    Text("Frame arena: %d/%d bytes, last frame used %d bytes", arena->Size,
+         arena->Capacity, arena->LastFrameSize);
     TreePop();
   }
 
@@ -22859,7 +23614,8 @@ void Gui::DebugNodeDrawList(Window *window, ViewportP *viewport,
          idx_n < pcmd->IdxOffset + pcmd->ElemCount;) {
       Vec2 triangle[3];
       for (int n = 0; n < 3; n++, idx_n++)
-        triangle[n] = vtx_buffer[idx_buffer ? idx_buffer[idx_n] : idx_n].pos;
+        triangle[n] = draw_list->_VtxGetPos(
+            &vtx_buffer[idx_buffer ? idx_buffer[idx_n] : idx_n]);
       total_area += TriangleArea(triangle[0], triangle[1], triangle[2]);
     }
 
@@ -22889,12 +23645,13 @@ void Gui::DebugNodeDrawList(Window *window, ViewportP *viewport,
         for (int n = 0; n < 3; n++, idx_i++) {
           const DrawVert &v =
               vtx_buffer[idx_buffer ? idx_buffer[idx_i] : idx_i];
-          triangle[n] = v.pos;
+          const Vec2 uv = draw_list->_VtxGetUV(&v);
+          triangle[n] = draw_list->_VtxGetPos(&v);
           buf_p += FormatString(
               buf_p, buf_end - buf_p,
               "%s %04d: pos (%8.2f,%8.2f), uv (%.6f,%.6f), col %08X\n",
-              (n == 0) ? "Vert:" : "     ", idx_i, v.pos.x, v.pos.y, v.uv.x,
-              v.uv.y, v.col);
+              (n == 0) ? "Vert:" : "     ", idx_i, triangle[n].x,
+              triangle[n].y, uv.x, uv.y, v.col);
         }
 
         Selectable(buf, false);
@@ -22944,9 +23701,8 @@ void Gui::DebugNodeDrawCmdShowMeshAndBoundingBox(DrawList *out_draw_list,
 
     Vec2 triangle[3];
     for (int n = 0; n < 3; n++, idx_n++)
-      vtxs_rect.Add(
-          (triangle[n] =
-               vtx_buffer[idx_buffer ? idx_buffer[idx_n] : idx_n].pos));
+      vtxs_rect.Add((triangle[n] = draw_list->_VtxGetPos(
+                         &vtx_buffer[idx_buffer ? idx_buffer[idx_n] : idx_n])));
     if (show_mesh)
       out_draw_list->AddPolyline(triangle, 3, COL32(255, 255, 0, 255),
                                  DrawFlags_Closed,
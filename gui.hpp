@@ -19,7 +19,7 @@
 // TextBuffer, Storage, ListClipper, Math Operators, Color) [SECTION] Drawing
 // API (DrawCallback, DrawCmd, DrawIdx, DrawVert, DrawChannel, DrawListSplitter,
 // DrawFlags, DrawListFlags, DrawList, DrawData) [SECTION] Font API (FontConfig,
-// FontGlyph, FontGlyphRangesBuilder, int, FontAtlas, Font) [SECTION]
+// FontGlyph, FontGlyphRangesBuilder, int, FontAtlas, Font, ImageAtlas) [SECTION]
 // Viewports (int, Viewport) [SECTION] Platform Dependent Interfaces
 // (PlatformIO, PlatformMonitor, PlatformImeData) [SECTION] Obsolete functions
 // and types
@@ -169,6 +169,8 @@ struct FontGlyph;     // A single font glyph (code point + coordinates within in
                       // FontAtlas + offset)
 struct FontGlyphRangesBuilder; // Helper to build glyph ranges from
                                // text/string data
+struct ImageAtlas; // Runtime atlas packing small user images into shared
+                   // textures, so that drawing them doesn't split draw calls
 } // namespace Gui
 struct Color;   // Helper functions to create a color that can be converted to
                 // either u32 or float4 (*OBSOLETE* please avoid using)
@@ -196,16 +198,22 @@ struct SizeCallbackData; // Callback data when using
                          // SetNextWindowSizeConstraints() (rare/advanced
                          // use)
 struct Storage;          // Helper for key->value storage
+struct StrID;            // String id or label hashed at compile-time, for
+                         // the widgets overloads taking one
 struct Style;            // Runtime data for styling/colors
 struct TableSortSpecs;   // Sorting specifications for a table (often
                          // handling sort specs for a single column,
                          // occasionally more)
 struct TableColumnSortSpecs; // Sorting specification for one column of a
                              // table
+struct TableRowClipper; // Helper to manually clip large tables with rows of
+                        // varying height
 struct TextBuffer;  // Helper to hold and append into a text buffer (~string
                     // builder)
 struct TextFilter;  // Helper to parse and apply text filters (e.g.
                     // "aaaaa[,bbbbb][,ccccc]")
+struct TreeClipper; // Helper to manually clip large trees, submitting only
+                    // the visible rows of the expanded hierarchy
 struct Viewport;    // A Platform Window (always 1 unless multi-viewport are
                     // enabled. One per platform window to output to). In the
                     // future may represent Platform Monitor
@@ -312,6 +320,57 @@ struct Vec4 {
 };
 MSVC_RUNTIME_CHECKS_RESTORE
 
+// StrID: string id or label hashed at compile-time, e.g. Button(StrID("Save"))
+// or PushID(StrID("section")), to skip hashing static strings every frame.
+// - Hash is the value of HashStr(Str) (with seed 0, "###" included): the int
+// produced with the current int stack is bit-identical to the one from the
+// const char* overloads, so both can be mixed freely. Combining it with the
+// seed at the top of the int stack doesn't read the string and is generally a
+// lookup in a per-window cache.
+// - Must be constructed from a string literal or another constant expression.
+// The constructor is 'consteval' when the compiler supports it, guaranteeing
+// the hash is computed at compile-time. Before C++20 it is 'constexpr': the
+// hash is still computed at compile-time when StrID is used in a constant
+// expression, and at runtime otherwise.
+#if defined(__cpp_consteval)
+#define STRID_CONSTEVAL consteval
+#else
+#define STRID_CONSTEVAL constexpr
+#endif
+struct StrID {
+  const char *Str; // String, used as label by widgets ("##" and "###" are
+                   // handled the usual way)
+  int Hash;        // == HashStr(Str), i.e. hashed with a zero seed
+  int HashedLen;   // Number of characters hashed (from the last "###")
+
+  STRID_CONSTEVAL StrID(const char *str)
+      : Str(str), Hash((int)~Crc32(HashedPart(str, str), 0xFFFFFFFF)),
+        HashedLen(Length(HashedPart(str, str))) {}
+
+  // Helpers written as single return statements so they are valid C++11
+  // constexpr functions.
+  // Only the part starting at the last "###" contributes to the hash
+  static constexpr const char *HashedPart(const char *p, const char *hashed) {
+    return *p == 0 ? hashed
+                   : HashedPart(p + 1, (p[0] == '#' && p[1] == '#' &&
+                                        p[2] == '#')
+                                           ? p
+                                           : hashed);
+  }
+  static constexpr int Length(const char *p) {
+    return *p == 0 ? 0 : 1 + Length(p + 1);
+  }
+  static constexpr unsigned int Crc32Bits(unsigned int crc, int bits) {
+    return bits == 0 ? crc
+                     : Crc32Bits((crc >> 1) ^ (0xEDB88320 & (0u - (crc & 1))),
+                                 bits - 1);
+  }
+  static constexpr unsigned int Crc32(const char *p, unsigned int crc) {
+    return *p == 0 ? crc
+                   : Crc32(p + 1, Crc32Bits(crc ^ (unsigned char)*p, 8));
+  }
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Gui end-user API functions
 // (Note that Gui:: being a namespace, you can add extra Gui:: functions in
@@ -415,6 +474,7 @@ API void StyleColorsClassic(Style *dst = NULL); // classic imgui style
 // - Note that the bottom of window stack always contains a window called
 // "Debug".
 API bool Begin(const char *name, bool *p_open = NULL, int flags = 0);
+API bool Begin(const StrID &name, bool *p_open = NULL, int flags = 0);
 API void End();
 
 // Child Windows
@@ -453,6 +513,8 @@ API bool BeginChild(const char *str_id, const Vec2 &size = Vec2(0, 0),
                     int child_flags = 0, int window_flags = 0);
 API bool BeginChild(int id, const Vec2 &size = Vec2(0, 0), int child_flags = 0,
                     int window_flags = 0);
+API bool BeginChild(const StrID &str_id, const Vec2 &size = Vec2(0, 0),
+                    int child_flags = 0, int window_flags = 0);
 API void EndChild();
 
 // Windows Utilities
@@ -770,6 +832,25 @@ GetFrameHeightWithSpacing(); // ~ FontSize + style.FramePadding.y * 2 +
                              // style.ItemSpacing.y (distance in pixels between
                              // 2 consecutive lines of framed widgets)
 
+// Lazy Regions
+// - Skip a whole block of code while it is scrolled out of view (e.g. a
+// property section, a complex composite widget), instead of submitting all of
+// its items to have them individually clipped.
+// - The region is a group (see BeginGroup()) whose size is remembered each time
+// it is submitted. While that rectangle lies outside of the window clipping
+// rectangle, BeginLazyRegion() returns false and advances the cursor by the
+// remembered size: don't submit the contents and don't call EndLazyRegion().
+// - 'size_estimate' is used until the region has been submitted once. With a
+// zero height, the region is always submitted the first time.
+// - A region is still submitted while it contains the active item, the
+// navigation target or when logging. A size change of skipped contents is only
+// seen once they become visible again, which may move the items below.
+API bool BeginLazyRegion(const char *str_id,
+                         const Vec2 &size_estimate = Vec2(0, 0));
+API bool BeginLazyRegion(int id, const Vec2 &size_estimate = Vec2(0, 0));
+API void EndLazyRegion(); // only call EndLazyRegion() if BeginLazyRegion()
+                          // returns true!
+
 // int stack/scopes
 // - These questions are answered and impacted by understanding of the int stack
 // system:
@@ -795,6 +876,8 @@ API void PushID(
     const void *ptr_id); // push pointer into the int stack (will hash pointer).
 API void
 PushID(int int_id); // push integer into the int stack (will hash integer).
+API void PushID(const StrID &str_id); // push string hashed at compile-time
+                                      // into the int stack (see StrID).
 API void PopID();   // pop from the int stack.
 API int
 GetID(const char *str_id); // calculate unique int (hash of whole int stack
@@ -802,6 +885,7 @@ GetID(const char *str_id); // calculate unique int (hash of whole int stack
                            // query into Storage yourself
 API int GetID(const char *str_id_begin, const char *str_id_end);
 API int GetID(const void *ptr_id);
+API int GetID(const StrID &str_id);
 
 // Widgets: Text
 API void
@@ -848,6 +932,8 @@ API void SeparatorText(
 API bool Button(const char *label, const Vec2 &size = Vec2(0, 0)); // button
 API bool SmallButton(const char *label); // button with (FramePadding.y == 0) to
                                          // easily embed within text
+API bool Button(const StrID &label, const Vec2 &size = Vec2(0, 0));
+API bool SmallButton(const StrID &label);
 API bool InvisibleButton(
     const char *str_id, const Vec2 &size,
     int flags = 0); // flexible button behavior without the visuals, frequently
@@ -856,6 +942,7 @@ API bool InvisibleButton(
 API bool ArrowButton(const char *str_id,
                      int dir); // square button with an arrow shape
 API bool Checkbox(const char *label, bool *v);
+API bool Checkbox(const StrID &label, bool *v);
 API bool CheckboxFlags(const char *label, int *flags, int flags_value);
 API bool CheckboxFlags(const char *label, unsigned int *flags,
                        unsigned int flags_value);
@@ -1111,6 +1198,8 @@ API bool TreeNodeExV(const char *str_id, int flags, const char *fmt,
                      va_list args) FMTLIST(3);
 API bool TreeNodeExV(const void *ptr_id, int flags, const char *fmt,
                      va_list args) FMTLIST(3);
+API bool TreeNode(const StrID &label);
+API bool TreeNodeEx(const StrID &label, int flags = 0);
 API void
 TreePush(const char *str_id); // ~ Indent()+PushID(). Already called by
                               // TreeNode() when returning true, but you can
@@ -1132,6 +1221,8 @@ API bool CollapsingHeader(
                     // an additional small close button on upper right of the
                     // header which will set the bool to false when clicked, if
                     // '*p_visible==false' don't display the header.
+API bool CollapsingHeader(const StrID &label, int flags = 0);
+API bool CollapsingHeader(const StrID &label, bool *p_visible, int flags = 0);
 API void
 SetNextItemOpen(bool is_open,
                 int cond = 0); // set next TreeNode/CollapsingHeader open state.
@@ -1153,6 +1244,10 @@ API bool Selectable(const char *label, bool *p_selected, int flags = 0,
                     const Vec2 &size = Vec2(
                         0, 0)); // "bool* p_selected" point to the selection
                                 // state (read-write), as a convenient helper.
+API bool Selectable(const StrID &label, bool selected = false, int flags = 0,
+                    const Vec2 &size = Vec2(0, 0));
+API bool Selectable(const StrID &label, bool *p_selected, int flags = 0,
+                    const Vec2 &size = Vec2(0, 0));
 
 // Widgets: List Boxes
 // - This is essentially a thin wrapper to using BeginChild/EndChild with the
@@ -1441,6 +1536,32 @@ TableAngledHeadersRow(); // submit a row with angled headers for every column
                          // with the TableColumnFlags_AngledHeader flag.
                          // MUST BE FIRST ROW.
 
+// Tables: Virtual columns
+// - With TableFlags_VirtualColumns (+ TableFlags_ScrollX), call
+// TableSetupVirtualColumns() every frame after TableSetupColumn() to append
+// 'columns_count' logical columns after the columns passed to BeginTable().
+// - Only the logical columns in sight are mapped onto actual table columns, so
+// the cost of layout, borders and draw channels doesn't depend on the number
+// of logical columns, which may exceed the usual columns limit.
+// - Logical columns are fixed width, resizable. Widths are held by the table
+// (not saved in .ini settings). They can't be reordered, hidden or sorted.
+// - Use TableGetVirtualColumnsRange() to get the range of logical columns to
+// submit, and TableSetVirtualColumnIndex() instead of TableSetColumnIndex().
+// Submit headers manually with TableNextRow(TableRowFlags_Headers) +
+// TableHeader(). TableGetColumnCount() includes the mapped columns.
+API void TableSetupVirtualColumns(
+    int columns_count, float default_width,
+    int flags = 0); // 'flags' are TableColumnFlags_ applied to every logical
+                    // column (e.g. TableColumnFlags_NoResize).
+API void TableGetVirtualColumnsRange(
+    int *out_display_start,
+    int *out_display_end); // get logical columns in sight (end is exclusive).
+API bool TableSetVirtualColumnIndex(
+    int virtual_column_n); // append into the specified logical column, which
+                           // must be in sight. Return true when visible.
+API float TableGetVirtualColumnWidth(int virtual_column_n);
+API void TableSetVirtualColumnWidth(int virtual_column_n, float width);
+
 // Tables: Sorting & Miscellaneous functions
 // - Sorting: call TableGetSortSpecs() to retrieve latest sort specs for the
 // table. NULL when not sorting.
@@ -1748,6 +1869,14 @@ API double
 GetTime(); // get global imgui time. incremented by io.DeltaTime every frame.
 API int
 GetFrameCount(); // get global imgui frame count. incremented by 1 every frame.
+API void RequestRedraw(
+    float delay = 0.0f); // request a new frame within 'delay' seconds even if
+                         // no input arrives, e.g. for your own animations.
+API double
+GetNextRedrawDeadline(); // time (in GetTime() units) at which a new frame is
+                         // needed when no input arrives. <= GetTime(): render
+                         // again now, FLT_MAX: wait for input. Call after
+                         // Render(). Used to block on events when idle.
 API DrawListSharedData *
 GetDrawListSharedData(); // you may use this when creating your own DrawList
                          // instances.
@@ -1961,7 +2090,8 @@ API void RenderPlatformWindowsDefault(
     void *renderer_render_arg =
         NULL); // call in main loop. will call RenderWindow/SwapBuffers platform
                // functions for each secondary viewport which doesn't have the
-               // ViewportFlags_Minimized flag set. May be reimplemented by
+               // ViewportFlags_Minimized flag set, in parallel when
+               // PlatformIO::ParallelFor is set. May be reimplemented by
                // user for custom rendering needs.
 API void
 DestroyPlatformWindows(); // call DestroyWindow platform functions for all
@@ -2975,6 +3105,10 @@ enum BackendFlags_ {
       1 << 3, // Backend Renderer supports DrawCmd::VtxOffset. This enables
               // output of large meshes (64K+ vertices) while still using 16-bit
               // indices.
+  BackendFlags_RendererHasSdfShapes =
+      1 << 4, // Backend Renderer evaluates DrawVert::sdf (requires
+              // USE_DRAWVERT_SDF in config.hpp). This enables drawing rounded
+              // rectangles and circles as a single quad each.
 
   // [BETA] Viewports
   BackendFlags_PlatformHasViewports =
@@ -2988,6 +3122,10 @@ enum BackendFlags_ {
                // heuristic to find the viewport under.
   BackendFlags_RendererHasViewports =
       1 << 12, // Backend Renderer supports multiple viewports.
+  BackendFlags_RendererHasParallelViewports =
+      1 << 13, // Backend Renderer supports calling Renderer_RenderWindow()
+               // concurrently for different viewports (see
+               // PlatformIO::ParallelFor).
 };
 
 // Enumeration for PushStyleColor() / PopStyleColor()
@@ -3475,6 +3613,10 @@ enum TableFlags_ {
   TableFlags_HighlightHoveredColumn =
       1 << 28, // Highlight column headers when hovered (may evolve into a
                // fuller highlight)
+  TableFlags_VirtualColumns =
+      1 << 29, // Enable TableSetupVirtualColumns(): append many logical
+               // columns of which only those in sight are laid out and
+               // submitted. Require TableFlags_ScrollX.
 
   // [Internal] Combinations and masks
   TableFlags_SizingMask_ =
@@ -4141,6 +4283,9 @@ struct IO {
                              // individual window with CTRL+Wheel.
   Gui::Font *FontDefault; // = NULL           // Font to use on NewFrame(). Use
                           // NULL to uses Fonts->Fonts[0].
+  Gui::ImageAtlas *Images; // = NULL           // Optional atlas of user
+                           // images, drawn from shared textures (see
+                           // ImageAtlas).
   Vec2 DisplayFramebufferScale; // = (1, 1)         // For retina display or
                                 // other situations where window coordinates
                                 // are different from framebuffer coordinates.
@@ -4223,6 +4368,13 @@ struct IO {
                                      // button down + up) will be spread over
                                      // multiple frames, improving interactions
                                      // with low framerates.
+  bool ConfigInputEventsAnyThread; // = false          // Allow the io.AddXXX
+                                   // input functions to be called from any
+                                   // thread (e.g. a dedicated OS event
+                                   // thread): events are posted to a lock-free
+                                   // queue and collected by NewFrame(). Text
+                                   // and mouse source events should come from
+                                   // a single thread. Set before posting.
   bool ConfigInputTextCursorBlink; // = true           // Enable blinking cursor
                                    // (optional as some users consider it to be
                                    // distracting).
@@ -4250,6 +4402,13 @@ struct IO {
       ConfigMemoryCompactTimer; // = 60.0f          // Timer (in seconds) to
                                 // free transient windows/tables memory buffers
                                 // when unused. Set to -1.0f to disable.
+  bool ConfigRenderOcclusionCulling; // = false          // [BETA] In
+                                     // Render(), skip draw lists and draw
+                                     // commands entirely covered by the
+                                     // opaque background of a window drawn
+                                     // above them. Draw callbacks are never
+                                     // skipped, but must not draw outside of
+                                     // their clipping rectangle.
 
   // Inputs Behaviors
   // (other variables, ones which are expected to be tweaked within UI code, are
@@ -4308,6 +4467,14 @@ struct IO {
                                // comments (particularly helpful for Docking,
                                // but makes saving slower)
 
+  // Option to audit heap allocations of repeating frames. After a few warm-up
+  // frames from when it is set, any call to MemAlloc() within a frame
+  // asserts. Enable it in tests/benchmarks submitting the same UI every frame;
+  // interacting with the UI (e.g. opening a new window) legitimately allocates.
+  bool ConfigDebugAssertNoSteadyStateAllocs; // = false          // Assert on
+                                             // heap allocations in
+                                             // steady-state frames.
+
   //------------------------------------------------------------------
   // Platform Functions
   // (the xxxx backend files are setting those up for you)
@@ -4349,6 +4516,8 @@ struct IO {
   //------------------------------------------------------------------
 
   // Input Functions
+  // (The AddXXX functions may be called from any thread when
+  // io.ConfigInputEventsAnyThread is set, the other functions may not)
   API void
   AddKeyEvent(Key key,
               bool down); // Queue a new key down/up event. Key should be
@@ -4821,16 +4990,25 @@ struct OnceUponAFrame {
 };
 
 // Helper: Parse and apply text filters. In format "aaaaa[,bbbb][,ccccc]"
+// - Build() compiles the filters, PassFilter() is const and may be called
+// concurrently from multiple threads.
+// - PassFilterBatch() filters an array of strings into a list of indices. When
+// called again on the same items after the filter text was only extended
+// (e.g. typing more characters), it only tests the items which passed before.
+// Call InvalidateBatch() if the contents of the items changed.
 struct TextFilter {
   API TextFilter(const char *default_filter = "");
   API bool Draw(const char *label = "Filter (inc,-exc)",
                 float width = 0.0f); // Helper calling InputText+Build
   API bool PassFilter(const char *text, const char *text_end = NULL) const;
+  API void PassFilterBatch(const char *const *items, int items_count,
+                           Vector<int> *out_indices);
   API void Build();
   void Clear() {
     InputBuf[0] = 0;
     Build();
   }
+  void InvalidateBatch() { BatchItems = NULL; }
   bool IsActive() const { return !Filters.empty(); }
 
   // [Internal]
@@ -4846,9 +5024,20 @@ struct TextFilter {
     bool empty() const { return b == e; }
     API void split(char separator, Vector<TextRange> *out) const;
   };
+  struct CompiledFilter {
+    int NeedleOffset; // Offset of the lower-cased needle in CompiledBuf
+    int NeedleLen;
+    bool Subtract;
+    unsigned char Skip[256]; // Shift on mismatch, indexed by lower-cased byte
+  };
   char InputBuf[256];
   Vector<TextRange> Filters;
+  Vector<CompiledFilter> CompiledFilters; // Non-empty filters, in order
+  char CompiledBuf[256];
   int CountGrep;
+  char BatchInputBuf[256]; // InputBuf used by the last PassFilterBatch() call
+  const char *const *BatchItems;
+  int BatchItemsCount;
 };
 
 // Helper: Growable text buffer for logging/accumulating text
@@ -5028,6 +5217,95 @@ struct ListClipper {
 #endif
 };
 
+// Helper: Manually clip the rows of a table whose rows don't all have the same
+// height (multi-line cells, row_min_height passed to TableNextRow(), etc.)
+// Works like ListClipper, but must be used between BeginTable()/EndTable():
+// - Each row height is measured when it is submitted and remembered by the
+// table. Rows which have never been visible use an estimate (either
+// 'rows_height_estimate' or the height of the first measured row), so the
+// scrollbar stays accurate and only visible rows are submitted.
+// - Frozen rows (see TableSetupScrollFreeze()) are submitted first, unclipped.
+// - 'rows_order' optionally maps display rows to your item indices (e.g. the
+// permutation you obtained from sorting). Heights are remembered per item, so
+// they follow items when the order changes. The order is re-read when the
+// table sort specs changed or when you pass 'rows_order_changed = true'.
+// - You must call TableNextRow() exactly once per row in the display range.
+// Usage:
+//   TableRowClipper clipper;
+//   clipper.Begin(items_count, -1.0f, order);
+//   while (clipper.Step())
+//     for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+//       Gui::TableNextRow();
+//       [...] // Submit cells for item order[row]
+//     }
+struct TableRowClipper {
+  Context *Ctx;     // Parent UI context
+  int DisplayStart; // First row to display, updated by each call to Step()
+  int DisplayEnd;   // End of rows to display (exclusive)
+  int RowsCount;    // [Internal] Number of rows
+  float StartPosY;  // [Internal] Cursor position after table frozen rows
+  void *TempData;   // [Internal] Point to the table row heights data
+
+  API TableRowClipper();
+  API ~TableRowClipper();
+  API void Begin(int rows_count, float rows_height_estimate = -1.0f,
+                 const int *rows_order = NULL,
+                 bool rows_order_changed = false);
+  API void
+  End(); // Automatically called on the last call of Step() that returns false.
+  API bool Step(); // Call until it returns false. The DisplayStart/DisplayEnd
+                   // fields will be set and you can process/draw those rows.
+};
+
+// Helper: Manually clip a large tree, submitting only the visible rows.
+// The tree is described by two callbacks returning the children of a node,
+// nodes being identified by your own indices (use -1 for the roots).
+// - The expanded hierarchy is kept flattened as a list of rows (node + depth)
+// remembered under 'str_id'. Opening or closing a node inserts or removes its
+// expanded descendants only, so the tree is never walked as a whole after the
+// first frame. Pass 'tree_changed = true' when you modified the hierarchy.
+// - Rows are clipped with a ListClipper: rows must all have the same height.
+// - Submit each row with TreeClipper::TreeNode(): don't call TreePop(). The
+// open state is stored in the window StateStorage like TreeNode() does.
+// Usage:
+//   TreeClipper clipper;
+//   clipper.Begin("tree", GetChildrenCount, GetChild, &my_tree);
+//   while (clipper.Step())
+//     for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+//       int node = clipper.GetRowNode(row);
+//       clipper.TreeNode(row, my_tree.Nodes[node].Name);
+//     }
+struct TreeClipper {
+  Context *Ctx;     // Parent UI context
+  int DisplayStart; // First row to display, updated by each call to Step()
+  int DisplayEnd;   // End of rows to display (exclusive)
+  int RowsCount;    // Number of rows in the expanded hierarchy
+  int (*GetChildrenCount)(void *user_data, int node); // [Internal]
+  int (*GetChild)(void *user_data, int node, int child_n); // [Internal]
+  void *UserData;      // [Internal]
+  int TempDataIndex;   // [Internal] Index of the persistent rows data
+  ListClipper Clipper; // [Internal]
+
+  API TreeClipper();
+  API ~TreeClipper();
+  API void Begin(const char *str_id,
+                 int (*get_children_count)(void *user_data, int node),
+                 int (*get_child)(void *user_data, int node, int child_n),
+                 void *user_data, bool tree_changed = false,
+                 float rows_height = -1.0f);
+  API void
+  End(); // Automatically called on the last call of Step() that returns false.
+  API bool Step(); // Call until it returns false. The DisplayStart/DisplayEnd
+                   // fields will be set and you can process/draw those rows.
+  API int GetRowNode(int row) const;
+  API int GetRowDepth(int row) const;
+  API bool TreeNode(int row, const char *label,
+                    int flags = 0); // Indented tree node for the row, return
+                                    // true when open.
+  API void SetRowOpen(int row, bool open); // Open/close a row, including
+                                           // rows which are not visible.
+};
+
 // Helpers: Vec2/Vec4 operators
 // - It is important that we are keeping those disabled by default so they don't
 // leak in user space.
@@ -5257,11 +5535,32 @@ struct DrawCmd {
 };
 
 // Vertex layout
-#ifndef OVERRIDE_DRAWVERT_STRUCT_LAYOUT
+#if defined(USE_DRAWVERT_COMPACT)
+#ifdef OVERRIDE_DRAWVERT_STRUCT_LAYOUT
+#error "USE_DRAWVERT_COMPACT and OVERRIDE_DRAWVERT_STRUCT_LAYOUT are exclusive"
+#endif
+// Compact vertex layout (12 bytes), see USE_DRAWVERT_COMPACT in config.hpp.
+// - pos: signed fixed point in 1/DRAWVERT_POS_SCALE pixel units, relative to
+// DrawList::VtxOrigin. Renderer backends add VtxOrigin back when projecting.
+// - uv: unsigned normalized, 0..65535 maps to 0.0f..1.0f.
+// Use DrawList::_VtxGetPos()/_VtxGetUV() to read them back as Vec2.
+#define DRAWVERT_POS_SCALE 4.0f
+struct DrawVert {
+  signed short pos[2];
+  unsigned short uv[2];
+  unsigned int col;
+#ifdef USE_DRAWVERT_SDF
+  unsigned short sdf[4];
+#endif
+};
+#elif !defined(OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct DrawVert {
   Vec2 pos;
   Vec2 uv;
   unsigned int col;
+#ifdef USE_DRAWVERT_SDF
+  unsigned short sdf[4];
+#endif
 };
 #else
 // You can override the vertex format layout by defining
@@ -5274,8 +5573,22 @@ struct DrawVert {
 // THE STRUCTURE AND DOESN'T CALL A CONSTRUCTOR SO ANY CUSTOM FIELD WILL BE
 // UNINITIALIZED. IF YOU ADD EXTRA FIELDS (SUCH AS A 'Z' COORDINATES) YOU WILL
 // NEED TO CLEAR THEM DURING RENDER OR TO IGNORE THEM.
+// With USE_DRAWVERT_SDF, the layout also needs an 'unsigned short sdf[4]'
+// field.
 OVERRIDE_DRAWVERT_STRUCT_LAYOUT;
 #endif
+#ifdef USE_DRAWVERT_SDF
+// Signed distance shape of a vertex, see USE_DRAWVERT_SDF in config.hpp.
+// All zero for regular vertices. For vertices of a shape quad, in
+// 1/DRAWVERT_SDF_SCALE pixel units:
+// - sdf[0], sdf[1]: half size of the rectangle (non-zero).
+// - sdf[2]: corner rounding in the low 12 bits, rounded corners in the high 4
+// bits (TopLeft, TopRight, BottomLeft, BottomRight from lowest bit).
+// - sdf[3]: outline thickness, 0 for a filled shape.
+// The vertex UV goes from (0,0) to (1,1) over the quad, which is larger than
+// the shape by half the thickness plus 1 pixel of anti-aliasing margin.
+#define DRAWVERT_SDF_SCALE 4.0f
+#endif
 
 // [Internal] For use by DrawList
 struct DrawCmdHeader {
@@ -5298,6 +5611,10 @@ struct DrawListSplitter {
   int _Count;                    // Number of active channels (1+)
   Vector<DrawChannel> _Channels; // Draw channels (not resized down so
                                  // _Count might be < Channels.Size)
+  Vector<DrawCmd> _MergeCmds;    // [Internal] Merge() scratch: destination
+                                 // commands, reused across frames
+  Vector<int> _MergeCmdsRemap;   // [Internal] Merge() scratch: source command
+                                 // -> destination command index
 
   inline DrawListSplitter() { memset(this, 0, sizeof(*this)); }
   inline ~DrawListSplitter() { ClearFreeMemory(); }
@@ -5377,6 +5694,10 @@ enum DrawListFlags_ {
   DrawListFlags_AllowVtxOffset =
       1 << 3, // Can emit 'VtxOffset > 0' to allow large meshes. Set when
               // 'BackendFlags_RendererHasVtxOffset' is enabled.
+  DrawListFlags_SdfShapes =
+      1 << 4, // Can emit rounded rectangles and circles as signed distance
+              // quads (see DrawVert::sdf). Set when USE_DRAWVERT_SDF is
+              // defined and 'BackendFlags_RendererHasSdfShapes' is enabled.
 };
 
 // Draw command list
@@ -5402,6 +5723,10 @@ struct DrawList {
   Vector<DrawVert> VtxBuffer; // Vertex buffer.
   int Flags;                  // Flags, you may poke into these to adjust
                               // anti-aliasing settings per-primitive.
+#ifdef USE_DRAWVERT_COMPACT
+  Vec2 VtxOrigin; // Position that compact vertex positions are relative to.
+                  // Set when the list is started, before writing vertices.
+#endif
 
   // [Internal, used while building lists]
   unsigned int
@@ -5629,9 +5954,7 @@ struct DrawList {
                       const Vec2 &d, const Vec2 &uv_a, const Vec2 &uv_b,
                       const Vec2 &uv_c, const Vec2 &uv_d, unsigned int col);
   inline void PrimWriteVtx(const Vec2 &pos, const Vec2 &uv, unsigned int col) {
-    _VtxWritePtr->pos = pos;
-    _VtxWritePtr->uv = uv;
-    _VtxWritePtr->col = col;
+    _VtxWrite(_VtxWritePtr, pos, uv, col);
     _VtxWritePtr++;
     _VtxCurrentIdx++;
   }
@@ -5654,6 +5977,55 @@ struct DrawList {
   // OBSOLETED in 1.80 (Jan 2021)
 
   // [Internal helpers]
+  // Read/write vertex attributes, encoding them when USE_DRAWVERT_COMPACT is
+  // defined. Prefer those to accessing DrawVert::pos/uv directly.
+#ifdef USE_DRAWVERT_COMPACT
+  static inline signed short _VtxPackPos(float v) {
+    v = v * DRAWVERT_POS_SCALE;
+    v = (v < -32768.0f) ? -32768.0f : (v > 32767.0f) ? 32767.0f : v;
+    return (signed short)(int)(v >= 0.0f ? v + 0.5f : v - 0.5f);
+  }
+  static inline unsigned short _VtxPackUV(float v) {
+    v = v * 65535.0f + 0.5f;
+    return (unsigned short)((v <= 0.0f) ? 0 : (v >= 65535.0f) ? 65535 : (int)v);
+  }
+  inline void _VtxSetPos(DrawVert *vtx, const Vec2 &pos) const {
+    vtx->pos[0] = _VtxPackPos(pos.x - VtxOrigin.x);
+    vtx->pos[1] = _VtxPackPos(pos.y - VtxOrigin.y);
+  }
+  inline void _VtxSetUV(DrawVert *vtx, const Vec2 &uv) const {
+    vtx->uv[0] = _VtxPackUV(uv.x);
+    vtx->uv[1] = _VtxPackUV(uv.y);
+  }
+  inline Vec2 _VtxGetPos(const DrawVert *vtx) const {
+    return Vec2(vtx->pos[0] * (1.0f / DRAWVERT_POS_SCALE) + VtxOrigin.x,
+                vtx->pos[1] * (1.0f / DRAWVERT_POS_SCALE) + VtxOrigin.y);
+  }
+  inline Vec2 _VtxGetUV(const DrawVert *vtx) const {
+    return Vec2(vtx->uv[0] * (1.0f / 65535.0f), vtx->uv[1] * (1.0f / 65535.0f));
+  }
+#else
+  inline void _VtxSetPos(DrawVert *vtx, const Vec2 &pos) const {
+    vtx->pos = pos;
+  }
+  inline void _VtxSetUV(DrawVert *vtx, const Vec2 &uv) const { vtx->uv = uv; }
+  inline Vec2 _VtxGetPos(const DrawVert *vtx) const { return vtx->pos; }
+  inline Vec2 _VtxGetUV(const DrawVert *vtx) const { return vtx->uv; }
+#endif
+#ifdef USE_DRAWVERT_SDF
+  static inline void _VtxClearSdf(DrawVert *vtx) {
+    vtx->sdf[0] = vtx->sdf[1] = vtx->sdf[2] = vtx->sdf[3] = 0;
+  }
+#endif
+  inline void _VtxWrite(DrawVert *vtx, const Vec2 &pos, const Vec2 &uv,
+                        unsigned int col) const {
+    _VtxSetPos(vtx, pos);
+    _VtxSetUV(vtx, uv);
+    vtx->col = col;
+#ifdef USE_DRAWVERT_SDF
+    _VtxClearSdf(vtx);
+#endif
+  }
   API void _ResetForNewFrame();
   API void _ClearFreeMemory();
   API void _PopUnusedDrawCmd();
@@ -5662,6 +6034,10 @@ struct DrawList {
   API void _OnChangedTextureID();
   API void _OnChangedVtxOffset();
   API int _CalcCircleAutoSegmentCount(float radius) const;
+#ifdef USE_DRAWVERT_SDF
+  API bool _AddSdfRect(const Vec2 &p_min, const Vec2 &p_max, float rounding,
+                       int flags, float thickness, unsigned int col);
+#endif
   API void _PathArcToFastEx(const Vec2 &center, float radius, int a_min_sample,
                             int a_max_sample, int a_step);
   API void _PathArcToN(const Vec2 &center, float radius, float a_min,
@@ -5715,7 +6091,7 @@ struct DrawData {
 
 //-----------------------------------------------------------------------------
 // [SECTION] Font API (FontConfig, FontGlyph, int, FontAtlas,
-// FontGlyphRangesBuilder, Font)
+// FontGlyphRangesBuilder, Font, ImageAtlas)
 //-----------------------------------------------------------------------------
 namespace Gui {
 struct FontConfig {
@@ -6042,8 +6418,11 @@ struct FontAtlas {
                        // Defaults to 1. If your rendering method doesn't rely
                        // on bilinear filtering you may set this to 0 (will also
                        // need to set AntiAliasedLinesUseTex = false).
-  bool Locked; // Marked as Locked by Gui::NewFrame() so attempt to modify the
-               // atlas will assert.
+  volatile unsigned int
+      Locked; // Incremented by Gui::NewFrame() and decremented by EndFrame()
+              // of every context using this atlas, so attempt to modify the
+              // atlas while != 0 will assert. Contexts sharing an atlas may
+              // run on different threads (see USE_THREAD_LOCAL_CONTEXT).
   void *UserData; // Store your own atlas related user-data (if e.g. you have
                   // multiple font atlas).
 
@@ -6193,6 +6572,71 @@ struct Font {
   API void SetGlyphVisible(Wchar c, bool visible);
   API bool IsGlyphRangeUnused(unsigned int c_begin, unsigned int c_last);
 };
+
+// See ImageAtlas::AddImage().
+struct ImageAtlasImage {
+  TextureID SourceTexID; // Input    // TextureID the image is drawn with
+  unsigned short Width, Height; // Input    // Image dimension
+  unsigned int *Pixels;         // Input    // Copy of the RGBA32 pixels
+  int PageIndex;                // Output   // Index in Pages[] (-1: not packed)
+  unsigned short X, Y;          // Output   // Packed position in the page
+  Vec2 Uv0, Uv1;                // Output   // Texture coordinates in the page
+  ImageAtlasImage() {
+    memset((void *)this, 0, sizeof(*this));
+    PageIndex = -1;
+  }
+  bool IsPacked() const { return PageIndex >= 0; }
+};
+
+// A texture of the image atlas, holding one or more packed images.
+struct ImageAtlasPage {
+  TextureID TexID; // User data to refer to the texture once it has been
+                   // uploaded, see SetPageTexID()
+  unsigned int *TexPixelsRGBA32; // 4 bytes per pixel, TexWidth * TexHeight
+  int TexWidth;
+  int TexHeight;
+};
+
+// Pack many small user images (icons, thumbnails...) into a few shared
+// textures. Each distinct TextureID drawn with AddImage(), Image() or
+// ImageButton() starts a new draw command, which most renderer backends
+// translate into a draw call: once registered here, those images are drawn
+// from their shared page instead, and consecutive images of a same page are
+// merged into a single draw command.
+//  - Call AddImage() for each image, with the TextureID your code draws it
+//  with and its RGBA32 pixels (copied by the atlas).
+//  - Call Build(), then upload each of Pages[] into a texture within your
+//  graphics system and call SetPageTexID() with its identifier.
+//  - Set 'io.Images = &my_image_atlas'. DrawList::AddImage(),
+//  AddImageQuad() and AddImageRounded() then redirect any registered
+//  TextureID to its page, remapping the UV coordinates into its sub-rect
+//  (so only UV within 0.0f..1.0f are supported: no texture repeat).
+// Images larger than ImageMaxSize, or drawn before SetPageTexID() is called
+// for their page, keep using their own texture. Don't modify the atlas
+// between NewFrame() and Render().
+struct ImageAtlas {
+  API ImageAtlas();
+  API ~ImageAtlas();
+  API int AddImage(TextureID tex_id, const unsigned char *pixels_rgba32,
+                   int width, int height); // Return index in Images[]
+  API bool Build(); // Pack images into Pages[] and render their pixels
+  API void ClearInputData(); // Clear the copies of the images pixels
+  API void ClearTexData();   // Clear pages pixels (CPU side), once uploaded
+  API void Clear();          // Clear all input and output
+  void SetPageTexID(int page_index, TextureID id) {
+    Pages[page_index].TexID = id;
+  }
+  API const ImageAtlasImage *FindImage(TextureID tex_id) const;
+
+  int PageWidth;    // = 1024 // Pages dimension. Last page is trimmed to the
+  int PageHeight;   // = 1024 // next power of two holding its images.
+  int ImageMaxSize; // = 256  // Larger images are not packed
+  int ImagePadding; // = 1    // Border of repeated edge pixels around each
+                    // image, so bilinear filtering doesn't bleed
+  Vector<ImageAtlasImage> Images;
+  Vector<ImageAtlasPage> Pages;
+  Storage Map; // [Internal] Hash of SourceTexID -> index in Images[]
+};
 } // namespace Gui
 //-----------------------------------------------------------------------------
 // [SECTION] Viewports
@@ -6397,6 +6841,11 @@ struct Viewport {
 //     Renderer_SwapBuffers()
 //   Those functions pointers exists only for the benefit of
 //   RenderPlatformWindowsDefault().
+// - When the application provides a job system with PlatformIO::ParallelFor
+//   and the renderer sets BackendFlags_RendererHasParallelViewports,
+//   Renderer_RenderWindow() calls run in parallel, so that rendering takes as
+//   long as the slowest viewport. Renderer_SwapBuffersBatch(), when set, then
+//   presents all viewports at once.
 // - If you have very specific rendering needs (e.g. flipping multiple
 // swap-chain simultaneously, unusual sync/threading issues, etc.),
 //   you may be tempted to ignore RenderPlatformWindowsDefault() and write
@@ -6523,6 +6972,22 @@ struct PlatformIO {
       void *render_arg); // . . . R .  // (Optional) Call Present/SwapBuffers.
                          // 'render_arg' is the value passed to
                          // RenderPlatformWindowsDefault().
+  void (*Renderer_SwapBuffersBatch)(
+      Viewport **vps, int vps_count,
+      void *render_arg); // . . . R .  // (Optional) Present all viewports
+                         // rendered this frame at once, replacing the calls
+                         // to Renderer_SwapBuffers().
+
+  // (Optional) Job system, set by the application
+  // Used by RenderPlatformWindowsDefault() to render secondary viewports in
+  // parallel when the renderer sets BackendFlags_RendererHasParallelViewports.
+  // Must call job(n, job_data) once for every n in [0, count) and return when
+  // all calls completed. Calls may run concurrently on any thread, including
+  // the calling one. The current context and allocator functions are set up
+  // by the job itself.
+  void (*ParallelFor)(int count, void (*job)(int n, void *job_data),
+                      void *job_data, void *user_data);
+  void *ParallelForUserData;
 
   // (Optional) Monitor list
   // - Updated by: app/backend. Update every frame to dynamically support
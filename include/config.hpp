@@ -87,6 +87,13 @@
 // DISABLE_SSE                                 // Disable use of SSE intrinsics
 // even if available
 
+//---- Store the current context pointer (GGui) and the allocator functions in
+// thread local storage, so that N threads can each run their own context
+// concurrently. Each thread needs to call Gui::SetCurrentContext() (and
+// Gui::SetAllocatorFunctions() if not using the default allocator). Contexts
+// may share a FontAtlas which is built before creating them.
+// #define USE_THREAD_LOCAL_CONTEXT
+
 //---- Include user.h at the end of gui.hpp as a convenience
 // May be convenient for some users to only explicitly include vanilla gui.hpp
 // and have extra stuff included.
@@ -118,6 +125,12 @@
 // disabled in order to support the extra formats provided by sprintf.h.
 // #define USE_SPRINTF
 
+//---- Always format and parse the values of Drag/Slider/Input widgets with
+// FormatString() and sscanf(). By default the common formats ("%d", "%.3f",
+// "%g" etc.) are handled by a faster locale-free implementation producing the
+// same output. Automatically disabled by DISABLE_DEFAULT_FORMAT_FUNCTIONS.
+// #define DISABLE_FAST_DATATYPE_FORMAT
+
 //---- Use FreeType to build and rasterize the font atlas (instead of
 // truetype which is embedded by default in Gui)
 // Requires FreeType headers to be available in the include path. Requires
@@ -162,6 +175,22 @@ MyVec2() const { return MyVec2(x,y); }
 // Read about BackendFlags_RendererHasVtxOffset for details.
 // #define DrawIdx unsigned int
 
+//---- Use a compact 12 bytes DrawVert (default is 20 bytes) to reduce vertex
+// upload bandwidth: 16-bit fixed point positions relative to
+// DrawList::VtxOrigin, 16-bit normalized UV and packed color.
+// Positions have 1/4 pixel precision within +/-8192 pixels of the viewport
+// origin, and UV are clamped to 0.0f..1.0f (no texture repeat with AddImage).
+// Supported by the opengl3, vulkan and software renderer backends.
+// #define USE_DRAWVERT_COMPACT
+
+//---- Add a signed distance shape to DrawVert (+8 bytes) so that rounded
+// rectangles, rounded borders and circles are drawn as a single quad each,
+// evaluated per pixel by the renderer, instead of being tessellated with
+// anti-aliased fringes on the CPU. Only used when the renderer backend sets
+// BackendFlags_RendererHasSdfShapes and anti-aliasing is enabled.
+// Supported by the opengl3, vulkan and software renderer backends.
+// #define USE_DRAWVERT_SDF
+
 //---- Override DrawCallback signature (will need to modify renderer backends
 // accordingly) struct DrawList; struct DrawCmd; typedef void
 // (*MyDrawCallback)(const DrawList* draw_list, const DrawCmd* cmd, void*
@@ -155,6 +155,7 @@ struct InputTextDeactivateData; // Short term storage to backup text of a
                                 // deactivating InputText() while another
                                 // is stealing active id
 struct LastItemData;            // Status storage for last submitted items
+struct LazyRegionData;          // Storage for BeginLazyRegion()
 struct LocEntry;                // A localization entry.
 struct MenuColumns;             // Simple column measurement, currently used for
                                 // MenuItem() only
@@ -180,10 +181,16 @@ struct TabItem;         // Storage for a tab item (within a tab bar)
 struct Table;           // Storage for a table
 struct TableColumn;     // Storage for one column of a table
 struct TableInstanceData; // Storage for one instance of a same table
+struct TableRowHeights;   // Storage for rows height of a table, used by
+                          // TableRowClipper
+struct TableVirtualColumns; // Storage for logical columns widths of a table
+                            // using TableFlags_VirtualColumns
 struct TableTempData;     // Temporary storage for one table (one per table in
                           // the stack), shared between tables.
 struct TableSettings;     // Storage for a table .ini settings
 struct TableColumnsSettings; // Storage for a column .ini settings
+struct TreeClipperData;      // Storage for the flattened rows of a
+                             // TreeClipper
 struct TypingSelectState;    // Storage for GetTypingSelectRequest()
 struct TypingSelectRequest;  // Storage for GetTypingSelectRequest() (aimed
                              // to be public)
@@ -243,8 +250,13 @@ typedef void (*ErrorLogCallback)(void *user_data, const char *fmt, ...);
 //-----------------------------------------------------------------------------
 
 #ifndef GGui
+#ifdef USE_THREAD_LOCAL_CONTEXT
+extern thread_local Context *GGui; // Current implicit context pointer, per
+                                   // thread (can't have dll interface)
+#else
 extern API Context *GGui; // Current implicit context pointer
 #endif
+#endif
 
 //-------------------------------------------------------------------------
 // [SECTION] STB libraries includes
@@ -399,6 +411,56 @@ namespace Gui {
 #define CDECL
 #endif
 
+// Atomic operations on 32-bit values, for the few structures which may be
+// written from other threads (see InputEventPostQueue). Load/Store have
+// acquire/release semantics, read-modify-write operations are full barriers.
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+static inline unsigned int AtomicLoad(volatile unsigned int *p) {
+  return (unsigned int)_InterlockedCompareExchange((volatile long *)p, 0, 0);
+}
+static inline void AtomicStore(volatile unsigned int *p, unsigned int v) {
+  _InterlockedExchange((volatile long *)p, (long)v);
+}
+static inline unsigned int AtomicExchange(volatile unsigned int *p,
+                                          unsigned int v) {
+  return (unsigned int)_InterlockedExchange((volatile long *)p, (long)v);
+}
+static inline bool AtomicCompareExchange(volatile unsigned int *p,
+                                         unsigned int *expected,
+                                         unsigned int desired) {
+  unsigned int prev = (unsigned int)_InterlockedCompareExchange(
+      (volatile long *)p, (long)desired, (long)*expected);
+  if (prev == *expected)
+    return true;
+  *expected = prev;
+  return false;
+}
+static inline void AtomicAdd(volatile unsigned int *p, unsigned int v) {
+  _InterlockedExchangeAdd((volatile long *)p, (long)v);
+}
+#else
+static inline unsigned int AtomicLoad(volatile unsigned int *p) {
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+static inline void AtomicStore(volatile unsigned int *p, unsigned int v) {
+  __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+static inline unsigned int AtomicExchange(volatile unsigned int *p,
+                                          unsigned int v) {
+  return __atomic_exchange_n(p, v, __ATOMIC_SEQ_CST);
+}
+static inline bool AtomicCompareExchange(volatile unsigned int *p,
+                                         unsigned int *expected,
+                                         unsigned int desired) {
+  return __atomic_compare_exchange_n(p, expected, desired, false,
+                                     __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+}
+static inline void AtomicAdd(volatile unsigned int *p, unsigned int v) {
+  __atomic_fetch_add(p, v, __ATOMIC_SEQ_CST);
+}
+#endif
+
 // Warnings
 #if defined(_MSC_VER) && !defined(__clang__)
 #define MSVC_WARNING_SUPPRESS(XXXX) __pragma(warning(suppress : XXXX))
@@ -465,11 +527,14 @@ namespace Gui {
 // - Helper: Pool<>
 // - Helper: ChunkStream<>
 // - Helper: TextIndex
+// - Helper: FrameArena
 //-----------------------------------------------------------------------------
 
 // Helpers: Hashing
 API int HashData(const void *data, size_t data_size, int seed = 0);
 API int HashStr(const char *data, size_t data_size = 0, int seed = 0);
+API int HashStr(const StrID &str_id,
+                int seed); // == HashStr(str_id.Str, 0, seed)
 
 // Helpers: Sorting
 #ifndef Qsort
@@ -531,6 +596,9 @@ MSVC_RUNTIME_CHECKS_OFF
 static inline char ToUpper(char c) {
   return (c >= 'a' && c <= 'z') ? c &= ~32 : c;
 }
+static inline char ToLower(char c) {
+  return (c >= 'A' && c <= 'Z') ? c | 32 : c;
+}
 static inline bool CharIsBlankA(char c) { return c == ' ' || c == '\t'; }
 static inline bool CharIsBlankW(unsigned int c) {
   return c == ' ' || c == '\t' || c == 0x3000;
@@ -1277,6 +1345,41 @@ struct TextIndex {
   void append(const char *base, int old_size, int new_size);
 };
 
+// Helper: FrameArena
+// Linear allocator for transient data which only needs to live until the next
+// NewFrame(). Allocating is a pointer bump in a single block and Reset()
+// rewinds it. When the block is full we fall back to MemAlloc() and record the
+// overflow: the next Reset() then grows the block to fit the whole frame, so
+// a repeating workload stops touching the heap after a frame or two.
+// Allocations larger than FRAMEARENA_MAX_BLOCK_SIZE never make the block grow
+// (e.g. a large clipboard paste shouldn't pin megabytes for the session).
+#define FRAMEARENA_MAX_BLOCK_SIZE (1024 * 1024)
+struct FrameArena {
+  char *Data;
+  int Size;                      // Bytes used in Data[]
+  int Capacity;                  // Size of Data[]
+  int OverflowSize;              // Bytes allocated outside of Data[]
+  int LastFrameSize;             // Total bytes used by the previous frame
+  Vector<void *> OverflowBlocks; // Freed on next Reset()
+
+  FrameArena() {
+    Data = NULL;
+    Size = Capacity = OverflowSize = LastFrameSize = 0;
+  }
+  ~FrameArena() { ClearFreeMemory(); }
+  void *Alloc(size_t size, size_t align = 16) {
+    const size_t off = MEMALIGN((size_t)Size, align);
+    if (off + size <= (size_t)Capacity) {
+      Size = (int)(off + size);
+      return Data + off;
+    }
+    return AllocOverflow(size);
+  }
+  API void *AllocOverflow(size_t size);
+  API void Reset();
+  API void ClearFreeMemory();
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] DrawList support
 //-----------------------------------------------------------------------------
@@ -1335,6 +1438,8 @@ struct API DrawListSharedData {
   int InitialFlags;            // Initial flags at the beginning of the frame
                                // (it is possible to alter flags on a
                                // per-drawlist basis afterwards)
+  const Gui::ImageAtlas
+      *Images; // Atlas of user images redirecting AddImage() (= io.Images)
 
   // [Internal] Temp write buffer
   Vector<Vec2> TempBuffer;
@@ -1354,10 +1459,19 @@ struct API DrawListSharedData {
   void SetCircleTessellationMaxError(float max_error);
 };
 
+// Opaque area drawn by a draw list, for io.ConfigRenderOcclusionCulling
+struct DrawListOccluder {
+  int ListIndex; // Index of the occluding draw list in its layer (in
+                 // DrawData::CmdLists after flattening)
+  Rect Bounds;   // Fully opaque area, already clipped
+};
+
 struct DrawDataBuilder {
   Vector<DrawList *> *Layers[2]; // Pointers to global layers for: regular,
                                  // tooltip. LayersP[0] is owned by DrawData.
   Vector<DrawList *> LayerData1;
+  Vector<DrawListOccluder> Occluders[2]; // Parallel to Layers[], sorted by
+                                         // ListIndex
 
   DrawDataBuilder() { memset(this, 0, sizeof(*this)); }
 };
@@ -1749,6 +1863,16 @@ struct API GroupData {
   bool EmitItem;
 };
 
+// Persistent storage for BeginLazyRegion()/EndLazyRegion()
+struct API LazyRegionData {
+  int ID;
+  int WindowID;
+  Vec2 Size;    // Size measured the last time the region was submitted
+  int ActiveId; // Active item submitted within the region, if any: keep
+                // submitting the region while it is active
+  LazyRegionData() { memset(this, 0, sizeof(*this)); }
+};
+
 // Simple column measurement, currently used for MenuItem() only.. This is very
 // short-sighted/throw-away code and NOT a generic helper.
 struct API MenuColumns {
@@ -2134,6 +2258,43 @@ struct InputEvent {
   InputEvent() { memset(this, 0, sizeof(*this)); }
 };
 
+// Bounded lock-free queue of input events posted from any thread when
+// io.ConfigInputEventsAnyThread is set, drained into g.InputEventsQueue by
+// NewFrame(). Multiple producers, single consumer (the thread calling
+// NewFrame()). Storage is inline so that posting never allocates: events
+// posted while the queue is full are dropped and counted.
+#ifndef INPUT_EVENTS_POST_CAPACITY
+#define INPUT_EVENTS_POST_CAPACITY 1024 // Must be a power of two.
+#endif
+struct InputEventPostQueue {
+  struct Cell {
+    volatile unsigned int Sequence; // == position when free for posting,
+                                    // == position + 1 when ready to pop.
+    InputEvent Event;
+  };
+  Cell Cells[INPUT_EVENTS_POST_CAPACITY];
+  volatile unsigned int PostPos;      // Next position to post to (producers)
+  unsigned int PopPos;                // Next position to pop from (consumer)
+  volatile unsigned int DroppedCount; // Events dropped because queue was full
+
+  InputEventPostQueue() {
+    STATIC_assert((INPUT_EVENTS_POST_CAPACITY &
+                   (INPUT_EVENTS_POST_CAPACITY - 1)) == 0);
+    for (unsigned int n = 0; n < INPUT_EVENTS_POST_CAPACITY; n++)
+      Cells[n].Sequence = n;
+    PostPos = 0;
+    PopPos = 0;
+    DroppedCount = 0;
+  }
+  bool Post(const InputEvent &e); // Any thread
+  bool Pop(InputEvent *out_e);    // Consumer thread only
+  bool IsEmpty() {
+    return AtomicLoad(
+               &Cells[PopPos & (INPUT_EVENTS_POST_CAPACITY - 1)].Sequence) !=
+           PopPos + 1;
+  } // Consumer thread only
+};
+
 // Input function taking an 'unsigned int owner_id' argument defaults to
 // (KeyOwner_Any == 0) aka don't test ownership, which matches legacy
 // behavior.
@@ -2337,6 +2498,31 @@ struct ListClipperData {
   }
 };
 
+// One row of the expanded hierarchy of a TreeClipper
+struct TreeClipperRow {
+  int Node;          // User node index
+  int Depth;         // 0 for roots
+  int ChildrenCount; // Cached when the row was added
+  bool Open;         // Children are present in the rows following this one
+};
+
+// Persistent storage for TreeClipper: the expanded hierarchy flattened in
+// display order, each row followed by its open descendants.
+struct TreeClipperData {
+  int ID;
+  int RootsCount;                 // Roots count at the time of the last build
+  bool IsBuilt;                   // Rows have been built once
+  bool IsActive;                  // Between TreeClipper::Begin() and End()
+  Vector<TreeClipperRow> Rows;    // Expanded hierarchy
+  Vector<TreeClipperRow> TempRows; // Rows being inserted when opening a node
+  Vector<TreeClipperRow> TempStack; // Nodes being walked when opening a node
+
+  TreeClipperData() {
+    ID = RootsCount = 0;
+    IsBuilt = IsActive = false;
+  }
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Navigation support
 //-----------------------------------------------------------------------------
@@ -3050,6 +3236,9 @@ struct DebugAllocInfo {
   int TotalFreeCount;
   signed short LastEntriesIdx;       // Current index in buffer
   DebugAllocEntry LastEntriesBuf[6]; // Track last 6 frames that had allocations
+  int NoAllocFramesCount; // Number of consecutive frames without allocations
+  int AssertFramesCount;  // Number of frames since
+                          // io.ConfigDebugAssertNoSteadyStateAllocs was set
 
   DebugAllocInfo() { memset(this, 0, sizeof(*this)); }
 };
@@ -3064,8 +3253,10 @@ struct MetricsConfig {
   bool ShowDrawCmdBoundingBoxes = true;
   bool ShowAtlasTintedWithTextColor = false;
   bool ShowDockingNodes = false;
+  bool ShowDockingRootNodesOnly = true;
   int ShowWindowsRectsType = -1;
   int ShowTablesRectsType = -1;
+  char EncodingViewerBuf[100] = "";
 };
 
 struct StackLevelInfo {
@@ -3160,6 +3351,12 @@ struct Context {
                                            // TestEngineHook_Log()
   void *TestEngine;                        // Test engine user data
 
+  // Idle redraw scheduling (see GetNextRedrawDeadline())
+  double RedrawRequestTime; // Earliest time requested with RequestRedraw(),
+                            // FLT_MAX when none is pending.
+  int RedrawSettleFrames;   // Extra frames to render after input events, so
+                            // that state changed by the input can settle.
+
   // Inputs
   Vector<InputEvent> InputEventsQueue; // Input events which will be
                                        // trickled/written into IO structure.
@@ -3169,6 +3366,10 @@ struct Context {
                         // mouse/pen trail.
   MouseSource InputEventsNextMouseSource;
   unsigned int InputEventsNextEventId;
+  InputEventPostQueue InputEventsPosted; // Input events posted from any thread
+                                         // (io.ConfigInputEventsAnyThread),
+                                         // moved to InputEventsQueue by
+                                         // NewFrame().
 
   // Windows state
   Vector<Window *> Windows; // Windows, sorted in display order, back to front
@@ -3306,6 +3507,8 @@ struct Context {
                                      // - inherited by Begin()
   Vector<GroupData> GroupStack;      // Stack for BeginGroup()/EndGroup() -
                                      // not inherited by Begin()
+  Vector<int> LazyRegionStack;       // Stack for BeginLazyRegion(): index
+                                     // in LazyRegions
   Vector<PopupData> OpenPopupStack;  // Which popups are open (persistent)
   Vector<PopupData> BeginPopupStack; // Which level of BeginPopup() we
                                      // are in (reset every frame)
@@ -3338,6 +3541,9 @@ struct Context {
   int ViewportFocusedStampCount; // Every time the front-most window changes, we
                                  // stamp its viewport with an incrementing
                                  // counter
+  Vector<Viewport *> PlatformWindowsToRender; // Temporary list of viewports
+                                              // in
+                                              // RenderPlatformWindowsDefault()
 
   // Gamepad/keyboard Navigation
   Window *NavWindow;     // Focused window for navigation. Could be called
@@ -3507,6 +3713,15 @@ struct Context {
                                       // (SOA, for efficient GC)
   Vector<DrawChannel> DrawChannelsTempMergeBuffer;
 
+  // Lazy regions
+  Pool<LazyRegionData> LazyRegions; // Persistent sizes for BeginLazyRegion()
+  int LazyRegionsNextIdx; // Index following the last region looked up:
+                          // regions are generally submitted in the same
+                          // order, this avoids a map lookup for each one.
+
+  // Tree clippers
+  Pool<TreeClipperData> TreeClippers; // Persistent rows for TreeClipper
+
   // Tab bars
   TabBar *CurrentTabBar;
   Pool<TabBar> TabBars;
@@ -3643,6 +3858,9 @@ struct Context {
   MetricsConfig DebugMetricsConfig;
   IDStackTool DebugIDStackTool;
   DebugAllocInfo DebugAllocInfo;
+  bool DebugAllocHookDisabled;    // Set while other threads may allocate on
+                                  // behalf of this context (parallel
+                                  // RenderPlatformWindowsDefault())
   DockNode *DebugHoveredDockNode; // Hovered dock node.
 
   // Misc
@@ -3657,6 +3875,7 @@ struct Context {
   int WantCaptureKeyboardNextFrame; // "
   int WantTextInputNextFrame;
   Vector<char> TempBuffer; // Temporary text buffer
+  FrameArena FrameArena;   // Transient allocations, see FrameAlloc()
 
   Context(Gui::FontAtlas *shared_font_atlas) {
     IO.Ctx = this;
@@ -3676,6 +3895,8 @@ struct Context {
     GcCompactAll = false;
     TestEngineHookItems = false;
     TestEngine = NULL;
+    RedrawRequestTime = FLT_MAX;
+    RedrawSettleFrames = 0;
 
     InputEventsNextMouseSource = MouseSource_Mouse;
     InputEventsNextEventId = 1;
@@ -3783,6 +4004,7 @@ struct Context {
 
     CurrentTable = NULL;
     TablesTempDataStacked = 0;
+    LazyRegionsNextIdx = 0;
     CurrentTabBar = NULL;
 
     HoverItemDelayId = HoverItemDelayIdPreviousFrame =
@@ -3842,6 +4064,7 @@ struct Context {
     DebugItemPickerBreakId = 0;
     DebugFlashStyleColorTime = 0.0f;
     DebugFlashStyleColorIdx = Col_COUNT;
+    DebugAllocHookDisabled = false;
     DebugHoveredDockNode = NULL;
 
     memset(FramerateSecPerFrame, 0, sizeof(FramerateSecPerFrame));
@@ -4074,6 +4297,9 @@ struct API Window {
   Vector<int> IDStack; // int stack. int are hashes seeded with the value at
                        // the top of the stack. (In theory this should be
                        // in the TempData structure)
+  unsigned int IDSeedShifted[32]; // Top of IDStack multiplied by x^(8*n),
+                                  // cached for GetID(const StrID&)
+  int IDSeedShiftedCount;         // Valid entries in IDSeedShifted[]
   WindowTempData DC;   // Temporary per-window data, reset at the beginning
                        // of the frame. This used to be called
                        // DrawContext, hence the "DC" variable name.
@@ -4122,6 +4348,8 @@ struct API Window {
   DrawList *DrawList; // == &DrawListInst (for backward compatibility reason
                       // with code using internal.hpp we keep this a pointer)
   struct DrawList DrawListInst;
+  Vector<Rect> OccluderRects; // Opaque areas drawn in DrawList this frame
+                              // (io.ConfigRenderOcclusionCulling)
   Window *ParentWindow; // If we are a child _or_ popup _or_ docked window,
                         // this is pointing to our parent. Otherwise NULL.
   Window *ParentWindowInBeginStack;
@@ -4191,6 +4419,7 @@ public:
   int GetID(const char *str, const char *str_end = NULL);
   int GetID(const void *ptr);
   int GetID(int n);
+  int GetID(const StrID &str_id);
   int GetIDFromRectangle(const Rect &r_abs);
 
   // We don't use g.FontSize because the window may be != g.CurrentWindow.
@@ -4474,6 +4703,55 @@ struct TableInstanceData {
   }
 };
 
+// Persistent row heights for TableRowClipper (one per table, only allocated
+// when a TableRowClipper is used).
+// - Heights are stored per item and mirrored in display order into a Fenwick
+// tree (binary indexed tree) of partial sums: converting a position to a row
+// and recording a measured row height are O(log N), applying a new rows order
+// (e.g. after sorting) is an O(N) rebuild.
+// - Sums are stored as double so positions stay exact for millions of rows.
+struct TableRowHeights {
+  int RowsCount;
+  float DefaultHeight;  // Height used for items which were never measured
+  const int *RowsOrder; // Display row -> item index (NULL: identity)
+  Vector<float> ItemsHeight; // Per item. < 0.0f when never measured
+  Vector<double> Tree;       // Fenwick tree of heights in display order
+  bool IsOrderDirty;         // Set when sort specs changed: re-read RowsOrder
+
+  // Transient data while a TableRowClipper is active
+  bool IsClipperActive;
+  int SubmitRow;    // Next display row to be ended by TableEndRow() and
+                    // measured
+  int SubmitRowEnd; // Stop measuring at this display row (exclusive)
+  int StepNo;
+  int ItemsFrozen;
+  float LossynessOffset;
+  Vector<ListClipperRange> Ranges;
+
+  TableRowHeights() { memset(this, 0, sizeof(*this)); }
+};
+
+// Logical columns of a table using TableFlags_VirtualColumns. The logical
+// columns in sight [DisplayStart, DisplayEnd) are mapped onto the last table
+// columns ("slots"), in order, starting at column SlotsFirst.
+struct TableVirtualColumns {
+  int ColumnsCount;     // Number of logical columns
+  float DefaultWidth;   // Width used for columns which were never resized
+  Vector<float> Widths; // Per logical column. < 0.0f when using DefaultWidth
+  Vector<double> Tree;  // Fenwick tree of widths
+  int SlotsFirst;       // Index of first slot == columns count of BeginTable()
+  int SlotsCount;       // Number of slots allocated after regular columns
+  int DisplayStart;     // First logical column mapped onto a slot
+  int DisplayEnd;       // End of logical columns mapped onto slots (exclusive)
+  float OffsetX; // Position of logical column 0 from WorkRect.Min.x, measured
+                 // by last TableUpdateLayout()
+  bool IsSetup;  // Set by TableSetupVirtualColumns(), cleared by BeginTable()
+  bool IsMapped; // Slots width mirror their logical column (cleared when
+                 // columns memory is reallocated)
+
+  TableVirtualColumns() { memset(this, 0, sizeof(*this)); }
+};
+
 // FIXME-TABLE: more transient data could be stored in a stacked
 // TableTempData: e.g. SortSpecs, incoming RowData sizeof() ~ 580 bytes +
 // heap allocs described in TableBeginInitMemory()
@@ -4586,6 +4864,8 @@ struct API Table {
   DrawListSplitter *DrawSplitter; // Shortcut to TempData->DrawSplitter while in
                                   // table. Isolate draw commands per columns to
                                   // avoid switching clip rect constantly
+  TableRowHeights RowHeights; // Used by TableRowClipper
+  TableVirtualColumns VirtualColumns; // Used by TableFlags_VirtualColumns
   TableInstanceData InstanceDataFirst;
   Vector<TableInstanceData>
       InstanceDataExtra; // FIXME-OPT: Using a small-vector pattern would be
@@ -4793,6 +5073,8 @@ inline Window *GetCurrentWindow() {
 }
 API Window *FindWindowByID(int id);
 API Window *FindWindowByName(const char *name);
+API bool BeginEx(const char *name, int id, bool *p_open,
+                 int flags); // id == HashStr(name)
 API void UpdateWindowParentAndRootLinks(Window *window, int flags,
                                         Window *parent_window);
 API Vec2 CalcWindowNextAutoFitSize(Window *window);
@@ -5450,6 +5732,29 @@ API void TableFixColumnSortDirection(Table *table, TableColumn *column);
 API float TableGetColumnWidthAuto(Table *table, TableColumn *column);
 API void TableBeginRow(Table *table);
 API void TableEndRow(Table *table);
+API void TableRowHeightsSetup(TableRowHeights *heights, int rows_count,
+                              float default_height, const int *rows_order,
+                              bool rows_order_changed);
+API float TableRowHeightsGetHeight(const TableRowHeights *heights, int row);
+API void TableRowHeightsSetHeight(TableRowHeights *heights, int row,
+                                  float height);
+API double TableRowHeightsGetOffset(const TableRowHeights *heights,
+                                    int row); // Sum of heights of [0..row)
+API int TableRowHeightsFindRow(const TableRowHeights *heights,
+                               double offset); // Row containing offset
+API void TableVirtualColumnsSetup(TableVirtualColumns *columns,
+                                  int columns_count, float default_width);
+API float TableVirtualColumnsGetWidth(const TableVirtualColumns *columns,
+                                      int column_n);
+API void TableVirtualColumnsSetWidth(TableVirtualColumns *columns,
+                                     int column_n, float width);
+API double
+TableVirtualColumnsGetOffset(const TableVirtualColumns *columns, int column_n,
+                             double spacing); // Sum of widths + spacing of
+                                              // [0..column_n)
+API int TableVirtualColumnsFindColumn(const TableVirtualColumns *columns,
+                                      double offset,
+                                      double spacing); // Column at offset
 API void TableBeginCell(Table *table, int column_n);
 API void TableEndCell(Table *table);
 API Rect TableGetCellBgRect(const Table *table, int column_n);
@@ -5574,6 +5879,12 @@ API int CalcRoundingFlagsForRectInRect(const Rect &r_in, const Rect &r_outer,
 API void TextEx(const char *text, const char *text_end = NULL, int flags = 0);
 API bool ButtonEx(const char *label, const Vec2 &size_arg = Vec2(0, 0),
                   int flags = 0);
+API bool ButtonEx(const char *label, int id, const Vec2 &size_arg, int flags);
+API bool CheckboxEx(const char *label, int id, bool *v);
+API bool SelectableEx(const char *label, int id, bool selected, int flags,
+                      const Vec2 &size_arg);
+API bool CollapsingHeaderEx(const char *label, int id, bool *p_visible,
+                            int flags);
 API bool ArrowButtonEx(const char *str_id, int dir, Vec2 size_arg,
                        int flags = 0);
 API bool ImageButtonEx(int id, TextureID texture_id, const Vec2 &image_size,
@@ -5705,6 +6016,13 @@ API void ShadeVertsTransformPos(DrawList *draw_list, int vert_start_idx,
                                 float cos_a, float sin_a,
                                 const Vec2 &pivot_out);
 
+// Frame Arena
+// Transient memory, valid until the next NewFrame(). Never free it.
+API void *FrameAlloc(size_t size, size_t align = 16);
+template <typename T> static inline T *FrameAllocArray(int count) {
+  return (T *)FrameAlloc((size_t)count * sizeof(T), alignof(T));
+}
+
 // Garbage collection
 API void GcCompactTransientMiscBuffers();
 API void GcCompactTransientWindowBuffers(Window *window);
@@ -0,0 +1,259 @@
+// gui: Background sorting helper for tables (optional)
+// See table_sorter.hpp for details.
+
+// Sorting is done in two phases on a copy of the displayed order:
+// - Split the items into one chunk per thread and merge sort each of them in
+// parallel, using the same range of TempBuffer as scratch.
+// - Merge sorted runs two by two in parallel, ping-ponging between two
+// buffers, until a single run is left.
+// The insertion sort of small runs and std::merge() both keep the previous
+// order of equivalent items, so the whole sort is stable: sorting on a new
+// column keeps the order of the previous sort for equal values.
+// All buffers are allocated by the UI thread before a job starts: sorting
+// never allocates memory on worker threads (unlike std::stable_sort(), which
+// allocates its own scratch buffer). Only starting the std::thread of each
+// parallel pass makes a small allocation.
+
+#include "table_sorter.hpp"
+#ifndef DISABLE
+#include <algorithm>
+
+enum TableSorterState_ {
+  TableSorterState_Idle,
+  TableSorterState_Running,
+  TableSorterState_Done,
+};
+
+// Maximum number of threads used for one sort
+static const int TABLE_SORTER_MAX_THREADS = 64;
+
+// Maximum number of sort specs (tables can't have more than 64 sort specs)
+static const int TABLE_SORTER_MAX_SPECS = 64;
+
+// Below this number of items per thread, spawning threads is not worth it
+static const int TABLE_SORTER_MIN_ITEMS_PER_THREAD = 8192;
+
+struct TableSorterCompare {
+  const TableSorter::ColumnComparator *Comparators; // One per spec
+  const TableColumnSortSpecs *Specs;
+  int SpecsCount;
+
+  bool operator()(int lhs, int rhs) const {
+    for (int n = 0; n < SpecsCount; n++) {
+      const TableSorter::ColumnComparator &comparator = Comparators[n];
+      if (comparator.Fn == NULL)
+        continue;
+      const int delta = comparator.Fn(lhs, rhs, comparator.UserData);
+      if (delta != 0)
+        return (Specs[n].SortDirection == SortDirection_Descending)
+                   ? (delta > 0)
+                   : (delta < 0);
+    }
+    return false;
+  }
+};
+
+// Stable bottom-up merge sort of data[0..count-1], using temp[0..count-1] as
+// scratch. Runs of TABLE_SORTER_INSERTION_RUN items are insertion sorted first.
+static const int TABLE_SORTER_INSERTION_RUN = 32;
+static void TableSorter_MergeSort(int *data, int *temp, int count,
+                                  const TableSorterCompare &compare) {
+  for (int r0 = 0; r0 < count; r0 += TABLE_SORTER_INSERTION_RUN) {
+    const int r1 = std::min(r0 + TABLE_SORTER_INSERTION_RUN, count);
+    for (int n = r0 + 1; n < r1; n++) {
+      const int item = data[n];
+      int dst_n = n;
+      for (; dst_n > r0 && compare(item, data[dst_n - 1]); dst_n--)
+        data[dst_n] = data[dst_n - 1];
+      data[dst_n] = item;
+    }
+  }
+  int *src = data;
+  int *dst = temp;
+  for (long long width = TABLE_SORTER_INSERTION_RUN; width < count;
+       width *= 2) {
+    for (long long r0 = 0; r0 < count; r0 += width * 2) {
+      const int r1 = (int)std::min(r0 + width, (long long)count);
+      const int r2 = (int)std::min(r0 + width * 2, (long long)count);
+      std::merge(src + r0, src + r1, src + r1, src + r2, dst + r0, compare);
+    }
+    std::swap(src, dst);
+  }
+  if (src != data)
+    std::copy(src, src + count, data);
+}
+
+// Call func(0..count-1) on 'count' threads (including the calling one)
+template <typename FUNC>
+static void TableSorter_ParallelFor(int count, const FUNC &func) {
+  std::thread threads[TABLE_SORTER_MAX_THREADS];
+  for (int n = 1; n < count; n++)
+    threads[n] = std::thread(func, n);
+  func(0);
+  for (int n = 1; n < count; n++)
+    threads[n].join();
+}
+
+static void TableSorter_SortJob(TableSorter *sorter, int threads_count) {
+  const int items_count = sorter->SortBuffer.Size;
+  int *src = sorter->SortBuffer.Data;
+  int *dst = sorter->TempBuffer.Data;
+
+  // Without sort specs, revert to the natural order of items
+  if (sorter->SpecsRunning.Size == 0) {
+    for (int n = 0; n < items_count; n++)
+      src[n] = n;
+    sorter->State.store(TableSorterState_Done, std::memory_order_release);
+    return;
+  }
+
+  // Snapshot comparators matching each spec, so SetColumnComparator() can be
+  // called while we are sorting.
+  TableSorter::ColumnComparator comparators[TABLE_SORTER_MAX_SPECS] = {};
+  const int specs_count =
+      std::min(sorter->SpecsRunning.Size, TABLE_SORTER_MAX_SPECS);
+  for (int n = 0; n < specs_count; n++) {
+    const int column_n = sorter->SpecsRunning[n].ColumnIndex;
+    if (column_n >= 0 && column_n < sorter->ComparatorsRunning.Size)
+      comparators[n] = sorter->ComparatorsRunning[column_n];
+  }
+  const TableSorterCompare compare = {comparators, sorter->SpecsRunning.Data,
+                                      specs_count};
+
+  // 1. Sort chunks in parallel
+  int runs_count = std::max(
+      1, std::min(items_count / TABLE_SORTER_MIN_ITEMS_PER_THREAD,
+                  threads_count));
+  int runs[TABLE_SORTER_MAX_THREADS + 1];
+  for (int n = 0; n <= runs_count; n++)
+    runs[n] = (int)(((long long)items_count * n) / runs_count);
+  TableSorter_ParallelFor(runs_count, [&](int run_n) {
+    TableSorter_MergeSort(src + runs[run_n], dst + runs[run_n],
+                          runs[run_n + 1] - runs[run_n], compare);
+  });
+
+  // 2. Merge runs two by two in parallel
+  while (runs_count > 1 && !sorter->CancelRequested.load()) {
+    const int tasks_count = (runs_count + 1) / 2;
+    TableSorter_ParallelFor(tasks_count, [&](int task_n) {
+      const int r0 = runs[task_n * 2];
+      if (task_n * 2 + 1 == runs_count) {
+        // Odd run out: move it as is
+        std::copy(src + r0, src + runs[runs_count], dst + r0);
+        return;
+      }
+      const int r1 = runs[task_n * 2 + 1];
+      const int r2 = runs[task_n * 2 + 2];
+      std::merge(src + r0, src + r1, src + r1, src + r2, dst + r0, compare);
+    });
+    for (int n = 0; n < tasks_count; n++)
+      runs[n] = runs[n * 2];
+    runs[tasks_count] = items_count;
+    runs_count = tasks_count;
+    std::swap(src, dst);
+  }
+  if (src != sorter->SortBuffer.Data && !sorter->CancelRequested.load())
+    memcpy(sorter->SortBuffer.Data, src, (size_t)items_count * sizeof(int));
+
+  sorter->State.store(TableSorterState_Done, std::memory_order_release);
+}
+
+TableSorter::TableSorter(int threads_count) : State(TableSorterState_Idle) {
+  ThreadsCount = threads_count;
+  SortPending = false;
+  CancelRequested = false;
+}
+
+TableSorter::~TableSorter() { Cancel(); }
+
+void TableSorter::SetColumnComparator(int column_n, TableSorterCompareFn fn,
+                                      void *user_data) {
+  assert(column_n >= 0);
+  if (column_n >= Comparators.Size) {
+    const int old_size = Comparators.Size;
+    Comparators.resize(column_n + 1);
+    memset(Comparators.Data + old_size, 0,
+           (size_t)(Comparators.Size - old_size) * sizeof(ColumnComparator));
+  }
+  Comparators[column_n].Fn = fn;
+  Comparators[column_n].UserData = user_data;
+}
+
+bool TableSorter::Update(TableSortSpecs *sort_specs, int items_count) {
+  bool order_changed = false;
+
+  // Collect a finished job. Publish its result unless it was cancelled or is
+  // out of date.
+  if (State.load(std::memory_order_acquire) == TableSorterState_Done) {
+    Worker.join();
+    if (!CancelRequested.load() && SortBuffer.Size == Order.Size) {
+      Order.swap(SortBuffer);
+      order_changed = true;
+    }
+    CancelRequested = false;
+    State.store(TableSorterState_Idle);
+  }
+
+  // Items count changed: fix up the current order right away (remove items
+  // past the end, append new items) and sort again.
+  if (Order.Size != items_count) {
+    const int old_count = Order.Size;
+    int write_n = 0;
+    for (int n = 0; n < old_count; n++)
+      if (Order.Data[n] < items_count)
+        Order.Data[write_n++] = Order.Data[n];
+    Order.resize(items_count);
+    for (int n = old_count; n < items_count; n++)
+      Order.Data[n] = n;
+    order_changed = true;
+    SortPending |= (Specs.Size > 0);
+  }
+
+  // Sort specs changed: take a copy, they are only valid for this frame
+  if (sort_specs != NULL && sort_specs->SpecsDirty) {
+    Specs.resize(sort_specs->SpecsCount);
+    if (sort_specs->SpecsCount > 0)
+      memcpy(Specs.Data, sort_specs->Specs,
+             (size_t)sort_specs->SpecsCount * sizeof(TableColumnSortSpecs));
+    sort_specs->SpecsDirty = false;
+    SortPending = true;
+  }
+
+  if (SortPending) {
+    if (State.load() == TableSorterState_Running) {
+      // Restart as soon as the running job notices the cancellation
+      CancelRequested = true;
+    } else {
+      int threads_count =
+          (ThreadsCount > 0) ? ThreadsCount
+                             : (int)std::thread::hardware_concurrency();
+      threads_count =
+          std::max(1, std::min(threads_count, TABLE_SORTER_MAX_THREADS));
+      SpecsRunning = Specs;
+      ComparatorsRunning = Comparators;
+      SortBuffer = Order;
+      TempBuffer.resize(Order.Size);
+      SortPending = false;
+      CancelRequested = false;
+      State.store(TableSorterState_Running);
+      Worker = std::thread(TableSorter_SortJob, this, threads_count);
+    }
+  }
+  return order_changed;
+}
+
+bool TableSorter::IsSorting() const {
+  return SortPending || State.load() != TableSorterState_Idle;
+}
+
+void TableSorter::Cancel() {
+  if (State.load() != TableSorterState_Idle) {
+    CancelRequested = true;
+    Worker.join();
+    State.store(TableSorterState_Idle);
+  }
+  CancelRequested = false;
+  SortPending = false;
+}
+
+#endif // #ifndef DISABLE
@@ -0,0 +1,73 @@
+// gui: Background sorting helper for tables (optional)
+// This is an optional helper, it is not part of the core library. It uses the
+// C++ standard library (std::thread, std::atomic) which the core doesn't.
+
+// TableSorter sorts a permutation of your item indices according to the
+// table TableSortSpecs, on worker threads, so sorting a large data set
+// doesn't freeze the UI thread.
+// - Register one comparator per sortable column with SetColumnComparator().
+// - Call Update() every frame after BeginTable() (and after
+// TableSetupColumn()), before submitting rows. When sort specs changed, it
+// starts a parallel, multi-key, stable sort of the current order and clears
+// 'sort_specs->SpecsDirty'.
+// - GetOrder() keeps returning the previous order until the sort completes.
+// The new order is published by a later Update() call, which returns true on
+// that frame (e.g. pass it to TableRowClipper::Begin() as rows_order_changed).
+// - Comparators are called from worker threads: the data they read must stay
+// valid and unmodified while IsSorting() returns true.
+// Usage:
+//   static TableSorter sorter;
+//   sorter.SetColumnComparator(0, CompareByName, &items);
+//   if (Gui::BeginTable("items", 2, TableFlags_Sortable | TableFlags_ScrollY)) {
+//     [...] // TableSetupColumn(), TableHeadersRow()
+//     bool order_changed = sorter.Update(Gui::TableGetSortSpecs(), items.Size);
+//     const int *order = sorter.GetOrder();
+//     [...] // Submit rows using items[order[row]]
+//     Gui::EndTable();
+//   }
+
+#pragma once
+#include "../../gui.hpp" // API
+#ifndef DISABLE
+
+#include <atomic>
+#include <thread>
+
+// Compare two items. Return <0 if lhs goes before rhs, >0 if after, 0 when
+// they are equivalent for this column (the next sort spec is then used).
+// Must be thread-safe: called concurrently from worker threads.
+typedef int (*TableSorterCompareFn)(int lhs_item, int rhs_item,
+                                    void *user_data);
+
+struct TableSorter {
+  struct ColumnComparator {
+    TableSorterCompareFn Fn;
+    void *UserData;
+  };
+
+  Vector<ColumnComparator> Comparators; // Indexed by column index
+  Vector<int> Order;      // Displayed order (owned by the UI thread)
+  Vector<int> SortBuffer; // Order being sorted by the worker
+  Vector<int> TempBuffer; // Scratch for merges (allocated by the UI thread)
+  Vector<TableColumnSortSpecs> Specs;        // Specs of the last request
+  Vector<TableColumnSortSpecs> SpecsRunning; // Specs of the running job
+  Vector<ColumnComparator> ComparatorsRunning; // Comparators of the running job
+  int ThreadsCount;  // Worker threads used for one sort (0: use all cores)
+  bool SortPending;  // A sort is requested but a job is still running
+  std::thread Worker;
+  std::atomic<int> State; // TableSorterState_
+  std::atomic<bool> CancelRequested;
+
+  API TableSorter(int threads_count = 0);
+  API ~TableSorter();
+  API void SetColumnComparator(int column_n, TableSorterCompareFn fn,
+                               void *user_data = NULL);
+  API bool Update(TableSortSpecs *sort_specs,
+                  int items_count); // Return true when GetOrder() changed
+  API bool IsSorting() const;
+  API void Cancel(); // Cancel and wait for a running sort
+  inline const int *GetOrder() const { return Order.Data; }
+  inline int GetOrderCount() const { return Order.Size; }
+};
+
+#endif // #ifndef DISABLE
@@ -0,0 +1,433 @@
+// gui: DrawData serialization and replay (optional)
+// See draw_stream.hpp for details.
+
+// Layout of a frame chunk (after the DrawStreamHeader):
+//   u32 frame index, u32 vertex layout (DRAW_STREAM_LAYOUT)
+//   f32 x 6: DisplayPos, DisplaySize, FramebufferScale
+//   u32 lists count, then for each list a u32:
+//   - with DRAW_STREAM_LIST_REF set: index of a list of the previous frame.
+//   - otherwise: size in bytes of the serialized list which follows.
+// Layout of a serialized list:
+//   u32 flags, [f32 x 2: VtxOrigin, only with USE_DRAWVERT_COMPACT]
+//   u32 commands count, u32 indices count, u32 vertices count
+//   commands: f32 x 4 ClipRect, u64 texture id, u32 VtxOffset, u32 IdxOffset,
+//   u32 ElemCount, u32 callback (DrawStreamCallback_)
+//   indices, vertices (raw DrawIdx and DrawVert arrays)
+// Layout of a texture chunk:
+//   u64 texture id, u32 width, u32 height, pixels (u32 x width x height)
+// Serialized lists are compared byte for byte with the lists of the previous
+// frame, so that an unchanged list is detected wherever it moved in the
+// list order (e.g. after focusing another window).
+
+#include "draw_stream.hpp"
+#ifndef DISABLE
+#include <string.h> // memcpy, memcmp
+
+#define DRAW_STREAM_LIST_REF 0x80000000u
+
+#ifdef USE_DRAWVERT_COMPACT
+#define DRAW_STREAM_LAYOUT_COMPACT 1
+#else
+#define DRAW_STREAM_LAYOUT_COMPACT 0
+#endif
+#ifdef USE_DRAWVERT_SDF
+#define DRAW_STREAM_LAYOUT_SDF 2
+#else
+#define DRAW_STREAM_LAYOUT_SDF 0
+#endif
+#define DRAW_STREAM_LAYOUT                                                     \
+  ((unsigned int)sizeof(DrawVert) | ((unsigned int)sizeof(DrawIdx) << 8) |     \
+   ((DRAW_STREAM_LAYOUT_COMPACT | DRAW_STREAM_LAYOUT_SDF) << 16))
+
+enum DrawStreamCallback_ {
+  DrawStreamCallback_None,
+  DrawStreamCallback_ResetRenderState,
+  DrawStreamCallback_User, // Not replayed
+};
+
+static unsigned long long DrawStream_TexIdToU64(TextureID tex_id) {
+  return (unsigned long long)(size_t)tex_id;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] DrawStreamWriter
+//-----------------------------------------------------------------------------
+
+static void DrawStream_Write(Vector<unsigned char> *buf, const void *data,
+                             size_t size) {
+  const int offset = buf->Size;
+  buf->resize(buf->Size + (int)size);
+  if (size > 0)
+    memcpy(buf->Data + offset, data, size);
+}
+
+static void DrawStream_WriteU32(Vector<unsigned char> *buf, unsigned int v) {
+  DrawStream_Write(buf, &v, sizeof(v));
+}
+
+static void DrawStream_WriteU64(Vector<unsigned char> *buf,
+                                unsigned long long v) {
+  DrawStream_Write(buf, &v, sizeof(v));
+}
+
+static void DrawStream_WriteF32(Vector<unsigned char> *buf, float v) {
+  DrawStream_Write(buf, &v, sizeof(v));
+}
+
+static void DrawStream_WriteList(Vector<unsigned char> *buf,
+                                 const DrawList *draw_list) {
+  DrawStream_WriteU32(buf, (unsigned int)draw_list->Flags);
+#ifdef USE_DRAWVERT_COMPACT
+  DrawStream_WriteF32(buf, draw_list->VtxOrigin.x);
+  DrawStream_WriteF32(buf, draw_list->VtxOrigin.y);
+#endif
+  DrawStream_WriteU32(buf, (unsigned int)draw_list->CmdBuffer.Size);
+  DrawStream_WriteU32(buf, (unsigned int)draw_list->IdxBuffer.Size);
+  DrawStream_WriteU32(buf, (unsigned int)draw_list->VtxBuffer.Size);
+  for (const DrawCmd &cmd : draw_list->CmdBuffer) {
+    DrawStream_Write(buf, &cmd.ClipRect, sizeof(float) * 4);
+    DrawStream_WriteU64(buf, DrawStream_TexIdToU64(cmd.TextureId));
+    DrawStream_WriteU32(buf, cmd.VtxOffset);
+    DrawStream_WriteU32(buf, cmd.IdxOffset);
+    DrawStream_WriteU32(buf, cmd.ElemCount);
+    if (cmd.UserCallback == NULL)
+      DrawStream_WriteU32(buf, DrawStreamCallback_None);
+    else if (cmd.UserCallback == DrawCallback_ResetRenderState)
+      DrawStream_WriteU32(buf, DrawStreamCallback_ResetRenderState);
+    else
+      DrawStream_WriteU32(buf, DrawStreamCallback_User);
+  }
+  DrawStream_Write(buf, draw_list->IdxBuffer.Data,
+                   (size_t)draw_list->IdxBuffer.Size * sizeof(DrawIdx));
+  DrawStream_Write(buf, draw_list->VtxBuffer.Data,
+                   (size_t)draw_list->VtxBuffer.Size * sizeof(DrawVert));
+}
+
+DrawStreamWriter::DrawStreamWriter() {
+  FramesCount = ListsSent = ListsReused = 0;
+}
+
+// Return the index of an unused list of the previous frame identical to
+// CurrRefs[curr_n], or -1. Try the same index first (most common case).
+static int DrawStream_FindPrevList(DrawStreamWriter *writer, int curr_n) {
+  const DrawStreamWriter::ListRef &curr = writer->CurrRefs[curr_n];
+  const unsigned char *curr_data = writer->CurrLists.Data + curr.Offset;
+  for (int i = -1; i < writer->PrevRefs.Size; i++) {
+    const int prev_n = (i == -1) ? curr_n : i;
+    if (prev_n >= writer->PrevRefs.Size || (i != -1 && i == curr_n))
+      continue;
+    const DrawStreamWriter::ListRef &prev = writer->PrevRefs[prev_n];
+    if (writer->PrevRefUsed[prev_n] || prev.Size != curr.Size)
+      continue;
+    if (memcmp(writer->PrevLists.Data + prev.Offset, curr_data,
+               (size_t)curr.Size) == 0)
+      return prev_n;
+  }
+  return -1;
+}
+
+void DrawStreamWriter::WriteFrame(const DrawData *draw_data) {
+  assert(draw_data != NULL && draw_data->Valid);
+
+  // Serialize all lists first, to compare them with the previous frame
+  CurrLists.resize(0);
+  CurrRefs.resize(0);
+  for (int n = 0; n < draw_data->CmdListsCount; n++) {
+    ListRef ref;
+    ref.Offset = CurrLists.Size;
+    DrawStream_WriteList(&CurrLists, draw_data->CmdLists[n]);
+    ref.Size = CurrLists.Size - ref.Offset;
+    CurrRefs.push_back(ref);
+  }
+  PrevRefUsed.resize(PrevRefs.Size);
+  for (int n = 0; n < PrevRefUsed.Size; n++)
+    PrevRefUsed[n] = false;
+
+  const int header_offset = Buffer.Size;
+  DrawStreamHeader header = {DRAW_STREAM_MAGIC, DrawStreamChunk_Frame, 0};
+  DrawStream_Write(&Buffer, &header, sizeof(header));
+  DrawStream_WriteU32(&Buffer, (unsigned int)FramesCount);
+  DrawStream_WriteU32(&Buffer, DRAW_STREAM_LAYOUT);
+  DrawStream_WriteF32(&Buffer, draw_data->DisplayPos.x);
+  DrawStream_WriteF32(&Buffer, draw_data->DisplayPos.y);
+  DrawStream_WriteF32(&Buffer, draw_data->DisplaySize.x);
+  DrawStream_WriteF32(&Buffer, draw_data->DisplaySize.y);
+  DrawStream_WriteF32(&Buffer, draw_data->FramebufferScale.x);
+  DrawStream_WriteF32(&Buffer, draw_data->FramebufferScale.y);
+  DrawStream_WriteU32(&Buffer, (unsigned int)CurrRefs.Size);
+  for (int n = 0; n < CurrRefs.Size; n++) {
+    const int prev_n = DrawStream_FindPrevList(this, n);
+    if (prev_n != -1) {
+      PrevRefUsed[prev_n] = true;
+      DrawStream_WriteU32(&Buffer, DRAW_STREAM_LIST_REF | (unsigned int)prev_n);
+      ListsReused++;
+    } else {
+      DrawStream_WriteU32(&Buffer, (unsigned int)CurrRefs[n].Size);
+      DrawStream_Write(&Buffer, CurrLists.Data + CurrRefs[n].Offset,
+                       (size_t)CurrRefs[n].Size);
+      ListsSent++;
+    }
+  }
+  header.Size = (unsigned int)(Buffer.Size - header_offset - sizeof(header));
+  memcpy(Buffer.Data + header_offset, &header, sizeof(header));
+
+  PrevLists.swap(CurrLists);
+  PrevRefs.swap(CurrRefs);
+  FramesCount++;
+}
+
+void DrawStreamWriter::WriteTexture(TextureID tex_id, int width, int height,
+                                    const unsigned int *pixels) {
+  assert(width > 0 && height > 0 && pixels != NULL);
+  const size_t pixels_size = (size_t)width * height * sizeof(unsigned int);
+  DrawStreamHeader header = {DRAW_STREAM_MAGIC, DrawStreamChunk_Texture, 0};
+  header.Size = (unsigned int)(sizeof(unsigned long long) +
+                               sizeof(unsigned int) * 2 + pixels_size);
+  DrawStream_Write(&Buffer, &header, sizeof(header));
+  DrawStream_WriteU64(&Buffer, DrawStream_TexIdToU64(tex_id));
+  DrawStream_WriteU32(&Buffer, (unsigned int)width);
+  DrawStream_WriteU32(&Buffer, (unsigned int)height);
+  DrawStream_Write(&Buffer, pixels, pixels_size);
+}
+
+void DrawStreamWriter::WriteFontAtlas(Gui::FontAtlas *atlas) {
+  unsigned char *pixels;
+  int width, height;
+  atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+  WriteTexture(atlas->TexID, width, height, (const unsigned int *)pixels);
+}
+
+void DrawStreamWriter::Reset() {
+  PrevLists.resize(0);
+  PrevRefs.resize(0);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] DrawStreamReader
+//-----------------------------------------------------------------------------
+
+struct DrawStreamCursor {
+  const unsigned char *Data;
+  const unsigned char *DataEnd;
+
+  bool Read(void *out, size_t size) {
+    if ((size_t)(DataEnd - Data) < size)
+      return false;
+    memcpy(out, Data, size);
+    Data += size;
+    return true;
+  }
+  bool ReadU32(unsigned int *out) { return Read(out, sizeof(*out)); }
+  size_t GetRemaining() const { return (size_t)(DataEnd - Data); }
+};
+
+DrawStreamReader::DrawStreamReader() {
+  LastChunkType = DrawStreamChunk_None;
+  LastTexture = NULL;
+  RemapTextureFn = NULL;
+  RemapTextureUserData = NULL;
+}
+
+DrawStreamReader::~DrawStreamReader() {
+  for (DrawList *draw_list : FrameData.CmdLists)
+    DELETE(draw_list);
+  for (DrawList *draw_list : PrevLists)
+    if (draw_list != NULL)
+      DELETE(draw_list);
+  for (DrawList *draw_list : FreeLists)
+    DELETE(draw_list);
+  for (DrawStreamTexture *tex : Textures)
+    DELETE(tex);
+}
+
+DrawStreamTexture *DrawStreamReader::FindTexture(unsigned long long id) {
+  for (DrawStreamTexture *tex : Textures)
+    if (tex->Id == id)
+      return tex;
+  return NULL;
+}
+
+static bool DrawStream_ReadList(DrawStreamReader *reader,
+                                DrawStreamCursor *in, DrawList *draw_list) {
+  unsigned int flags, cmd_count, idx_count, vtx_count;
+  if (!in->ReadU32(&flags))
+    return false;
+#ifdef USE_DRAWVERT_COMPACT
+  if (!in->Read(&draw_list->VtxOrigin, sizeof(float) * 2))
+    return false;
+#endif
+  if (!in->ReadU32(&cmd_count) || !in->ReadU32(&idx_count) ||
+      !in->ReadU32(&vtx_count))
+    return false;
+
+  // Validate counts before allocating anything
+  const size_t cmd_size = sizeof(float) * 4 + sizeof(unsigned long long) +
+                          sizeof(unsigned int) * 4;
+  const size_t idx_size = (size_t)idx_count * sizeof(DrawIdx);
+  const size_t vtx_size = (size_t)vtx_count * sizeof(DrawVert);
+  if ((size_t)cmd_count * cmd_size + idx_size + vtx_size != in->GetRemaining())
+    return false;
+
+  draw_list->Flags = (int)flags;
+  draw_list->CmdBuffer.resize((int)cmd_count);
+  for (DrawCmd &cmd : draw_list->CmdBuffer) {
+    unsigned long long tex_id = 0;
+    unsigned int callback = 0;
+    if (!in->Read(&cmd.ClipRect, sizeof(float) * 4) ||
+        !in->Read(&tex_id, sizeof(tex_id)) || !in->ReadU32(&cmd.VtxOffset) ||
+        !in->ReadU32(&cmd.IdxOffset) || !in->ReadU32(&cmd.ElemCount) ||
+        !in->ReadU32(&callback))
+      return false;
+    cmd.TextureId = reader->RemapTextureFn
+                        ? reader->RemapTextureFn(tex_id,
+                                                 reader->RemapTextureUserData)
+                        : (TextureID)(size_t)tex_id;
+    cmd.UserCallback = (callback == DrawStreamCallback_ResetRenderState)
+                           ? DrawCallback_ResetRenderState
+                           : NULL;
+    cmd.UserCallbackData = NULL;
+    if (callback == DrawStreamCallback_User)
+      cmd.ElemCount = 0;
+  }
+  draw_list->IdxBuffer.resize((int)idx_count);
+  draw_list->VtxBuffer.resize((int)vtx_count);
+  if (!in->Read(draw_list->IdxBuffer.Data, idx_size) ||
+      !in->Read(draw_list->VtxBuffer.Data, vtx_size))
+    return false;
+
+  // Renderers trust commands: reject a list where any of them would read past
+  // the end of the index or vertex buffer.
+  for (const DrawCmd &cmd : draw_list->CmdBuffer) {
+    if (cmd.UserCallback != NULL || cmd.ElemCount == 0)
+      continue;
+    if ((unsigned long long)cmd.IdxOffset + cmd.ElemCount > idx_count ||
+        cmd.VtxOffset >= vtx_count)
+      return false;
+    const unsigned int vtx_max = vtx_count - cmd.VtxOffset;
+    const DrawIdx *idx = draw_list->IdxBuffer.Data + cmd.IdxOffset;
+    for (unsigned int n = 0; n < cmd.ElemCount; n++)
+      if ((unsigned int)idx[n] >= vtx_max)
+        return false;
+  }
+  return true;
+}
+
+static bool DrawStream_ReadFrame(DrawStreamReader *reader,
+                                 DrawStreamCursor *in) {
+  DrawData *draw_data = &reader->FrameData;
+  unsigned int frame_index, layout, lists_count;
+  float display[6];
+  if (!in->ReadU32(&frame_index) || !in->ReadU32(&layout) ||
+      layout != DRAW_STREAM_LAYOUT || !in->Read(display, sizeof(display)) ||
+      !in->ReadU32(&lists_count))
+    return false;
+
+  // Lists of the previous frame are either referenced again or recycled
+  reader->PrevLists.swap(draw_data->CmdLists);
+  draw_data->Clear();
+  bool ok = true;
+  for (unsigned int n = 0; n < lists_count && ok; n++) {
+    unsigned int v;
+    if (!in->ReadU32(&v)) {
+      ok = false;
+    } else if (v & DRAW_STREAM_LIST_REF) {
+      const int prev_n = (int)(v & ~DRAW_STREAM_LIST_REF);
+      if (prev_n >= reader->PrevLists.Size || !reader->PrevLists[prev_n]) {
+        ok = false;
+        continue;
+      }
+      draw_data->CmdLists.push_back(reader->PrevLists[prev_n]);
+      reader->PrevLists[prev_n] = NULL;
+    } else {
+      if (in->GetRemaining() < v) {
+        ok = false;
+        continue;
+      }
+      DrawList *draw_list;
+      if (reader->FreeLists.Size > 0) {
+        draw_list = reader->FreeLists.back();
+        reader->FreeLists.pop_back();
+      } else {
+        draw_list = NEW(DrawList)(NULL);
+      }
+      DrawStreamCursor list_in = {in->Data, in->Data + v};
+      in->Data += v;
+      if (!DrawStream_ReadList(reader, &list_in, draw_list)) {
+        reader->FreeLists.push_back(draw_list);
+        ok = false;
+        continue;
+      }
+      draw_data->CmdLists.push_back(draw_list);
+    }
+  }
+  for (DrawList *draw_list : reader->PrevLists)
+    if (draw_list != NULL)
+      reader->FreeLists.push_back(draw_list);
+  reader->PrevLists.resize(0);
+  if (!ok) {
+    for (DrawList *draw_list : draw_data->CmdLists)
+      reader->FreeLists.push_back(draw_list);
+    draw_data->Clear();
+    return false;
+  }
+
+  draw_data->CmdListsCount = draw_data->CmdLists.Size;
+  for (DrawList *draw_list : draw_data->CmdLists) {
+    draw_data->TotalVtxCount += draw_list->VtxBuffer.Size;
+    draw_data->TotalIdxCount += draw_list->IdxBuffer.Size;
+  }
+  draw_data->DisplayPos = Vec2(display[0], display[1]);
+  draw_data->DisplaySize = Vec2(display[2], display[3]);
+  draw_data->FramebufferScale = Vec2(display[4], display[5]);
+  draw_data->Valid = true;
+  return true;
+}
+
+static bool DrawStream_ReadTexture(DrawStreamReader *reader,
+                                   DrawStreamCursor *in) {
+  unsigned long long id;
+  unsigned int width, height;
+  if (!in->Read(&id, sizeof(id)) || !in->ReadU32(&width) ||
+      !in->ReadU32(&height) || width == 0 || height == 0 ||
+      (size_t)width * height * sizeof(unsigned int) != in->GetRemaining())
+    return false;
+
+  // A texture sent again with the same id replaces the previous one
+  DrawStreamTexture *tex = reader->FindTexture(id);
+  if (tex == NULL) {
+    tex = NEW(DrawStreamTexture)();
+    reader->Textures.push_back(tex);
+  }
+  tex->Id = id;
+  tex->Width = (int)width;
+  tex->Height = (int)height;
+  tex->Pixels.resize((int)(width * height));
+  in->Read(tex->Pixels.Data, in->GetRemaining());
+  reader->LastTexture = tex;
+  return true;
+}
+
+int DrawStreamReader::ReadChunk(const void *data, int data_size) {
+  DrawStreamHeader header;
+  if (data_size < (int)sizeof(header))
+    return 0;
+  memcpy(&header, data, sizeof(header));
+  if (header.Magic != DRAW_STREAM_MAGIC ||
+      header.Size > (unsigned int)(0x7FFFFFFF - sizeof(header)))
+    return -1;
+  const int chunk_size = (int)(sizeof(header) + header.Size);
+  if (data_size < chunk_size)
+    return 0;
+
+  const unsigned char *payload = (const unsigned char *)data + sizeof(header);
+  DrawStreamCursor in = {payload, payload + header.Size};
+  bool ok = true; // Skip unknown chunks
+  if (header.Type == DrawStreamChunk_Frame)
+    ok = DrawStream_ReadFrame(this, &in);
+  else if (header.Type == DrawStreamChunk_Texture)
+    ok = DrawStream_ReadTexture(this, &in);
+  LastChunkType = ok ? (int)header.Type : DrawStreamChunk_None;
+  return ok ? chunk_size : -1;
+}
+
+#endif // #ifndef DISABLE
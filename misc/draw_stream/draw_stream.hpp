@@ -0,0 +1,118 @@
+// gui: DrawData serialization and replay (optional)
+// This is an optional helper, it is not part of the core library.
+
+// DrawStreamWriter serializes the output of Gui::Render() (DrawData: draw
+// lists, commands, vertices, indices and texture references) into a compact
+// binary stream. DrawStreamReader decodes it back into a DrawData which can be
+// passed to any renderer backend. Use it to record a session and replay it
+// later (e.g. deterministic renderer benchmarks which don't depend on widget
+// code, see draw_stream_replay.cpp), or to stream frames of a headless
+// application to a remote viewer over a socket.
+// - The stream is a sequence of chunks, each starting with a DrawStreamHeader.
+// A chunk is either a frame or a texture (RGBA pixels, e.g. the font atlas).
+// - Draw lists which didn't change since the previous frame are sent as a
+// reference to the previous frame (typically most windows of an idle UI).
+// Call DrawStreamWriter::Reset() to send the next frame in full (e.g. when a
+// new viewer connects), readers must have decoded the previous frame.
+// - Texture ids are stored as 64-bit values. They are only meaningful for the
+// application which recorded them: set DrawStreamReader::RemapTextureFn to
+// translate them to textures of your renderer (e.g. created from the
+// received texture chunks).
+// - Vertices are stored as is: writer and reader must use the same DrawVert
+// and DrawIdx layouts (same USE_DRAWVERT_XXX and DrawIdx options). Values are
+// stored with the byte order of the writer (little-endian on all supported
+// platforms).
+// - User callbacks can't be replayed: commands using them are decoded with no
+// callback and no elements, except DrawCallback_ResetRenderState.
+// Usage (writer):
+//   static DrawStreamWriter writer;
+//   Gui::Render();
+//   if (frame == 0)
+//     writer.WriteFontAtlas(io.Fonts);
+//   writer.WriteFrame(Gui::GetDrawData());
+//   fwrite(writer.Buffer.Data, 1, writer.Buffer.Size, f); // or send()
+//   writer.Buffer.resize(0);
+// Usage (reader):
+//   static DrawStreamReader reader;
+//   while ((size = reader.ReadChunk(data, data_size)) > 0) {
+//     if (reader.LastChunkType == DrawStreamChunk_Frame)
+//       MyRenderer_RenderDrawData(&reader.FrameData);
+//     data += size; data_size -= size;
+//   }
+
+#pragma once
+#include "../../gui.hpp" // API
+#ifndef DISABLE
+
+#define DRAW_STREAM_MAGIC 0x31534447 // "GDS1"
+
+enum DrawStreamChunk_ {
+  DrawStreamChunk_None,
+  DrawStreamChunk_Frame,
+  DrawStreamChunk_Texture,
+};
+
+// Header of every chunk. 'Size' is the number of bytes following the header.
+struct DrawStreamHeader {
+  unsigned int Magic; // DRAW_STREAM_MAGIC
+  unsigned int Type;  // DrawStreamChunk_
+  unsigned int Size;
+};
+
+// Texture received from a texture chunk
+struct DrawStreamTexture {
+  unsigned long long Id; // Texture id in the writer application
+  int Width;
+  int Height;
+  Vector<unsigned int> Pixels; // COL32() format, as GetTexDataAsRGBA32()
+};
+
+struct DrawStreamWriter {
+  Vector<unsigned char> Buffer; // Chunks written so far: consume and clear.
+  int FramesCount;              // Frames written
+  int ListsSent;                // Draw lists written in full
+  int ListsReused;              // Draw lists written as a reference
+
+  // [Internal]
+  struct ListRef {
+    int Offset; // Offset of the serialized list in PrevLists
+    int Size;
+  };
+  Vector<unsigned char> PrevLists; // Serialized lists of the previous frame
+  Vector<unsigned char> CurrLists; // Serialized lists of the current frame
+  Vector<ListRef> PrevRefs, CurrRefs;
+  Vector<bool> PrevRefUsed;
+
+  API DrawStreamWriter();
+  API void WriteFrame(const DrawData *draw_data);
+  API void WriteTexture(TextureID tex_id, int width, int height,
+                        const unsigned int *pixels);
+  API void WriteFontAtlas(Gui::FontAtlas *atlas); // Pixels of atlas->TexID
+  API void Reset(); // Write the next frame without references
+};
+
+struct DrawStreamReader {
+  DrawData FrameData;         // Last decoded frame
+  int LastChunkType;          // DrawStreamChunk_ of the last chunk read
+  DrawStreamTexture *LastTexture; // Last texture received, if LastChunkType
+                                  // == DrawStreamChunk_Texture
+  Vector<DrawStreamTexture *> Textures; // All textures received
+
+  // Translate a recorded texture id (default: cast back to TextureID)
+  TextureID (*RemapTextureFn)(unsigned long long id, void *user_data);
+  void *RemapTextureUserData;
+
+  // [Internal]
+  Vector<DrawList *> PrevLists; // Lists of the previous frame
+  Vector<DrawList *> FreeLists; // Lists to reuse
+
+  API DrawStreamReader();
+  API ~DrawStreamReader();
+  // Decode the chunk at the start of 'data'. Return its size in bytes, 0 when
+  // 'data_size' doesn't hold a whole chunk yet, -1 when the data is invalid
+  // (bad magic, incompatible vertex layout, reference to an unknown list).
+  API int ReadChunk(const void *data, int data_size);
+  API DrawStreamTexture *FindTexture(unsigned long long id);
+};
+
+#endif // #ifndef DISABLE
@@ -0,0 +1,211 @@
+// gui
+// (draw_stream_replay.cpp)
+// Command line tool replaying a draw stream recorded with DrawStreamWriter
+// (e.g. 'example_null --record FILE') with the software renderer, to measure
+// rasterization performance on a fixed workload, independently of the widgets
+// code which produced it. The last frame can be saved as a PPM image to check
+// the output against the recording application.
+// To replay with another renderer, decode frames the same way and pass
+// DrawStreamReader::FrameData to its RenderDrawData() function, creating
+// textures from DrawStreamReader::Textures.
+
+// Build with, e.g:
+//   # g++ -O2 -I../.. -I../../backends draw_stream_replay.cpp draw_stream.cpp
+//     ../../gui.cpp ../../draw.cpp ../../tables.cpp ../../widgets.cpp
+//     ../../backends/software.cpp -lpthread
+// (defines changing DrawVert, like USE_DRAWVERT_COMPACT, must match the
+// application which recorded the stream)
+// Usage:
+//   draw_stream_replay <inputfile> [--loops N] [--threads N] [--ppm FILE]
+//   --loops N     Replay the whole stream N times (default 1)
+//   --threads N   Rasterizer threads (default 0: all cores)
+//   --ppm FILE    Write the last frame to FILE
+
+#define _CRT_SECURE_NO_WARNINGS
+#include "draw_stream.hpp"
+#include "software.hpp"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+typedef std::chrono::steady_clock ReplayClock;
+
+static double ReplayElapsedMs(ReplayClock::time_point t0,
+                              ReplayClock::time_point t1) {
+  return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+// Software textures created from the received texture chunks. Pixels point
+// into DrawStreamTexture::Pixels, owned by the reader. Textures are allocated
+// one by one: draw lists reused from a previous frame keep pointers to them.
+struct ReplayTextures {
+  DrawStreamReader *Reader;
+  std::vector<Software_Texture *> Textures; // Parallel to Reader->Textures
+  Software_Texture Missing;                 // For ids without texture chunk
+  unsigned int MissingPixel;
+
+  ~ReplayTextures() {
+    for (Software_Texture *tex : Textures)
+      delete tex;
+  }
+  void Update() {
+    while (Textures.size() < (size_t)Reader->Textures.Size)
+      Textures.push_back(new Software_Texture());
+    for (int n = 0; n < Reader->Textures.Size; n++) {
+      const DrawStreamTexture *src = Reader->Textures[n];
+      Textures[n]->Pixels = src->Pixels.Data;
+      Textures[n]->Width = src->Width;
+      Textures[n]->Height = src->Height;
+    }
+  }
+};
+
+static TextureID ReplayRemapTexture(unsigned long long id, void *user_data) {
+  ReplayTextures *textures = (ReplayTextures *)user_data;
+  for (int n = 0; n < textures->Reader->Textures.Size; n++)
+    if (textures->Reader->Textures[n]->Id == id)
+      return (TextureID)textures->Textures[n];
+  return (TextureID)&textures->Missing;
+}
+
+static bool WritePPM(const char *filename, const unsigned int *pixels, int w,
+                     int h) {
+  FILE *f = fopen(filename, "wb");
+  if (f == NULL)
+    return false;
+  fprintf(f, "P6\n%d %d\n255\n", w, h);
+  for (int n = 0; n < w * h; n++) {
+    const unsigned int c = pixels[n];
+    const unsigned char rgb[3] = {(unsigned char)(c >> COL32_R_SHIFT),
+                                  (unsigned char)(c >> COL32_G_SHIFT),
+                                  (unsigned char)(c >> COL32_B_SHIFT)};
+    fwrite(rgb, 1, 3, f);
+  }
+  fclose(f);
+  return true;
+}
+
+int main(int argc, char **argv) {
+  const char *input_filename = NULL;
+  const char *ppm_filename = NULL;
+  int loops_count = 1;
+  int threads_count = 0;
+  bool syntax_error = false;
+  for (int n = 1; n < argc; n++) {
+    if (strcmp(argv[n], "--loops") == 0 && n + 1 < argc)
+      loops_count = atoi(argv[++n]);
+    else if (strcmp(argv[n], "--threads") == 0 && n + 1 < argc)
+      threads_count = atoi(argv[++n]);
+    else if (strcmp(argv[n], "--ppm") == 0 && n + 1 < argc)
+      ppm_filename = argv[++n];
+    else if (input_filename == NULL && argv[n][0] != '-')
+      input_filename = argv[n];
+    else
+      syntax_error = true;
+  }
+  if (input_filename == NULL || syntax_error) {
+    printf("Syntax: %s <inputfile> [--loops N] [--threads N] [--ppm FILE]\n",
+           argv[0]);
+    return 0;
+  }
+
+  // Load the whole stream in memory
+  FILE *f = fopen(input_filename, "rb");
+  if (f == NULL) {
+    fprintf(stderr, "Could not open '%s'\n", input_filename);
+    return 1;
+  }
+  std::vector<unsigned char> data;
+  fseek(f, 0, SEEK_END);
+  data.resize((size_t)ftell(f));
+  fseek(f, 0, SEEK_SET);
+  const bool read_ok = fread(data.data(), 1, data.size(), f) == data.size();
+  fclose(f);
+  if (!read_ok || data.size() > 0x7FFFFFFF) {
+    fprintf(stderr, "Could not read '%s'\n", input_filename);
+    return 1;
+  }
+
+  // The software backend requires a context. Its own font texture is unused:
+  // commands refer to the textures received from the stream.
+  Gui::CreateContext();
+  Gui::GetIO().IniFilename = NULL;
+  Software_Init(threads_count);
+
+  DrawStreamReader reader;
+  ReplayTextures textures;
+  textures.Reader = &reader;
+  textures.MissingPixel = 0xFFFFFFFF;
+  textures.Missing.Pixels = &textures.MissingPixel;
+  textures.Missing.Width = textures.Missing.Height = 1;
+  reader.RemapTextureFn = ReplayRemapTexture;
+  reader.RemapTextureUserData = &textures;
+
+  std::vector<unsigned int> framebuffer;
+  int fb_width = 0, fb_height = 0;
+  int frames_count = 0;
+  long long pixels_written = 0;
+  double decode_ms = 0.0, raster_ms = 0.0;
+  for (int loop = 0; loop < loops_count; loop++) {
+    const unsigned char *p = data.data();
+    int remaining = (int)data.size();
+    while (remaining > 0) {
+      ReplayClock::time_point t0 = ReplayClock::now();
+      const int chunk_size = reader.ReadChunk(p, remaining);
+      ReplayClock::time_point t1 = ReplayClock::now();
+      if (chunk_size <= 0) {
+        fprintf(stderr, "Invalid or truncated stream at offset %d\n",
+                (int)(p - data.data()));
+        break;
+      }
+      p += chunk_size;
+      remaining -= chunk_size;
+      if (reader.LastChunkType == DrawStreamChunk_Texture) {
+        textures.Update();
+        continue;
+      }
+      if (reader.LastChunkType != DrawStreamChunk_Frame)
+        continue;
+
+      DrawData *draw_data = &reader.FrameData;
+      const int w =
+          (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+      const int h =
+          (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+      if (w <= 0 || h <= 0)
+        continue;
+      if (w != fb_width || h != fb_height) {
+        fb_width = w;
+        fb_height = h;
+        framebuffer.resize((size_t)w * h);
+      }
+      memset(framebuffer.data(), 0, framebuffer.size() * sizeof(unsigned int));
+      ReplayClock::time_point t2 = ReplayClock::now();
+      Software_RenderDrawData(draw_data, framebuffer.data(), w, h, w * 4);
+      ReplayClock::time_point t3 = ReplayClock::now();
+      decode_ms += ReplayElapsedMs(t0, t1);
+      raster_ms += ReplayElapsedMs(t2, t3);
+      pixels_written += Software_GetStats().PixelsWritten;
+      frames_count++;
+    }
+  }
+
+  if (frames_count > 0) {
+    printf("%d frames (%dx%d), %d textures\n", frames_count, fb_width,
+           fb_height, reader.Textures.Size);
+    printf("decode %.3f ms/frame, raster %.3f ms/frame, %.0f pixels/frame, "
+           "%.1f Mpixels/s\n",
+           decode_ms / frames_count, raster_ms / frames_count,
+           (double)pixels_written / frames_count,
+           raster_ms > 0.0 ? pixels_written / (raster_ms * 1000.0) : 0.0);
+  }
+  if (ppm_filename && frames_count > 0 &&
+      !WritePPM(ppm_filename, framebuffer.data(), fb_width, fb_height))
+    fprintf(stderr, "Could not write '%s'\n", ppm_filename);
+
+  Software_Shutdown();
+  Gui::DestroyContext();
+  return frames_count > 0 ? 0 : 1;
+}
@@ -3,6 +3,8 @@
 // [SECTION] Tables: Main code
 // [SECTION] Tables: Simple accessors
 // [SECTION] Tables: Row changes
+// [SECTION] Tables: Row clipper
+// [SECTION] Tables: Virtual columns
 // [SECTION] Tables: Columns changes
 // [SECTION] Tables: Columns width management
 // [SECTION] Tables: Drawing
@@ -411,6 +413,11 @@ inline int TableFixFlags(int flags, Window *outer_window) {
   if (flags & (TableFlags_ScrollX | TableFlags_ScrollY))
     flags &= ~(TableFlags_NoHostExtendX | TableFlags_NoHostExtendY);
 
+  // Adjust flags: virtual columns are only laid out when scrolling
+  // horizontally
+  if ((flags & TableFlags_ScrollX) == 0)
+    flags &= ~TableFlags_VirtualColumns;
+
   // Adjust flags: NoBordersInBodyUntilResize takes priority over
   // NoBordersInBody
   if (flags & TableFlags_NoBordersInBodyUntilResize)
@@ -502,6 +509,16 @@ bool Gui::BeginTableEx(const char *name, int id, int columns_count, int flags,
   table->Flags = flags;
   table->LastFrameActive = g.FrameCount;
   table->OuterWindow = table->InnerWindow = outer_window;
+
+  // Virtual columns are mapped onto extra columns ("slots") appended after
+  // regular ones. Their count is adjusted by TableSetupVirtualColumns().
+  TableVirtualColumns *virtual_columns = &table->VirtualColumns;
+  virtual_columns->SlotsFirst = columns_count;
+  virtual_columns->IsSetup = false;
+  if (flags & TableFlags_VirtualColumns)
+    columns_count += virtual_columns->SlotsCount;
+  else
+    virtual_columns->SlotsCount = 0;
   table->ColumnsCount = columns_count;
   table->IsLayoutLocked = false;
   table->InnerWidth = inner_width;
@@ -782,6 +799,10 @@ bool Gui::BeginTableEx(const char *name, int id, int columns_count, int flags,
     for (int n = 0; n < columns_count; n++)
       table->Columns[n].WidthRequest =
           table->Columns[n].WidthRequest * scale_factor;
+    for (float &width : virtual_columns->Widths)
+      if (width >= 0.0f)
+        width = width * scale_factor;
+    virtual_columns->Tree.resize(0); // Rebuild in TableSetupVirtualColumns()
   }
   table->RefScale = new_ref_scale_unit;
 
@@ -835,6 +856,7 @@ void Gui::TableBeginInitMemory(Table *table, int columns_count) {
       (unsigned int *)span_allocator.GetSpanPtrBegin(3);
   table->EnabledMaskByIndex = (unsigned int *)span_allocator.GetSpanPtrBegin(4);
   table->VisibleMaskByIndex = (unsigned int *)span_allocator.GetSpanPtrBegin(5);
+  table->VirtualColumns.IsMapped = false;
 }
 
 // Apply queued resizing/reordering/hiding requests
@@ -1004,6 +1026,11 @@ void Gui::TableUpdateLayout(Table *table) {
   Context &g = *GGui;
   assert(table->IsLayoutLocked == false);
 
+  assert(((table->Flags & TableFlags_VirtualColumns) == 0 ||
+          table->VirtualColumns.IsSetup) &&
+         "Need to call TableSetupVirtualColumns() every frame when using "
+         "TableFlags_VirtualColumns!");
+
   const int table_sizing_policy = (table->Flags & TableFlags_SizingMask_);
   table->IsDefaultDisplayOrder = true;
   table->ColumnsEnabledCount = 0;
@@ -1320,6 +1347,12 @@ void Gui::TableUpdateLayout(Table *table) {
   Rect host_clip_rect = table->InnerClipRect;
   // host_clip_rect.Max.x += table->CellPaddingX + table->CellSpacingX2;
   BitArrayClearAllBits(table->VisibleMaskByIndex, table->ColumnsCount);
+  TableVirtualColumns *virtual_columns = &table->VirtualColumns;
+  const int virtual_slots_first =
+      (table->Flags & TableFlags_VirtualColumns) ? virtual_columns->SlotsFirst
+                                                 : table->ColumnsCount;
+  const double virtual_spacing = table->CellSpacingX1 + table->CellSpacingX2 +
+                                 table->CellPaddingX * 2.0f;
   for (int order_n = 0; order_n < table->ColumnsCount; order_n++) {
     const int column_n = table->DisplayOrderToIndex[order_n];
     TableColumn *column = &table->Columns[column_n];
@@ -1335,6 +1368,19 @@ void Gui::TableUpdateLayout(Table *table) {
       offset_x_frozen = false;
     }
 
+    // Place slots at the position of the logical column they are mapped to.
+    // (slots can't be reordered: their display order is their index)
+    if (column_n >= virtual_slots_first) {
+      if (column_n == virtual_slots_first)
+        virtual_columns->OffsetX = offset_x - work_rect.Min.x;
+      offset_x = work_rect.Min.x + virtual_columns->OffsetX +
+                 (float)TableVirtualColumnsGetOffset(
+                     virtual_columns,
+                     virtual_columns->DisplayStart + column_n -
+                         virtual_slots_first,
+                     virtual_spacing);
+    }
+
     // Clear status flags
     column->Flags &= ~TableColumnFlags_StatusMask_;
 
@@ -1736,6 +1782,20 @@ void Gui::EndTable() {
                       table->Columns[table->RightMostEnabledColumn].WorkMaxX +
                           table->CellPaddingX + table->OuterPaddingX -
                           outer_padding_for_border);
+    if (table->Flags & TableFlags_VirtualColumns) {
+      const TableVirtualColumns *virtual_columns = &table->VirtualColumns;
+      const double virtual_spacing = table->CellSpacingX1 +
+                                     table->CellSpacingX2 +
+                                     table->CellPaddingX * 2.0f;
+      const float virtual_max_x =
+          table->WorkRect.Min.x + virtual_columns->OffsetX +
+          (float)TableVirtualColumnsGetOffset(virtual_columns,
+                                              virtual_columns->ColumnsCount,
+                                              virtual_spacing);
+      max_pos_x = Max(max_pos_x, virtual_max_x - table->CellSpacingX2 +
+                                     table->OuterPaddingX -
+                                     outer_padding_for_border);
+    }
     if (table->ResizedColumn != -1)
       max_pos_x = Max(max_pos_x, table->ResizeLockMinContentsX2);
     table->InnerWindow->DC.CursorMaxPos.x =
@@ -2040,9 +2100,13 @@ void Gui::TableSetupScrollFreeze(int columns, int rows) {
   assert(columns >= 0 && columns < TABLE_MAX_COLUMNS);
   assert(rows >= 0 && rows < 128); // Arbitrary limit
 
+  // Virtual columns can't be frozen
+  const int columns_max = (table->Flags & TableFlags_VirtualColumns)
+                              ? table->VirtualColumns.SlotsFirst
+                              : table->ColumnsCount;
   table->FreezeColumnsRequest =
       (table->Flags & TableFlags_ScrollX)
-          ? (TableColumnIdx)Min(columns, table->ColumnsCount)
+          ? (TableColumnIdx)Min(columns, columns_max)
           : 0;
   table->FreezeColumnsCount =
       (table->InnerWindow->Scroll.x != 0.0f) ? table->FreezeColumnsRequest : 0;
@@ -2500,11 +2564,639 @@ void Gui::TableEndRow(Table *table) {
         window->DrawList, table->Columns[0].DrawChannelCurrent);
   }
 
+  // Record row height for TableRowClipper
+  TableRowHeights *row_heights = &table->RowHeights;
+  if (row_heights->SubmitRow < row_heights->SubmitRowEnd)
+    TableRowHeightsSetHeight(row_heights, row_heights->SubmitRow++,
+                             bg_y2 - bg_y1);
+
   if (!(table->RowFlags & TableRowFlags_Headers))
     table->RowBgColorCounter++;
   table->IsInsideRow = false;
 }
 
+//-------------------------------------------------------------------------
+// [SECTION] Tables: Row clipper
+//-------------------------------------------------------------------------
+// - TableRowHeightsSetup() [Internal]
+// - TableRowHeightsGetHeight() [Internal]
+// - TableRowHeightsSetHeight() [Internal]
+// - TableRowHeightsGetOffset() [Internal]
+// - TableRowHeightsFindRow() [Internal]
+// - TableRowClipper::Begin()
+// - TableRowClipper::End()
+// - TableRowClipper::Step()
+//-------------------------------------------------------------------------
+
+// Rebuild row heights in display order when the rows count, rows order or
+// default height changed. O(N), otherwise O(1).
+void Gui::TableRowHeightsSetup(TableRowHeights *heights, int rows_count,
+                               float default_height, const int *rows_order,
+                               bool rows_order_changed) {
+  bool rebuild = heights->IsOrderDirty || rows_order_changed ||
+                 heights->RowsOrder != rows_order ||
+                 heights->RowsCount != rows_count ||
+                 heights->Tree.Size != rows_count + 1;
+  if (default_height > 0.0f && default_height != heights->DefaultHeight) {
+    heights->DefaultHeight = default_height;
+    rebuild = true;
+  }
+  if (!rebuild)
+    return;
+
+  // Preserve heights of existing items (data is generally appended to)
+  const int old_items_count = heights->ItemsHeight.Size;
+  heights->ItemsHeight.resize(rows_count);
+  for (int n = old_items_count; n < rows_count; n++)
+    heights->ItemsHeight.Data[n] = -1.0f;
+  heights->RowsCount = rows_count;
+  heights->RowsOrder = rows_order;
+  heights->IsOrderDirty = false;
+
+  // Build Fenwick tree in O(N): each node pushes its partial sum to its parent
+  heights->Tree.resize(rows_count + 1);
+  double *tree = heights->Tree.Data;
+  tree[0] = 0.0;
+  for (int n = 1; n <= rows_count; n++)
+    tree[n] = TableRowHeightsGetHeight(heights, n - 1);
+  for (int n = 1; n <= rows_count; n++) {
+    const int parent = n + (n & -n);
+    if (parent <= rows_count)
+      tree[parent] += tree[n];
+  }
+}
+
+float Gui::TableRowHeightsGetHeight(const TableRowHeights *heights, int row) {
+  const int item = heights->RowsOrder ? heights->RowsOrder[row] : row;
+  const float height = heights->ItemsHeight.Data[item];
+  return (height >= 0.0f) ? height : heights->DefaultHeight;
+}
+
+void Gui::TableRowHeightsSetHeight(TableRowHeights *heights, int row,
+                                   float height) {
+  assert(row >= 0 && row < heights->RowsCount);
+  const int item = heights->RowsOrder ? heights->RowsOrder[row] : row;
+  const double delta =
+      (double)height - (double)TableRowHeightsGetHeight(heights, row);
+  heights->ItemsHeight.Data[item] = height;
+  if (delta == 0.0)
+    return;
+  for (int n = row + 1; n <= heights->RowsCount; n += (n & -n))
+    heights->Tree.Data[n] += delta;
+}
+
+double Gui::TableRowHeightsGetOffset(const TableRowHeights *heights, int row) {
+  double offset = 0.0;
+  for (int n = Min(row, heights->RowsCount); n > 0; n -= (n & -n))
+    offset += heights->Tree.Data[n];
+  return offset;
+}
+
+// Binary search down the Fenwick tree. Return RowsCount when 'offset' is past
+// the last row.
+int Gui::TableRowHeightsFindRow(const TableRowHeights *heights,
+                                double offset) {
+  int row = 0;
+  int step = 1;
+  while (step * 2 <= heights->RowsCount)
+    step *= 2;
+  for (; step > 0; step >>= 1)
+    if (row + step <= heights->RowsCount &&
+        heights->Tree.Data[row + step] <= offset) {
+      row += step;
+      offset -= heights->Tree.Data[row];
+    }
+  return row;
+}
+
+// Same as ListClipper_SeekCursorAndSetupPrevLine() but with exact row
+// positions, so RowBgColorCounter can be fast-forwarded by the number of
+// skipped rows.
+static void TableRowClipper_SeekCursorForRow(TableRowClipper *clipper,
+                                             int row) {
+  Context &g = *clipper->Ctx;
+  Table *table = g.CurrentTable;
+  Window *window = table->InnerWindow;
+  TableRowHeights *heights = (TableRowHeights *)clipper->TempData;
+  const double offset =
+      Gui::TableRowHeightsGetOffset(heights, row) -
+      Gui::TableRowHeightsGetOffset(heights, heights->ItemsFrozen);
+  const float pos_y = (float)((double)clipper->StartPosY +
+                              heights->LossynessOffset + offset);
+  const float line_height = (row > 0)
+                                ? Gui::TableRowHeightsGetHeight(heights, row - 1)
+                                : heights->DefaultHeight;
+  window->DC.CursorPos.y = pos_y;
+  window->DC.CursorMaxPos.y =
+      Max(window->DC.CursorMaxPos.y, pos_y - g.Style.ItemSpacing.y);
+  window->DC.CursorPosPrevLine.y = pos_y - line_height;
+  window->DC.PrevLineSize.y = line_height - g.Style.ItemSpacing.y;
+  table->RowPosY2 = pos_y;
+  if (row > heights->SubmitRow)
+    table->RowBgColorCounter += row - heights->SubmitRow;
+  heights->SubmitRow = row;
+}
+
+// Convert a range of absolute positions to a range of rows
+static ListClipperRange TableRowClipper_RangeFromPositions(
+    TableRowClipper *clipper, float y1, float y2, int off_min, int off_max,
+    int min_row) {
+  TableRowHeights *heights = (TableRowHeights *)clipper->TempData;
+  const double base =
+      Gui::TableRowHeightsGetOffset(heights, heights->ItemsFrozen) -
+      (double)clipper->StartPosY - heights->LossynessOffset;
+  const int row1 = Gui::TableRowHeightsFindRow(heights, base + y1);
+  const int row2 = Gui::TableRowHeightsFindRow(heights, base + y2) + 1;
+  const int row_min =
+      Clamp(row1 + off_min, min_row, Max(min_row, clipper->RowsCount - 1));
+  return ListClipperRange::FromIndices(
+      row_min, Clamp(row2 + off_max, row_min + 1, clipper->RowsCount));
+}
+
+static void TableRowClipper_SortAndFuseRanges(Vector<ListClipperRange> &ranges,
+                                              int offset) {
+  for (int sort_end = ranges.Size - offset - 1; sort_end > 0; --sort_end)
+    for (int i = offset; i < sort_end + offset; ++i)
+      if (ranges[i].Min > ranges[i + 1].Min)
+        Swap(ranges[i], ranges[i + 1]);
+  for (int i = 1 + offset; i < ranges.Size; i++) {
+    if (ranges[i - 1].Max < ranges[i].Min)
+      continue;
+    ranges[i - 1].Max = Max(ranges[i - 1].Max, ranges[i].Max);
+    ranges.erase(ranges.Data + i);
+    i--;
+  }
+}
+
+TableRowClipper::TableRowClipper() { memset(this, 0, sizeof(*this)); }
+
+TableRowClipper::~TableRowClipper() { End(); }
+
+void TableRowClipper::Begin(int rows_count, float rows_height_estimate,
+                            const int *rows_order, bool rows_order_changed) {
+  if (Ctx == NULL)
+    Ctx = Gui::GetCurrentContext();
+
+  Context &g = *Ctx;
+  Table *table = g.CurrentTable;
+  assert(table != NULL && "TableRowClipper must be used within a table!");
+  TableRowHeights *heights = &table->RowHeights;
+  assert(!heights->IsClipperActive &&
+         "Only one TableRowClipper may be active per table.");
+  if (table->IsInsideRow)
+    Gui::TableEndRow(table);
+
+  Gui::TableRowHeightsSetup(heights, rows_count, rows_height_estimate,
+                            rows_order, rows_order_changed);
+  heights->IsClipperActive = true;
+  heights->StepNo = heights->ItemsFrozen = 0;
+  heights->SubmitRow = heights->SubmitRowEnd = 0;
+  heights->LossynessOffset = table->InnerWindow->DC.CursorStartPosLossyness.y;
+  heights->Ranges.resize(0);
+  StartPosY = table->InnerWindow->DC.CursorPos.y;
+  RowsCount = rows_count;
+  DisplayStart = -1;
+  DisplayEnd = 0;
+  TempData = heights;
+}
+
+void TableRowClipper::End() {
+  if (TableRowHeights *heights = (TableRowHeights *)TempData) {
+    // Seek to the end of the table so the scrollbar accounts for all rows.
+    // We can't do it if the table was already ended by the user.
+    Context &g = *Ctx;
+    if (g.CurrentTable && &g.CurrentTable->RowHeights == heights &&
+        DisplayStart >= 0) {
+      if (g.CurrentTable->IsInsideRow)
+        Gui::TableEndRow(g.CurrentTable);
+      TableRowClipper_SeekCursorForRow(this, RowsCount);
+    }
+    heights->IsClipperActive = false;
+    heights->SubmitRow = heights->SubmitRowEnd = 0;
+    TempData = NULL;
+  }
+  RowsCount = -1;
+}
+
+static bool TableRowClipper_StepInternal(TableRowClipper *clipper) {
+  Context &g = *clipper->Ctx;
+  TableRowHeights *heights = (TableRowHeights *)clipper->TempData;
+  assert(heights != NULL && "Called TableRowClipper::Step() too many times, "
+                            "or before TableRowClipper::Begin() ?");
+  Table *table = g.CurrentTable;
+  assert(table != NULL && &table->RowHeights == heights);
+  Window *window = table->InnerWindow;
+
+  // Ending the row records its height
+  if (table->IsInsideRow)
+    Gui::TableEndRow(table);
+
+  if (clipper->RowsCount == 0 || table->HostSkipItems)
+    return false;
+
+  // While we are in frozen row state, keep displaying rows one by one,
+  // unclipped
+  if (heights->StepNo == 0 && !table->IsUnfrozenRows) {
+    clipper->DisplayStart = heights->ItemsFrozen;
+    clipper->DisplayEnd = Min(heights->ItemsFrozen + 1, clipper->RowsCount);
+    if (clipper->DisplayStart < clipper->DisplayEnd)
+      heights->ItemsFrozen++;
+    heights->SubmitRowEnd = clipper->DisplayEnd;
+    return true;
+  }
+
+  // Step 0: Without estimate, submit the first row unclipped so we can
+  // measure it.
+  bool calc_clipping = false;
+  if (heights->StepNo == 0) {
+    clipper->StartPosY = window->DC.CursorPos.y;
+    if (heights->DefaultHeight <= 0.0f) {
+      heights->Ranges.push_back(ListClipperRange::FromIndices(
+          heights->ItemsFrozen, heights->ItemsFrozen + 1));
+      clipper->DisplayStart = heights->ItemsFrozen;
+      clipper->DisplayEnd = Min(heights->ItemsFrozen + 1, clipper->RowsCount);
+      heights->SubmitRowEnd = clipper->DisplayEnd;
+      heights->StepNo = 1;
+      return true;
+    }
+    calc_clipping = true;
+  }
+
+  // Step 1: Use the first row height as default height
+  const int already_submitted = clipper->DisplayEnd;
+  if (heights->DefaultHeight <= 0.0f) {
+    assert(heights->StepNo == 1);
+    const float row_height =
+        Gui::TableRowHeightsGetHeight(heights, clipper->DisplayStart);
+    assert(row_height > 0.0f && "Unable to calculate row height! First row "
+                                "hasn't moved the cursor vertically!");
+    Gui::TableRowHeightsSetup(heights, clipper->RowsCount, row_height,
+                              heights->RowsOrder, true);
+    calc_clipping = true;
+  }
+
+  // Step 0 or 1: Calculate the actual ranges of visible rows.
+  if (calc_clipping) {
+    Vector<ListClipperRange> &ranges = heights->Ranges;
+    const int ranges_offset = heights->StepNo;
+    const int min_row = Max(already_submitted, heights->ItemsFrozen);
+    if (g.LogEnabled) {
+      // If logging is active, do not perform any clipping
+      ranges.push_back(
+          ListClipperRange::FromIndices(min_row, clipper->RowsCount));
+    } else {
+      // Add range selected to be included for navigation
+      const bool is_nav_request =
+          (g.NavMoveScoringItems && g.NavWindow &&
+           g.NavWindow->RootWindowForNav == window->RootWindowForNav);
+      if (is_nav_request)
+        ranges.push_back(TableRowClipper_RangeFromPositions(
+            clipper, g.NavScoringNoClipRect.Min.y,
+            g.NavScoringNoClipRect.Max.y, 0, 0, min_row));
+      if (is_nav_request && (g.NavMoveFlags & NavMoveFlags_IsTabbing) &&
+          g.NavTabbingDir == -1)
+        ranges.push_back(ListClipperRange::FromIndices(
+            Max(min_row, clipper->RowsCount - 1), clipper->RowsCount));
+
+      // Add focused/active row
+      Rect nav_rect_abs =
+          Gui::WindowRectRelToAbs(window, window->NavRectRel[0]);
+      if (g.NavId != 0 && window->NavLastIds[0] == g.NavId)
+        ranges.push_back(TableRowClipper_RangeFromPositions(
+            clipper, nav_rect_abs.Min.y, nav_rect_abs.Max.y, 0, 0, min_row));
+
+      // Add visible range
+      const int off_min =
+          (is_nav_request && g.NavMoveClipDir == Dir_Up) ? -1 : 0;
+      const int off_max =
+          (is_nav_request && g.NavMoveClipDir == Dir_Down) ? 1 : 0;
+      ranges.push_back(TableRowClipper_RangeFromPositions(
+          clipper, window->ClipRect.Min.y, window->ClipRect.Max.y, off_min,
+          off_max, min_row));
+    }
+    TableRowClipper_SortAndFuseRanges(ranges, ranges_offset);
+  } else if (already_submitted < clipper->RowsCount &&
+             window->DC.CursorPos.y >= window->ClipRect.Min.y &&
+             window->DC.CursorPos.y < window->ClipRect.Max.y) {
+    // Rows we just submitted were taller or smaller than estimated and didn't
+    // reach the bottom of the clip rect: extend the range we just displayed.
+    const int extra_rows = Max(
+        1, (int)((window->ClipRect.Max.y - window->DC.CursorPos.y) /
+                 heights->DefaultHeight) +
+               1);
+    heights->Ranges.insert(
+        heights->Ranges.Data + heights->StepNo,
+        ListClipperRange::FromIndices(
+            already_submitted,
+            Min(already_submitted + extra_rows, clipper->RowsCount)));
+    TableRowClipper_SortAndFuseRanges(heights->Ranges, heights->StepNo);
+  }
+
+  // Step 0+ (if row height is known in advance) or 1+: Display the next range
+  // in line.
+  while (heights->StepNo < heights->Ranges.Size) {
+    clipper->DisplayStart =
+        Max(heights->Ranges[heights->StepNo].Min, already_submitted);
+    clipper->DisplayEnd =
+        Min(heights->Ranges[heights->StepNo].Max, clipper->RowsCount);
+    if (clipper->DisplayStart > already_submitted) //-V1051
+      TableRowClipper_SeekCursorForRow(clipper, clipper->DisplayStart);
+    heights->SubmitRowEnd = clipper->DisplayEnd;
+    heights->StepNo++;
+    if (clipper->DisplayStart >= clipper->DisplayEnd &&
+        heights->StepNo < heights->Ranges.Size)
+      continue;
+    return true;
+  }
+
+  // After the last step: advance the cursor to the end of the table and
+  // return 'false' to end the loop.
+  TableRowClipper_SeekCursorForRow(clipper, clipper->RowsCount);
+  return false;
+}
+
+bool TableRowClipper::Step() {
+  Context &g = *Ctx;
+  bool ret = TableRowClipper_StepInternal(this);
+  if (ret && (DisplayStart >= DisplayEnd))
+    ret = false;
+  if (ret)
+    DEBUG_LOG_CLIPPER("TableRowClipper: Step(): display %d to %d.\n",
+                      DisplayStart, DisplayEnd);
+  else
+    End();
+  return ret;
+}
+
+//-------------------------------------------------------------------------
+// [SECTION] Tables: Virtual columns
+//-------------------------------------------------------------------------
+// - TableVirtualColumnsSetup() [Internal]
+// - TableVirtualColumnsGetWidth() [Internal]
+// - TableVirtualColumnsSetWidth() [Internal]
+// - TableVirtualColumnsGetOffset() [Internal]
+// - TableVirtualColumnsFindColumn() [Internal]
+// - TableSetupVirtualColumns()
+// - TableGetVirtualColumnsRange()
+// - TableSetVirtualColumnIndex()
+// - TableGetVirtualColumnWidth()
+// - TableSetVirtualColumnWidth()
+//-------------------------------------------------------------------------
+// With TableFlags_VirtualColumns, the logical columns in sight are mapped
+// onto a few extra table columns ("slots") appended after the columns passed
+// to BeginTable(). Slots go through the regular layout, borders, draw
+// channels and cells code, each frame they are placed at the position of the
+// logical column they are mapped to. Logical columns widths are stored in a
+// Fenwick tree (same as TableRowHeights) so positions and the logical
+// column at a given position are found in O(log N).
+//-------------------------------------------------------------------------
+
+// Rebuild widths when the columns count or default width changed. O(N),
+// otherwise O(1).
+void Gui::TableVirtualColumnsSetup(TableVirtualColumns *columns,
+                                   int columns_count, float default_width) {
+  default_width = Trunc(Max(default_width, 1.0f));
+  bool rebuild = columns->ColumnsCount != columns_count ||
+                 columns->Tree.Size != columns_count + 1;
+  if (default_width != columns->DefaultWidth) {
+    columns->DefaultWidth = default_width;
+    rebuild = true;
+  }
+  if (!rebuild)
+    return;
+
+  // Preserve widths of existing columns (data is generally appended to)
+  const int old_columns_count = columns->Widths.Size;
+  columns->Widths.resize(columns_count);
+  for (int n = old_columns_count; n < columns_count; n++)
+    columns->Widths.Data[n] = -1.0f;
+  columns->ColumnsCount = columns_count;
+
+  // Build Fenwick tree in O(N): each node pushes its partial sum to its parent
+  columns->Tree.resize(columns_count + 1);
+  double *tree = columns->Tree.Data;
+  tree[0] = 0.0;
+  for (int n = 1; n <= columns_count; n++)
+    tree[n] = TableVirtualColumnsGetWidth(columns, n - 1);
+  for (int n = 1; n <= columns_count; n++) {
+    const int parent = n + (n & -n);
+    if (parent <= columns_count)
+      tree[parent] += tree[n];
+  }
+}
+
+float Gui::TableVirtualColumnsGetWidth(const TableVirtualColumns *columns,
+                                       int column_n) {
+  const float width = columns->Widths.Data[column_n];
+  return (width >= 0.0f) ? width : columns->DefaultWidth;
+}
+
+// Widths are truncated so that columns land on whole pixels
+void Gui::TableVirtualColumnsSetWidth(TableVirtualColumns *columns,
+                                      int column_n, float width) {
+  assert(column_n >= 0 && column_n < columns->ColumnsCount);
+  width = Trunc(Max(width, 1.0f));
+  const double delta =
+      (double)width - (double)TableVirtualColumnsGetWidth(columns, column_n);
+  columns->Widths.Data[column_n] = width;
+  if (delta == 0.0)
+    return;
+  for (int n = column_n + 1; n <= columns->ColumnsCount; n += (n & -n))
+    columns->Tree.Data[n] += delta;
+}
+
+// 'spacing' is added once per column (padding and spacing between columns)
+double Gui::TableVirtualColumnsGetOffset(const TableVirtualColumns *columns,
+                                         int column_n, double spacing) {
+  column_n = Min(column_n, columns->ColumnsCount);
+  double offset = column_n * spacing;
+  for (int n = column_n; n > 0; n -= (n & -n))
+    offset += columns->Tree.Data[n];
+  return offset;
+}
+
+// Binary search down the Fenwick tree. Each visited node covers 'step'
+// columns, so their spacing can be added on the way. Return ColumnsCount when
+// 'offset' is past the last column.
+int Gui::TableVirtualColumnsFindColumn(const TableVirtualColumns *columns,
+                                       double offset, double spacing) {
+  int column_n = 0;
+  int step = 1;
+  while (step * 2 <= columns->ColumnsCount)
+    step *= 2;
+  for (; step > 0; step >>= 1)
+    if (column_n + step <= columns->ColumnsCount) {
+      const double width = columns->Tree.Data[column_n + step] + step * spacing;
+      if (width <= offset) {
+        column_n += step;
+        offset -= width;
+      }
+    }
+  return column_n;
+}
+
+// Change the number of slots before layout, preserving regular columns
+static void TableResizeVirtualSlots(Table *table, int slots_count) {
+  TableVirtualColumns *virtual_columns = &table->VirtualColumns;
+  const int old_columns_count = table->ColumnsCount;
+  const int columns_count = virtual_columns->SlotsFirst + slots_count;
+  TableColumn *old_columns = table->Columns.Data;
+  TableColumnIdx *old_display_order_to_index = table->DisplayOrderToIndex.Data;
+  void *old_raw_data = table->RawData;
+  Gui::TableBeginInitMemory(table, columns_count);
+  for (int n = 0; n < columns_count; n++) {
+    TableColumn *column = &table->Columns[n];
+    if (n < old_columns_count) {
+      *column = old_columns[n];
+    } else {
+      *column = TableColumn();
+      column->IsEnabled = column->IsUserEnabled =
+          column->IsUserEnabledNextFrame = true;
+      column->DisplayOrder = (TableColumnIdx)n;
+    }
+    table->DisplayOrderToIndex[n] = (n < virtual_columns->SlotsFirst)
+                                        ? old_display_order_to_index[n]
+                                        : (TableColumnIdx)n;
+  }
+  FREE(old_raw_data);
+  table->ColumnsCount = columns_count;
+  virtual_columns->SlotsCount = slots_count;
+}
+
+// [Public]
+void Gui::TableSetupVirtualColumns(int columns_count, float default_width,
+                                   int flags) {
+  Context &g = *GGui;
+  Table *table = g.CurrentTable;
+  assert(table != NULL &&
+         "Need to call TableSetupVirtualColumns() after BeginTable()!");
+  assert(table->IsLayoutLocked == false &&
+         "Need to call TableSetupVirtualColumns() before first row!");
+  assert((table->Flags & TableFlags_VirtualColumns) &&
+         "Need to pass TableFlags_VirtualColumns and TableFlags_ScrollX to "
+         "BeginTable()!");
+  assert(columns_count >= 0 && default_width > 0.0f);
+  assert((flags & TableColumnFlags_StatusMask_) == 0 &&
+         "Illegal to pass StatusMask values to TableSetupVirtualColumns()");
+  TableVirtualColumns *virtual_columns = &table->VirtualColumns;
+  assert(!virtual_columns->IsSetup &&
+         table->DeclColumnsCount <= virtual_columns->SlotsFirst &&
+         "Need to call TableSetupVirtualColumns() once, after "
+         "TableSetupColumn()!");
+
+  // Report width changes of slots since the previous frame (resizing or
+  // auto-fitting) to the logical column they were mapped to.
+  if (virtual_columns->IsMapped)
+    for (int n = virtual_columns->DisplayStart;
+         n < Min(virtual_columns->DisplayEnd, virtual_columns->ColumnsCount);
+         n++) {
+      const TableColumn *column =
+          &table->Columns[virtual_columns->SlotsFirst + n -
+                          virtual_columns->DisplayStart];
+      if (column->WidthRequest > 0.0f &&
+          column->WidthRequest !=
+              TableVirtualColumnsGetWidth(virtual_columns, n))
+        TableVirtualColumnsSetWidth(virtual_columns, n, column->WidthRequest);
+    }
+  TableVirtualColumnsSetup(virtual_columns, columns_count, default_width);
+
+  // Find logical columns in sight from the position of the first logical
+  // column measured by the previous layout (columns hidden by frozen columns
+  // are included, they will be clipped)
+  const double spacing = table->CellSpacingX1 + table->CellSpacingX2 +
+                         table->CellPaddingX * 2.0f;
+  const double x0 =
+      (double)table->WorkRect.Min.x + (double)virtual_columns->OffsetX;
+  const int display_start = TableVirtualColumnsFindColumn(
+      virtual_columns, table->InnerClipRect.Min.x - x0, spacing);
+  int display_end = Min(TableVirtualColumnsFindColumn(
+                            virtual_columns, table->InnerClipRect.Max.x - x0,
+                            spacing) +
+                            1,
+                        columns_count);
+
+  // Allocate slots, with a margin to avoid reallocating while scrolling
+  const int slots_max = TABLE_MAX_COLUMNS - 1 - virtual_columns->SlotsFirst;
+  display_end = display_start + Min(display_end - display_start, slots_max);
+  const int slots_needed = display_end - display_start;
+  if (slots_needed > virtual_columns->SlotsCount ||
+      slots_needed * 2 + 8 < virtual_columns->SlotsCount)
+    TableResizeVirtualSlots(table, Min(slots_needed + 4, slots_max));
+  virtual_columns->DisplayStart = display_start;
+  virtual_columns->DisplayEnd = display_end;
+
+  // Declare slots after regular columns. Unused slots are disabled.
+  while (table->DeclColumnsCount < virtual_columns->SlotsFirst)
+    TableSetupColumn(NULL);
+  flags = (flags & ~TableColumnFlags_WidthMask_) | TableColumnFlags_WidthFixed |
+          TableColumnFlags_NoReorder | TableColumnFlags_NoHide |
+          TableColumnFlags_NoSort;
+  for (int slot_n = 0; slot_n < virtual_columns->SlotsCount; slot_n++) {
+    const int virtual_column_n = display_start + slot_n;
+    const bool is_mapped = virtual_column_n < display_end;
+    const float width =
+        is_mapped ? TableVirtualColumnsGetWidth(virtual_columns, virtual_column_n)
+                  : virtual_columns->DefaultWidth;
+    TableSetupColumn(NULL, is_mapped ? flags : flags | TableColumnFlags_Disabled,
+                     width);
+    table->Columns[virtual_columns->SlotsFirst + slot_n].WidthRequest = width;
+  }
+  virtual_columns->IsSetup = virtual_columns->IsMapped = true;
+}
+
+void Gui::TableGetVirtualColumnsRange(int *out_display_start,
+                                      int *out_display_end) {
+  Context &g = *GGui;
+  Table *table = g.CurrentTable;
+  assert(table != NULL && table->VirtualColumns.IsSetup &&
+         "Need to call TableSetupVirtualColumns() first!");
+  *out_display_start = table->VirtualColumns.DisplayStart;
+  *out_display_end = table->VirtualColumns.DisplayEnd;
+}
+
+bool Gui::TableSetVirtualColumnIndex(int virtual_column_n) {
+  Context &g = *GGui;
+  Table *table = g.CurrentTable;
+  assert(table != NULL && table->VirtualColumns.IsSetup &&
+         "Need to call TableSetupVirtualColumns() first!");
+  const TableVirtualColumns *virtual_columns = &table->VirtualColumns;
+  assert(virtual_column_n >= virtual_columns->DisplayStart &&
+         virtual_column_n < virtual_columns->DisplayEnd &&
+         "Column is not in sight, see TableGetVirtualColumnsRange()!");
+  return TableSetColumnIndex(virtual_columns->SlotsFirst + virtual_column_n -
+                             virtual_columns->DisplayStart);
+}
+
+float Gui::TableGetVirtualColumnWidth(int virtual_column_n) {
+  Context &g = *GGui;
+  Table *table = g.CurrentTable;
+  assert(table != NULL);
+  assert(virtual_column_n >= 0 &&
+         virtual_column_n < table->VirtualColumns.ColumnsCount);
+  return TableVirtualColumnsGetWidth(&table->VirtualColumns, virtual_column_n);
+}
+
+// Request will be applied during next layout if the column is in sight
+void Gui::TableSetVirtualColumnWidth(int virtual_column_n, float width) {
+  Context &g = *GGui;
+  Table *table = g.CurrentTable;
+  assert(table != NULL);
+  TableVirtualColumns *virtual_columns = &table->VirtualColumns;
+  TableVirtualColumnsSetWidth(virtual_columns, virtual_column_n, width);
+
+  // Update its slot, which would otherwise report its width back. Layout
+  // resets non-resizable slots to their init width, so update it too.
+  if (virtual_columns->IsMapped &&
+      virtual_column_n >= virtual_columns->DisplayStart &&
+      virtual_column_n < virtual_columns->DisplayEnd) {
+    TableColumn *column =
+        &table->Columns[virtual_columns->SlotsFirst + virtual_column_n -
+                        virtual_columns->DisplayStart];
+    column->WidthRequest = column->InitStretchWeightOrWidth =
+        TableVirtualColumnsGetWidth(virtual_columns, virtual_column_n);
+  }
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] Tables: Columns changes
 //-------------------------------------------------------------------------
@@ -3594,6 +4286,7 @@ void Gui::TableSortSpecsBuild(Table *table) {
         table->SortSpecsCount <= 1 ? 0 : table->SortSpecsCount);
     table->SortSpecs.SpecsDirty = true; // Mark as dirty for user
     table->IsSortSpecsDirty = false;    // Mark as not dirty for us
+    table->RowHeights.IsOrderDirty = true; // User is going to reorder rows
   }
 
   // Write output
@@ -4173,7 +4866,10 @@ void Gui::TableDrawDefaultContextMenu(Table *table,
     want_separator = true;
 
     PushItemFlag(ItemFlags_SelectableDontClosePopup, true);
-    for (int other_column_n = 0; other_column_n < table->ColumnsCount;
+    const int columns_count = (table->Flags & TableFlags_VirtualColumns)
+                                  ? table->VirtualColumns.SlotsFirst
+                                  : table->ColumnsCount;
+    for (int other_column_n = 0; other_column_n < columns_count;
          other_column_n++) {
       TableColumn *other_column = &table->Columns[other_column_n];
       if (other_column->Flags & TableColumnFlags_Disabled)
@@ -4380,6 +5076,12 @@ void Gui::TableLoadSettings(Table *table) {
     int column_n = column_settings->Index;
     if (column_n < 0 || column_n >= table->ColumnsCount)
       continue;
+    if ((table->Flags & TableFlags_VirtualColumns) &&
+        column_n >= table->VirtualColumns.SlotsFirst) {
+      // Slots are setup by TableSetupVirtualColumns() and keep their order
+      display_order_mask |= (unsigned long long)1 << column_n;
+      continue;
+    }
 
     TableColumn *column = &table->Columns[column_n];
     if (settings->SaveFlags & TableFlags_Resizable) {
@@ -4608,6 +5310,10 @@ void Gui::TableGcCompactTransientBuffers(Table *table) {
   table->IsSortSpecsDirty = true; // FIXME: In theory shouldn't have to leak
                                   // into user performing a sort on resume.
   table->ColumnsNames.clear();
+  table->RowHeights.ItemsHeight.clear();
+  table->RowHeights.Tree.clear();
+  table->RowHeights.Ranges.clear();
+  table->RowHeights.RowsCount = 0;
   table->MemoryCompacted = true;
   for (int n = 0; n < table->ColumnsCount; n++)
     table->Columns[n].NameOffset = -1;
@@ -4709,6 +5415,13 @@ void Gui::DebugNodeTable(Table *table) {
   BulletText("ResizedColumn: %d, ReorderColumn: %d, HeldHeaderColumn: %d",
              table->ResizedColumn, table->ReorderColumn,
              table->HeldHeaderColumn);
+  if (table->Flags & TableFlags_VirtualColumns)
+    BulletText("VirtualColumns: %d, Display: %d..%d, Slots: %d (from %d)",
+               table->VirtualColumns.ColumnsCount,
+               table->VirtualColumns.DisplayStart,
+               table->VirtualColumns.DisplayEnd,
+               table->VirtualColumns.SlotsCount,
+               table->VirtualColumns.SlotsFirst);
   for (int n = 0; n < table->InstanceCurrent + 1; n++) {
     TableInstanceData *table_instance = TableGetInstanceData(table, n);
     BulletText("Instance %d: HoveredRow: %d, LastOuterHeight: %.2f", n,
@@ -793,12 +793,19 @@ bool Gui::ButtonBehavior(const Rect &bb, int id, bool *out_hovered,
 
 bool Gui::ButtonEx(const char *label, const Vec2 &size_arg, int flags) {
   Window *window = GetCurrentWindow();
+  if (window->SkipItems)
+    return false;
+  return ButtonEx(label, window->GetID(label), size_arg, flags);
+}
+
+bool Gui::ButtonEx(const char *label, int id, const Vec2 &size_arg,
+                   int flags) {
+  Window *window = GetCurrentWindow();
   if (window->SkipItems)
     return false;
 
   Context &g = *GGui;
   const Style &style = g.Style;
-  const int id = window->GetID(label);
   const Vec2 label_size = CalcTextSize(label, NULL, true);
 
   Vec2 pos = window->DC.CursorPos;
@@ -856,6 +863,26 @@ bool Gui::SmallButton(const char *label) {
   return pressed;
 }
 
+bool Gui::Button(const StrID &label, const Vec2 &size_arg) {
+  Window *window = GetCurrentWindow();
+  if (window->SkipItems)
+    return false;
+  return ButtonEx(label.Str, window->GetID(label), size_arg, ButtonFlags_None);
+}
+
+bool Gui::SmallButton(const StrID &label) {
+  Window *window = GetCurrentWindow();
+  if (window->SkipItems)
+    return false;
+  Context &g = *GGui;
+  float backup_padding_y = g.Style.FramePadding.y;
+  g.Style.FramePadding.y = 0.0f;
+  bool pressed = ButtonEx(label.Str, window->GetID(label), Vec2(0, 0),
+                          ButtonFlags_AlignTextBaseLine);
+  g.Style.FramePadding.y = backup_padding_y;
+  return pressed;
+}
+
 // Tip: use Gui::PushID()/PopID() to push indices or pointers in the int stack.
 // Then you can keep 'str_id' empty or the same for all your buttons (instead of
 // creating a string based on a non-string id)
@@ -1307,13 +1334,26 @@ bool Gui::ImageButton(TextureID user_texture_id, const Vec2 &size,
 #endif // #ifndef DISABLE_OBSOLETE_FUNCTIONS
 
 bool Gui::Checkbox(const char *label, bool *v) {
+  Window *window = GetCurrentWindow();
+  if (window->SkipItems)
+    return false;
+  return CheckboxEx(label, window->GetID(label), v);
+}
+
+bool Gui::Checkbox(const StrID &label, bool *v) {
+  Window *window = GetCurrentWindow();
+  if (window->SkipItems)
+    return false;
+  return CheckboxEx(label.Str, window->GetID(label), v);
+}
+
+bool Gui::CheckboxEx(const char *label, int id, bool *v) {
   Window *window = GetCurrentWindow();
   if (window->SkipItems)
     return false;
 
   Context &g = *GGui;
   const Style &style = g.Style;
-  const int id = window->GetID(label);
   const Vec2 label_size = CalcTextSize(label, NULL, true);
 
   const float square_sz = GetFrameHeight();
@@ -2375,8 +2415,407 @@ const DataTypeInfo *Gui::DataTypeGetInfo(int data_type) {
   return &GDataTypeInfo[data_type];
 }
 
+// Fast path for DataTypeFormatString() and DataTypeApplyFromText()
+// Widgets format every visible value every frame, so we handle the common
+// formats ("%d", "%u", "%lld", "%.3f", "%g", with '-+ 0' flags, width,
+// precision and surrounding text) without going through vsnprintf(), and
+// parse plain decimal numbers without sscanf(). Output and parsed values are
+// identical: a value is scaled to an integer with a single rounded operation,
+// which is only trusted when the result isn't close to a rounding tie.
+// Anything else (other specifiers, '#' flag, large values, ties, NaN/Inf,
+// hexadecimal input...) falls back to FormatString() and sscanf().
+#if defined(DISABLE_DEFAULT_FORMAT_FUNCTIONS) &&                              \
+    !defined(DISABLE_FAST_DATATYPE_FORMAT)
+#define DISABLE_FAST_DATATYPE_FORMAT // Don't bypass user's FormatString()
+#endif
+#ifndef DISABLE_FAST_DATATYPE_FORMAT
+
+static const double GPow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+static const float GPow10f[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f,
+                                1e6f, 1e7f, 1e8f, 1e9f, 1e10f}; // Exact
+static const unsigned long long GPow10Int[] = {
+    1ull,          10ull,          100ull,          1000ull,
+    10000ull,      100000ull,      1000000ull,      10000000ull,
+    100000000ull,  1000000000ull,  10000000000ull,  100000000000ull,
+    1000000000000ull};
+
+// Distance to 0.5 below which we don't trust the rounding of a scaled value.
+// Scaled values are < 2^32 so their rounding error is at most 2^-21.
+static const double DATATYPE_FAST_TIE_MARGIN = 1.0 / (1 << 18);
+
+struct DataTypeFastSpec {
+  bool LeftAlign; // '-' flag
+  bool ZeroPad;   // '0' flag
+  char SignChar;  // 0, '+' or ' ' flags
+  int Width;
+  int Precision;  // -1 if not specified
+  char LengthMod; // 0, 'l' or 'L' ("ll"/"I64")
+  char Conv;      // 'd', 'i', 'u', 'f', 'F', 'g' or 'G'
+};
+
+// Parse the specifier following a '%'. Return NULL if unsupported.
+static const char *DataTypeFastParseSpec(const char *p,
+                                         DataTypeFastSpec *spec) {
+  memset(spec, 0, sizeof(*spec));
+  spec->Precision = -1;
+  for (;; p++) {
+    if (*p == '-')
+      spec->LeftAlign = true;
+    else if (*p == '+')
+      spec->SignChar = '+';
+    else if (*p == ' ')
+      spec->SignChar = (spec->SignChar == '+') ? '+' : ' ';
+    else if (*p == '0')
+      spec->ZeroPad = true;
+    else
+      break;
+  }
+  for (; *p >= '0' && *p <= '9'; p++)
+    if ((spec->Width = spec->Width * 10 + (*p - '0')) > 32)
+      return NULL;
+  if (*p == '.') {
+    spec->Precision = 0;
+    for (p++; *p >= '0' && *p <= '9'; p++)
+      if ((spec->Precision = spec->Precision * 10 + (*p - '0')) > 32)
+        return NULL;
+  }
+  if (p[0] == 'l' && p[1] == 'l')
+    spec->LengthMod = 'L', p += 2;
+  else if (p[0] == 'I' && p[1] == '6' && p[2] == '4')
+    spec->LengthMod = 'L', p += 3;
+  else if (p[0] == 'l')
+    spec->LengthMod = 'l', p++;
+  if (*p == 0 || strchr("diufFgG", *p) == NULL)
+    return NULL;
+  spec->Conv = *p;
+  return p + 1;
+}
+
+// Write 'v' with at least 'min_digits' digits, ending at 'end'. Return start.
+static char *DataTypeFastWriteUInt(char *end, unsigned long long v,
+                                   int min_digits) {
+  do {
+    *--end = (char)('0' + (int)(v % 10));
+    v /= 10;
+    min_digits--;
+  } while (v != 0 || min_digits > 0);
+  return end;
+}
+
+// Write 'v' / 10^decimals in fixed notation, ending at 'end'. Return start.
+static char *DataTypeFastWriteFixed(char *end, unsigned long long v,
+                                    int decimals) {
+  if (decimals > 0) {
+    end = DataTypeFastWriteUInt(end, v % GPow10Int[decimals], decimals);
+    *--end = '.';
+    v /= GPow10Int[decimals];
+  }
+  return DataTypeFastWriteUInt(end, v, 1);
+}
+
+// Round 'scaled' (a positive value < 2^32) to the nearest integer, or return
+// false if it is too close to a tie to be sure of the printf() rounding.
+static bool DataTypeFastRound(double scaled, unsigned long long *out) {
+  if (!(scaled < 4294967296.0))
+    return false;
+  const unsigned long long int_part = (unsigned long long)scaled;
+  const double frac = scaled - (double)int_part;
+  if (frac > 0.5 - DATATYPE_FAST_TIE_MARGIN &&
+      frac < 0.5 + DATATYPE_FAST_TIE_MARGIN)
+    return false;
+  *out = int_part + (frac > 0.5 ? 1 : 0);
+  return true;
+}
+
+// "%.Nf": 'abs_v' rounded to 'precision' decimals
+static char *DataTypeFastWriteF(char *end, double abs_v, int precision) {
+  if (precision < 0)
+    precision = 6;
+  unsigned long long v;
+  if (precision > 9 || !DataTypeFastRound(abs_v * GPow10[precision], &v))
+    return NULL;
+  return DataTypeFastWriteFixed(end, v, precision);
+}
+
+// "%.Ng": 'abs_v' rounded to 'precision' significant digits, in fixed or
+// exponent notation depending on its exponent, without trailing zeros.
+static char *DataTypeFastWriteG(char *end, double abs_v, int precision,
+                                bool upper) {
+  if (precision < 0)
+    precision = 6;
+  if (precision == 0)
+    precision = 1;
+  if (precision > 9)
+    return NULL;
+  if (abs_v == 0.0) {
+    *--end = '0';
+    return end;
+  }
+
+  // Estimate the decimal exponent, then fix it up after rounding
+  int exponent = 0;
+  if (abs_v >= 1.0)
+    while (exponent < 22 && GPow10[exponent + 1] <= abs_v)
+      exponent++;
+  else
+    while (exponent > -22 && abs_v * GPow10[-exponent] < 1.0)
+      exponent--;
+  unsigned long long v = 0;
+  bool rounded = false;
+  for (int attempt = 0; attempt < 3 && !rounded; attempt++) {
+    const int scale = precision - 1 - exponent;
+    if (scale < -22 || scale > 22)
+      return NULL;
+    const double scaled =
+        (scale >= 0) ? abs_v * GPow10[scale] : abs_v / GPow10[-scale];
+    if (!DataTypeFastRound(scaled, &v))
+      return NULL;
+    if (scaled < (double)GPow10Int[precision - 1])
+      exponent--;
+    else if (v >= GPow10Int[precision])
+      exponent++;
+    else
+      rounded = true;
+  }
+  if (!rounded)
+    return NULL;
+
+  int digits = precision;
+  while (digits > 1 && v % 10 == 0)
+    v /= 10, digits--;
+  if (exponent >= -4 && exponent < precision) {
+    int decimals = digits - 1 - exponent;
+    for (; decimals < 0; decimals++)
+      v *= 10;
+    return DataTypeFastWriteFixed(end, v, decimals);
+  }
+  end = DataTypeFastWriteUInt(end, (unsigned long long)Abs(exponent), 2);
+  *--end = (exponent < 0) ? '-' : '+';
+  *--end = upper ? 'E' : 'e';
+  return DataTypeFastWriteFixed(end, v, digits - 1);
+}
+
+// Format the value with 'spec' into 'out'. Return length, or -1.
+static int DataTypeFastFormatValue(char *out, int out_size,
+                                   const DataTypeFastSpec &spec,
+                                   int data_type, const void *p_data) {
+  char digits[64];
+  char *end = digits + ARRAYSIZE(digits);
+  char *start = NULL;
+  bool negative = false;
+  const bool is_int = (spec.Conv == 'd' || spec.Conv == 'i' ||
+                       spec.Conv == 'u');
+  if (data_type == DataType_Float || data_type == DataType_Double) {
+    if (is_int || spec.LengthMod == 'L')
+      return -1;
+    double v = (data_type == DataType_Float) ? (double)*(const float *)p_data
+                                             : *(const double *)p_data;
+    unsigned long long bits;
+    memcpy(&bits, &v, sizeof(bits));
+    negative = (bits >> 63) != 0; // Also true for -0.0, like printf()
+    const double abs_v = negative ? -v : v;
+    if (abs_v - abs_v != 0.0) // NaN, Inf
+      return -1;
+    if (spec.Conv == 'f' || spec.Conv == 'F')
+      start = DataTypeFastWriteF(end, abs_v, spec.Precision);
+    else
+      start = DataTypeFastWriteG(end, abs_v, spec.Precision, spec.Conv == 'G');
+    if (start == NULL)
+      return -1;
+  } else {
+    // Same arguments as DataTypeFormatString() passes to FormatString()
+    const bool is_64 = (data_type == DataType_S64 || data_type == DataType_U64);
+    if (!is_int || spec.Precision >= 0 || spec.LengthMod != (is_64 ? 'L' : 0))
+      return -1;
+    unsigned long long v;
+    if (is_64) {
+      v = *(const unsigned long long *)p_data;
+      if (spec.Conv != 'u' && (long long)v < 0)
+        negative = true, v = 0 - v;
+    } else {
+      unsigned int v32;
+      if (data_type == DataType_S8)
+        v32 = (unsigned int)*(const signed char *)p_data;
+      else if (data_type == DataType_U8)
+        v32 = *(const unsigned char *)p_data;
+      else if (data_type == DataType_S16)
+        v32 = (unsigned int)*(const signed short *)p_data;
+      else if (data_type == DataType_U16)
+        v32 = *(const unsigned short *)p_data;
+      else
+        v32 = *(const unsigned int *)p_data;
+      if (spec.Conv != 'u' && (int)v32 < 0)
+        negative = true, v32 = 0 - v32;
+      v = v32;
+    }
+    start = DataTypeFastWriteUInt(end, v, 1);
+  }
+
+  const char sign_char =
+      negative ? '-' : (spec.Conv == 'u') ? (char)0 : spec.SignChar;
+  const int body_len = (int)(end - start);
+  const int len = body_len + (sign_char ? 1 : 0);
+  const int pad = Max(spec.Width - len, 0);
+  if (len + pad > out_size)
+    return -1;
+  char *p = out;
+  if (!spec.LeftAlign && !spec.ZeroPad)
+    for (int n = 0; n < pad; n++)
+      *p++ = ' ';
+  if (sign_char)
+    *p++ = sign_char;
+  if (!spec.LeftAlign && spec.ZeroPad)
+    for (int n = 0; n < pad; n++)
+      *p++ = '0';
+  memcpy(p, start, (size_t)body_len);
+  p += body_len;
+  if (spec.LeftAlign)
+    for (int n = 0; n < pad; n++)
+      *p++ = ' ';
+  return (int)(p - out);
+}
+
+// Return the length written to 'buf' like FormatString(), or -1 if the format
+// isn't supported.
+static int DataTypeFormatStringFast(char *buf, int buf_size, int data_type,
+                                    const void *p_data, const char *fmt) {
+  char out[64];
+  int out_len = 0;
+  bool has_spec = false;
+  while (*fmt) {
+    if (fmt[0] != '%' || fmt[1] == '%') {
+      if (out_len == ARRAYSIZE(out))
+        return -1;
+      out[out_len++] = *fmt;
+      fmt += (fmt[0] == '%') ? 2 : 1;
+      continue;
+    }
+    DataTypeFastSpec spec;
+    if (has_spec || (fmt = DataTypeFastParseSpec(fmt + 1, &spec)) == NULL)
+      return -1;
+    has_spec = true;
+    const int len = DataTypeFastFormatValue(
+        out + out_len, ARRAYSIZE(out) - out_len, spec, data_type, p_data);
+    if (len < 0)
+      return -1;
+    out_len += len;
+  }
+  if (buf_size <= 0)
+    return -1;
+  const int w = Min(out_len, buf_size - 1);
+  memcpy(buf, out, (size_t)w);
+  buf[w] = 0;
+  return w;
+}
+
+// Parse 'buf' like sscanf(buf, format, p_dest) when 'format' is the default
+// scan format of 'data_type', for plain decimal numbers which can be converted
+// exactly. Return false if the text must be parsed by sscanf().
+static bool DataTypeApplyFromTextFast(const char *buf, int data_type,
+                                      const char *format, void *p_dest) {
+  if (strcmp(format, Gui::DataTypeGetInfo(data_type)->ScanFmt) != 0)
+    return false;
+  const char *p = buf;
+  bool negative = false;
+  if (*p == '-' || *p == '+')
+    negative = (*p++ == '-');
+  if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+    return false;
+
+  if (data_type == DataType_Float || data_type == DataType_Double) {
+    // Up to 19 significant digits in 'mantissa', value = mantissa * 10^exp
+    unsigned long long mantissa = 0;
+    int significant_digits = 0, exp = 0;
+    bool has_digits = false, in_fraction = false;
+    for (;; p++) {
+      if (*p == '.' && !in_fraction) {
+        in_fraction = true;
+        continue;
+      }
+      if (*p < '0' || *p > '9')
+        break;
+      has_digits = true;
+      if (mantissa == 0 && *p == '0') {
+        exp -= in_fraction ? 1 : 0;
+        continue;
+      }
+      if (++significant_digits > 19)
+        return false;
+      mantissa = mantissa * 10 + (unsigned long long)(*p - '0');
+      exp -= in_fraction ? 1 : 0;
+    }
+    if (!has_digits)
+      return false; // "inf", "nan"...
+    if ((p[0] == 'e' || p[0] == 'E')) {
+      const char *q = p + 1;
+      bool exp_negative = false;
+      if (*q == '-' || *q == '+')
+        exp_negative = (*q++ == '-');
+      int exp_value = 0;
+      for (; *q >= '0' && *q <= '9'; q++)
+        exp_value = Min(exp_value * 10 + (*q - '0'), 10000);
+      exp += exp_negative ? -exp_value : exp_value;
+    }
+    // One correctly rounded operation between exact values (Clinger's fast
+    // path): same result as strtod()/strtof().
+    if (data_type == DataType_Float) {
+      float v = 0.0f;
+      if (mantissa != 0) {
+        if (mantissa > (1ull << 24) || exp < -10 || exp > 10)
+          return false;
+        v = (exp < 0) ? (float)mantissa / GPow10f[-exp]
+                      : (float)mantissa * GPow10f[exp];
+      }
+      *(float *)p_dest = negative ? -v : v;
+    } else {
+      double v = 0.0;
+      if (mantissa != 0) {
+        if (mantissa > (1ull << 53) || exp < -22 || exp > 22)
+          return false;
+        v = (exp < 0) ? (double)mantissa / GPow10[-exp]
+                      : (double)mantissa * GPow10[exp];
+      }
+      *(double *)p_dest = negative ? -v : v;
+    }
+    return true;
+  }
+
+  // Integers. Leave overflows and negative unsigned values to sscanf().
+  const bool is_unsigned =
+      (data_type == DataType_U8 || data_type == DataType_U16 ||
+       data_type == DataType_U32 || data_type == DataType_U64);
+  const bool is_64 = (data_type == DataType_S64 || data_type == DataType_U64);
+  if ((negative && is_unsigned) || *p < '0' || *p > '9')
+    return false;
+  const unsigned long long limit =
+      is_64 ? (is_unsigned ? U64_MAX : (unsigned long long)S64_MAX)
+            : (is_unsigned ? U32_MAX : (unsigned int)S32_MAX);
+  unsigned long long v = 0;
+  for (; *p >= '0' && *p <= '9'; p++) {
+    const unsigned int digit = (unsigned int)(*p - '0');
+    if (v > (limit - digit) / 10)
+      return false;
+    v = v * 10 + digit;
+  }
+  if (is_64)
+    *(unsigned long long *)p_dest = negative ? 0 - v : v;
+  else
+    *(unsigned int *)p_dest = negative ? 0 - (unsigned int)v : (unsigned int)v;
+  return true;
+}
+
+#endif // #ifndef DISABLE_FAST_DATATYPE_FORMAT
+
 int Gui::DataTypeFormatString(char *buf, int buf_size, int data_type,
                               const void *p_data, const char *format) {
+#ifndef DISABLE_FAST_DATATYPE_FORMAT
+  const int fast_len =
+      DataTypeFormatStringFast(buf, buf_size, data_type, p_data, format);
+  if (fast_len >= 0)
+    return fast_len;
+#endif
   // Signedness doesn't matter when pushing integer arguments
   if (data_type == DataType_S32 || data_type == DataType_U32)
     return FormatString(buf, buf_size, format, *(const unsigned int *)p_data);
@@ -2552,8 +2991,12 @@ bool Gui::DataTypeApplyFromText(const char *buf, int data_type, void *p_data,
 
   // Small types need a 32-bit buffer to receive the result from scanf()
   int v32 = 0;
-  if (sscanf(buf, format, type_info->Size >= 4 ? p_data : &v32) < 1)
-    return false;
+  void *p_dest = type_info->Size >= 4 ? p_data : &v32;
+#ifndef DISABLE_FAST_DATATYPE_FORMAT
+  if (!DataTypeApplyFromTextFast(buf, data_type, format, p_dest))
+#endif
+    if (sscanf(buf, format, p_dest) < 1)
+      return false;
   if (type_info->Size < 4) {
     if (data_type == DataType_S8)
       *(signed char *)p_data =
@@ -4608,7 +5051,7 @@ static float TEXTEDIT_GETWIDTH(InputTextState *obj, int line_start_idx,
   return g.Font->GetCharAdvance(c) * (g.FontSize / g.Font->FontSize);
 }
 static int TEXTEDIT_KEYTOTEXT(int key) { return key >= 0x200000 ? 0 : key; }
-static Wchar TEXTEDIT_NEWLINE = '\n';
+static const Wchar TEXTEDIT_NEWLINE = '\n';
 static void TEXTEDIT_LAYOUTROW(StbTexteditRow *r, InputTextState *obj,
                                int line_start_idx) {
   const Wchar *text = obj->TextW.Data;
@@ -5641,11 +6084,10 @@ bool Gui::InputTextEx(const char *label, const char *hint, char *buf,
             TextCountUtf8BytesFromStr(state->TextW.Data + ib,
                                       state->TextW.Data + ie) +
             1;
-        char *clipboard_data = (char *)ALLOC(clipboard_data_len * sizeof(char));
+        char *clipboard_data = FrameAllocArray<char>(clipboard_data_len);
         TextStrToUtf8(clipboard_data, clipboard_data_len,
                       state->TextW.Data + ib, state->TextW.Data + ie);
         SetClipboardText(clipboard_data);
-        MemFree(clipboard_data);
       }
       if (is_cut) {
         if (!state->HasSelection())
@@ -5657,8 +6099,7 @@ bool Gui::InputTextEx(const char *label, const char *hint, char *buf,
       if (const char *clipboard = GetClipboardText()) {
         // Filter pasted buffer
         const int clipboard_len = (int)strlen(clipboard);
-        Wchar *clipboard_filtered =
-            (Wchar *)ALLOC((clipboard_len + 1) * sizeof(Wchar));
+        Wchar *clipboard_filtered = FrameAllocArray<Wchar>(clipboard_len + 1);
         int clipboard_filtered_len = 0;
         for (const char *s = clipboard; *s != 0;) {
           unsigned int c;
@@ -5677,7 +6118,6 @@ bool Gui::InputTextEx(const char *label, const char *hint, char *buf,
                          clipboard_filtered_len);
           state->CursorFollow = true;
         }
-        MemFree(clipboard_filtered);
       }
     }
 
@@ -7409,6 +7849,11 @@ void Gui::ColorPickerOptionsPopup(const float *ref_col, int flags) {
 // - GetTreeNodeToLabelSpacing()
 // - SetNextItemOpen()
 // - CollapsingHeader()
+// - TreeClipper::Begin()
+// - TreeClipper::End()
+// - TreeClipper::Step()
+// - TreeClipper::TreeNode()
+// - TreeClipper::SetRowOpen()
 //-------------------------------------------------------------------------
 
 bool Gui::TreeNode(const char *str_id, const char *fmt, ...) {
@@ -7434,6 +7879,13 @@ bool Gui::TreeNode(const char *label) {
   return TreeNodeBehavior(window->GetID(label), 0, label, NULL);
 }
 
+bool Gui::TreeNode(const StrID &label) {
+  Window *window = GetCurrentWindow();
+  if (window->SkipItems)
+    return false;
+  return TreeNodeBehavior(window->GetID(label), 0, label.Str, NULL);
+}
+
 bool Gui::TreeNodeV(const char *str_id, const char *fmt, va_list args) {
   return TreeNodeExV(str_id, 0, fmt, args);
 }
@@ -7450,6 +7902,14 @@ bool Gui::TreeNodeEx(const char *label, int flags) {
   return TreeNodeBehavior(window->GetID(label), flags, label, NULL);
 }
 
+bool Gui::TreeNodeEx(const StrID &label, int flags) {
+  Window *window = GetCurrentWindow();
+  if (window->SkipItems)
+    return false;
+
+  return TreeNodeBehavior(window->GetID(label), flags, label.Str, NULL);
+}
+
 bool Gui::TreeNodeEx(const char *str_id, int flags, const char *fmt, ...) {
   va_list args;
   va_start(args, fmt);
@@ -7915,6 +8375,15 @@ bool Gui::CollapsingHeader(const char *label, int flags) {
                           flags | TreeNodeFlags_CollapsingHeader, label);
 }
 
+bool Gui::CollapsingHeader(const StrID &label, int flags) {
+  Window *window = GetCurrentWindow();
+  if (window->SkipItems)
+    return false;
+
+  return TreeNodeBehavior(window->GetID(label),
+                          flags | TreeNodeFlags_CollapsingHeader, label.Str);
+}
+
 // p_visible == NULL                        : regular collapsing header
 // p_visible != NULL && *p_visible == true  : show a small close button on the
 // corner of the header, clicking the button will set *p_visible = false
@@ -7929,7 +8398,22 @@ bool Gui::CollapsingHeader(const char *label, bool *p_visible, int flags) {
   if (p_visible && !*p_visible)
     return false;
 
-  int id = window->GetID(label);
+  return CollapsingHeaderEx(label, window->GetID(label), p_visible, flags);
+}
+
+bool Gui::CollapsingHeader(const StrID &label, bool *p_visible, int flags) {
+  Window *window = GetCurrentWindow();
+  if (window->SkipItems)
+    return false;
+
+  if (p_visible && !*p_visible)
+    return false;
+
+  return CollapsingHeaderEx(label.Str, window->GetID(label), p_visible, flags);
+}
+
+bool Gui::CollapsingHeaderEx(const char *label, int id, bool *p_visible,
+                             int flags) {
   flags |= TreeNodeFlags_CollapsingHeader;
   if (p_visible)
     flags |= TreeNodeFlags_AllowOverlap |
@@ -7957,6 +8441,181 @@ bool Gui::CollapsingHeader(const char *label, bool *p_visible, int flags) {
   return is_open;
 }
 
+// Append the expanded descendants of 'parent_node' to 'out', in display order.
+// Only open nodes are walked: the cost is the number of rows added.
+static void TreeClipper_AddDescendants(TreeClipper *clipper,
+                                       TreeClipperData *data, int parent_node,
+                                       int depth,
+                                       Vector<TreeClipperRow> &out) {
+  Storage *storage = clipper->Ctx->CurrentWindow->DC.StateStorage;
+  Vector<TreeClipperRow> &stack = data->TempStack;
+  stack.resize(0);
+  TreeClipperRow parent = {parent_node, depth - 1, 0, true};
+  parent.ChildrenCount =
+      clipper->GetChildrenCount(clipper->UserData, parent_node);
+  stack.push_back(parent);
+  while (stack.Size > 0) {
+    TreeClipperRow row = stack.back();
+    stack.pop_back();
+    if (row.Depth >= depth) {
+      row.ChildrenCount =
+          clipper->GetChildrenCount(clipper->UserData, row.Node);
+      row.Open = row.ChildrenCount > 0 &&
+                 storage->GetInt(Gui::GetIDWithSeed(row.Node, data->ID), 0);
+      out.push_back(row);
+      if (!row.Open)
+        continue;
+    }
+    // Push children in reverse order so they are popped in order.
+    for (int child_n = row.ChildrenCount - 1; child_n >= 0; child_n--) {
+      TreeClipperRow child = {
+          clipper->GetChild(clipper->UserData, row.Node, child_n),
+          row.Depth + 1, 0, false};
+      stack.push_back(child);
+    }
+  }
+}
+
+// Insert or remove the descendants of a row after its open state changed.
+static void TreeClipper_UpdateRowOpen(TreeClipper *clipper,
+                                      TreeClipperData *data, int row_n,
+                                      bool open) {
+  TreeClipperRow *row = &data->Rows[row_n];
+  if (row->Open == open || row->ChildrenCount == 0)
+    return;
+  row->Open = open;
+  if (open) {
+    data->TempRows.resize(0);
+    TreeClipper_AddDescendants(clipper, data, row->Node, row->Depth + 1,
+                               data->TempRows);
+    const int insert_count = data->TempRows.Size;
+    const int move_count = data->Rows.Size - (row_n + 1);
+    data->Rows.resize(data->Rows.Size + insert_count);
+    memmove(data->Rows.Data + row_n + 1 + insert_count,
+            data->Rows.Data + row_n + 1,
+            (size_t)move_count * sizeof(TreeClipperRow));
+    memcpy(data->Rows.Data + row_n + 1, data->TempRows.Data,
+           (size_t)insert_count * sizeof(TreeClipperRow));
+  } else {
+    const int depth = data->Rows[row_n].Depth;
+    int row_end = row_n + 1;
+    while (row_end < data->Rows.Size && data->Rows[row_end].Depth > depth)
+      row_end++;
+    data->Rows.erase(data->Rows.Data + row_n + 1, data->Rows.Data + row_end);
+  }
+  clipper->RowsCount = clipper->Clipper.ItemsCount = data->Rows.Size;
+  clipper->DisplayEnd = Min(clipper->DisplayEnd, clipper->RowsCount);
+}
+
+TreeClipper::TreeClipper() {
+  memset(this, 0, sizeof(*this));
+  TempDataIndex = -1;
+}
+
+TreeClipper::~TreeClipper() { End(); }
+
+void TreeClipper::Begin(const char *str_id,
+                        int (*get_children_count)(void *user_data, int node),
+                        int (*get_child)(void *user_data, int node,
+                                         int child_n),
+                        void *user_data, bool tree_changed,
+                        float rows_height) {
+  if (Ctx == NULL)
+    Ctx = Gui::GetCurrentContext();
+
+  Context &g = *Ctx;
+  Window *window = g.CurrentWindow;
+  assert(TempDataIndex == -1 && "Missing TreeClipper::End() ?");
+  const int id = window->GetID(str_id);
+  TreeClipperData *data = g.TreeClippers.GetOrAddByKey(id);
+  assert(!data->IsActive && "TreeClipper::Begin() called twice with the "
+                            "same id, or missing End() ?");
+  data->ID = id;
+  data->IsActive = true;
+  TempDataIndex = g.TreeClippers.GetIndex(data);
+  GetChildrenCount = get_children_count;
+  GetChild = get_child;
+  UserData = user_data;
+
+  // Build the rows from the roots: only open nodes are walked.
+  const int roots_count = GetChildrenCount(UserData, -1);
+  if (!data->IsBuilt || tree_changed || data->RootsCount != roots_count) {
+    data->Rows.resize(0);
+    TreeClipper_AddDescendants(this, data, -1, 0, data->Rows);
+    data->RootsCount = roots_count;
+    data->IsBuilt = true;
+  }
+  RowsCount = data->Rows.Size;
+  DisplayStart = DisplayEnd = 0;
+  Clipper.Begin(RowsCount, rows_height);
+}
+
+void TreeClipper::End() {
+  if (TempDataIndex == -1)
+    return;
+  Clipper.End();
+  Ctx->TreeClippers.GetByIndex(TempDataIndex)->IsActive = false;
+  TempDataIndex = -1;
+}
+
+bool TreeClipper::Step() {
+  assert(TempDataIndex >= 0 && "Called TreeClipper::Step() too many times, "
+                               "or before TreeClipper::Begin() ?");
+  if (!Clipper.Step()) {
+    End();
+    return false;
+  }
+  DisplayStart = Clipper.DisplayStart;
+  DisplayEnd = Min(Clipper.DisplayEnd, RowsCount);
+  return true;
+}
+
+int TreeClipper::GetRowNode(int row) const {
+  assert(TempDataIndex != -1 && row >= 0 && row < RowsCount);
+  return Ctx->TreeClippers.GetByIndex(TempDataIndex)->Rows[row].Node;
+}
+
+int TreeClipper::GetRowDepth(int row) const {
+  assert(TempDataIndex != -1 && row >= 0 && row < RowsCount);
+  return Ctx->TreeClippers.GetByIndex(TempDataIndex)->Rows[row].Depth;
+}
+
+// Rows are not pushed in the id stack nor in the tree depth: the open state
+// of a node is stored under an id made from its node index, and logging
+// doesn't automatically open nodes (which would expand the whole tree).
+bool TreeClipper::TreeNode(int row, const char *label, int flags) {
+  assert(TempDataIndex != -1 && row >= 0 && row < RowsCount);
+  Context &g = *Ctx;
+  Window *window = g.CurrentWindow;
+  if (window->SkipItems)
+    return false;
+
+  TreeClipperData *data = g.TreeClippers.GetByIndex(TempDataIndex);
+  const TreeClipperRow &row_data = data->Rows[row];
+  flags |= TreeNodeFlags_NoTreePushOnOpen | TreeNodeFlags_NoAutoOpenOnLog;
+  if (row_data.ChildrenCount == 0)
+    flags |= TreeNodeFlags_Leaf;
+  const float indent = row_data.Depth * g.Style.IndentSpacing;
+  if (indent > 0.0f)
+    Gui::Indent(indent);
+  const bool is_open = Gui::TreeNodeBehavior(
+      Gui::GetIDWithSeed(row_data.Node, data->ID), flags, label);
+  if (indent > 0.0f)
+    Gui::Unindent(indent);
+  TreeClipper_UpdateRowOpen(this, data, row, is_open);
+  return is_open;
+}
+
+void TreeClipper::SetRowOpen(int row, bool open) {
+  assert(TempDataIndex != -1 && row >= 0 && row < RowsCount);
+  TreeClipperData *data = Ctx->TreeClippers.GetByIndex(TempDataIndex);
+  if (data->Rows[row].ChildrenCount == 0)
+    return;
+  Gui::TreeNodeSetOpen(Gui::GetIDWithSeed(data->Rows[row].Node, data->ID),
+                       open);
+  TreeClipper_UpdateRowOpen(this, data, row, open);
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: Selectable
 //-------------------------------------------------------------------------
@@ -7973,6 +8632,23 @@ bool Gui::CollapsingHeader(const char *label, bool *p_visible, int flags) {
 bool Gui::Selectable(const char *label, bool selected, int flags,
                      const Vec2 &size_arg) {
   Window *window = GetCurrentWindow();
+  if (window->SkipItems)
+    return false;
+  return SelectableEx(label, window->GetID(label), selected, flags, size_arg);
+}
+
+bool Gui::Selectable(const StrID &label, bool selected, int flags,
+                     const Vec2 &size_arg) {
+  Window *window = GetCurrentWindow();
+  if (window->SkipItems)
+    return false;
+  return SelectableEx(label.Str, window->GetID(label), selected, flags,
+                      size_arg);
+}
+
+bool Gui::SelectableEx(const char *label, int id, bool selected, int flags,
+                       const Vec2 &size_arg) {
+  Window *window = GetCurrentWindow();
   if (window->SkipItems)
     return false;
 
@@ -7981,7 +8657,6 @@ bool Gui::Selectable(const char *label, bool selected, int flags,
 
   // Submit label or explicit size to ItemSize(), whereas ItemAdd() will submit
   // a larger/spanning rectangle.
-  int id = window->GetID(label);
   Vec2 label_size = CalcTextSize(label, NULL, true);
   Vec2 size(size_arg.x != 0.0f ? size_arg.x : label_size.x,
             size_arg.y != 0.0f ? size_arg.y : label_size.y);
@@ -8163,6 +8838,15 @@ bool Gui::Selectable(const char *label, bool *p_selected, int flags,
   return false;
 }
 
+bool Gui::Selectable(const StrID &label, bool *p_selected, int flags,
+                     const Vec2 &size_arg) {
+  if (Selectable(label, *p_selected, flags, size_arg)) {
+    *p_selected = !*p_selected;
+    return true;
+  }
+  return false;
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: Typing-Select support
 //-------------------------------------------------------------------------